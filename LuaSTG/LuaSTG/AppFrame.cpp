@@ -164,10 +164,16 @@ bool AppFrame::Init()noexcept
 
 	//////////////////////////////////////// 游戏对象池
 
-	// 为对象池分配空间
-	spdlog::info("[luastg] 初始化对象池，容量{}", LOBJPOOL_SIZE);
+	// 为对象池分配空间，对象的内存在使用时才按块分配
+	size_t game_object_capacity = core::ConfigurationLoader::getInstance().getGameObject().getCapacity();
+	if (game_object_capacity < 1 || game_object_capacity > GameObjectPool::max_capacity) {
+		auto const adjusted_capacity = std::clamp<size_t>(game_object_capacity, 1, GameObjectPool::max_capacity);
+		spdlog::warn("[luastg] 配置的对象池容量{}超出范围 [1, {}]，已调整为{}", game_object_capacity, GameObjectPool::max_capacity, adjusted_capacity);
+		game_object_capacity = adjusted_capacity;
+	}
+	spdlog::info("[luastg] 初始化对象池，容量{}", game_object_capacity);
 	try {
-		m_GameObjectPool = std::make_unique<GameObjectPool>();
+		m_GameObjectPool = std::make_unique<GameObjectPool>(game_object_capacity);
 	}
 	catch (const std::bad_alloc&) {
 		spdlog::error("[luastg] 无法为对象池分配内存");
@@ -398,6 +404,7 @@ void AppFrame::onBeforeUpdate() {
 	m_fFPS = 1.0 / m_frame_rate_controller->getStatistics()->getDuration(0);
 	m_fAvgFPS = 1.0 / m_frame_rate_controller->getStatistics()->getAverage(10);
 	m_frame_rate_controller->setFrameRate(m_target_fps);
+	m_frame_arena.beginFrame();
 	m_message_timer = core::ScopeTimer(&m_message_time);
 }
 bool AppFrame::onUpdate() {
@@ -517,6 +524,12 @@ bool AppFrame::onUpdateInternal()
 		m_ResourceMgr.UpdateSound();
 	}
 
+	if (result) {
+		tracy_zone_scoped_with_name("OnUpdate-Particle");
+		// 帧函数中推迟的粒子系统更新，在渲染前并行执行
+		m_ResourceMgr.UpdateParticle();
+	}
+
 	// check again after FrameFunc
 	if (ApplicationRestart::hasRestart()) {
 		core::ApplicationManager::requestExit();
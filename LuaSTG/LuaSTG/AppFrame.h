@@ -11,6 +11,7 @@
 #include "core/AudioEngine.hpp"
 #include "GameResource/ResourceManager.h"
 #include "GameObject/GameObjectPool.h"
+#include "Utility/FrameArena.hpp"
 #include "windows/DirectInput.hpp"
 #include "Debugger/FrameQuery.hpp"
 
@@ -91,6 +92,9 @@ namespace luastg {
 		// 资源管理器
 		ResourceMgr m_ResourceMgr;
 
+		// 帧内存分配器，需要在对象池之前构造、之后析构
+		FrameArena m_frame_arena;
+
 		// 对象池
 		std::unique_ptr<GameObjectPool> m_GameObjectPool;
 
@@ -287,6 +291,9 @@ namespace luastg {
 
 		GameObjectPool& GetGameObjectPool()noexcept { return *m_GameObjectPool; }
 
+		// 帧内存分配器，用于碰撞检测结果、渲染列表排序等只在一帧内使用的临时数据
+		FrameArena& GetFrameArena()noexcept { return m_frame_arena; }
+
 		Platform::DirectInput* GetDInput()noexcept { return m_DirectInput.get(); }
 
 		const FrameStatistics& getFrameStatistics() { return m_frame_statistics[m_frame_statistics_index]; }
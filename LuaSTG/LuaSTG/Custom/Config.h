@@ -21,6 +21,12 @@
 // add gravity (self.ag), speed limit (self.maxv, self.maxvx, self.maxvy)
 #define USER_SYSTEM_OPERATION
 
+// !!!experimental
+// store lstg.GameObject position, velocity, collider and transform properties as float instead of double
+// smaller objects, less memory bandwidth per frame, lower precision
+// compare "Move Time" and "Object Size" in the Frame Statistics window with and without this option
+//#define LUASTG_GAME_OBJECT_FLOAT32_LAYOUT
+
 // !!!deprecated
 // BAKACHU
 #define GLOBAL_SCALE_COLLI_SHAPE
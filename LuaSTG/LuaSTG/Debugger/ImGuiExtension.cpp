@@ -134,6 +134,14 @@ namespace imgui {
 						auto const size = (DWORDLONG)vm_kb * (DWORDLONG)1024 + (DWORDLONG)vm_b;
 						ImGui::Text("Lua Virtual Machine: %s", format_size(size));
 					}
+					if (ImGui::CollapsingHeader("Frame Arena", ImGuiTreeNodeFlags_DefaultOpen)) {
+						auto const& info = LAPP.GetFrameArena().getStatistics();
+						if (m_more_details) ImGui::Text("Capacity: %s", format_size(info.capacity));
+						ImGui::Text("Last Frame Usage: %s", format_size(info.used));
+						ImGui::Text("Last Frame Overflow: %s", format_size(info.overflow));
+						ImGui::Text("High Water Mark: %s", format_size(info.high_water_mark));
+						if (m_more_details) ImGui::Text("Overflow Frames: %llu", static_cast<unsigned long long>(info.overflow_frames));
+					}
 					if (ImGui::CollapsingHeader("Graphics", ImGuiTreeNodeFlags_DefaultOpen)) {
 						auto const info = LAPP.getGraphicsDevice()->getMemoryStatistics();
 						if (m_more_details) ImGui::Text("Local Budget: %s", format_size(info.local.budget));
@@ -631,6 +639,10 @@ namespace {
 				ImGui::Text("Allocate From Pool: %llu", current.object_alloc);
 				ImGui::Text("Return To Pool: %llu", current.object_free);
 				ImGui::Text("Active: %llu", current.object_alive);
+				ImGui::Text("Capacity: %llu", current.object_capacity);
+				ImGui::Text("Memory: %.2f MiB", static_cast<double>(current.object_memory) / (1024.0 * 1024.0));
+				ImGui::Text("Object Size: %u bytes", static_cast<unsigned int>(sizeof(luastg::GameObject)));
+				ImGui::Text("Move Time: %.3f ms", static_cast<double>(current.object_move_time) / 1000000.0);
 				ImGui::Text("Intersection Detect: %llu", current.object_colli_check);
 				ImGui::Text("Intersection Callback: %llu", current.object_colli_callback);
 			}
@@ -715,6 +727,110 @@ namespace {
 		bool m_initialized{};
 	};
 
+	class GameObjectCallbackProfilerWindow {
+	public:
+		void layout(bool& show) {
+			if (!show) {
+				return;
+			}
+			if (ImGui::Begin("GameObject Callback Profiler", &show)) {
+				auto& profiler = LPOOL.getCallbackProfiler();
+				bool enabled = profiler.isEnabled();
+				if (ImGui::Checkbox("Enable", &enabled)) {
+					profiler.setEnabled(enabled);
+				}
+				ImGui::SameLine();
+				if (ImGui::Button("Reset")) {
+					profiler.reset();
+				}
+
+				m_rows.clear();
+				for (auto const& [key, entry] : profiler.entries()) {
+					for (size_t kind = 0; kind < entry.records.size(); kind += 1) {
+						if (auto const& record = entry.records[kind]; record.count > 0) {
+							m_rows.push_back(Row{
+								.name = &entry.name,
+								.kind = static_cast<luastg::GameObjectCallbackKind>(kind),
+								.record = &record,
+							});
+						}
+					}
+				}
+
+				constexpr ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg
+					| ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV | ImGuiTableFlags_ScrollY;
+				if (ImGui::BeginTable("##GameObjectCallbackProfile", 6, flags)) {
+					ImGui::TableSetupScrollFreeze(0, 1);
+					ImGui::TableSetupColumn("Class", ImGuiTableColumnFlags_WidthStretch);
+					ImGui::TableSetupColumn("Callback", ImGuiTableColumnFlags_WidthFixed);
+					ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed);
+					ImGui::TableSetupColumn("Total (ms)", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+					ImGui::TableSetupColumn("Average (us)", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending);
+					ImGui::TableSetupColumn("Max (us)", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending);
+					ImGui::TableHeadersRow();
+
+					if (auto const specs = ImGui::TableGetSortSpecs(); specs != nullptr && specs->SpecsCount > 0) {
+						auto const& spec = specs->Specs[0];
+						auto const key = [column = spec.ColumnIndex](Row const& row) -> double {
+							switch (column) {
+							case 2: return static_cast<double>(row.record->count);
+							case 3: return static_cast<double>(row.record->total_time);
+							case 4: return row.average();
+							case 5: return static_cast<double>(row.record->max_time);
+							default: return 0.0;
+							}
+						};
+						auto const less = [&](Row const& a, Row const& b) {
+							switch (spec.ColumnIndex) {
+							case 0: return *a.name < *b.name;
+							case 1: return a.kind < b.kind;
+							default: return key(a) < key(b);
+							}
+						};
+						if (spec.SortDirection == ImGuiSortDirection_Descending) {
+							std::ranges::stable_sort(m_rows, [&](Row const& a, Row const& b) { return less(b, a); });
+						}
+						else {
+							std::ranges::stable_sort(m_rows, less);
+						}
+					}
+
+					for (auto const& row : m_rows) {
+						ImGui::TableNextRow();
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(row.name->c_str());
+						ImGui::TableNextColumn();
+						auto const kind_name = luastg::GameObjectCallbackProfiler::getKindName(row.kind);
+						ImGui::TextUnformatted(kind_name.data(), kind_name.data() + kind_name.size());
+						ImGui::TableNextColumn();
+						ImGui::Text("%llu", row.record->count);
+						ImGui::TableNextColumn();
+						ImGui::Text("%.3f", static_cast<double>(row.record->total_time) * 1e-6);
+						ImGui::TableNextColumn();
+						ImGui::Text("%.3f", row.average() * 1e-3);
+						ImGui::TableNextColumn();
+						ImGui::Text("%.3f", static_cast<double>(row.record->max_time) * 1e-3);
+					}
+					ImGui::EndTable();
+				}
+			}
+			ImGui::End();
+		}
+
+	private:
+		struct Row {
+			std::string const* name{};
+			luastg::GameObjectCallbackKind kind{};
+			luastg::GameObjectCallbackProfiler::Record const* record{};
+
+			[[nodiscard]] double average() const noexcept {
+				return static_cast<double>(record->total_time) / static_cast<double>(record->count);
+			}
+		};
+
+		std::vector<Row> m_rows;
+	};
+
 	int lib_ShowTestInputWindow(lua_State* L) {
 		if (lua_gettop(L) >= 1) {
 			bool v = lua_toboolean(L, 1);
@@ -834,6 +950,13 @@ namespace {
 		lua_pushboolean(L, v);
 		return 1;
 	}
+	int lib_ShowGameObjectCallbackProfiler(lua_State* L) {
+		static GameObjectCallbackProfilerWindow s_window;
+		bool v = (lua_gettop(L) >= 1) ? lua_toboolean(L, 1) : true;
+		s_window.layout(v);
+		lua_pushboolean(L, v);
+		return 1;
+	}
 	int lib_ShowResourceManagerDebugWindow(lua_State* L) {
 		if (lua_gettop(L) >= 1) {
 			bool v = lua_toboolean(L, 1);
@@ -869,6 +992,7 @@ namespace {
 			{"ShowTestInputWindow", &lib_ShowTestInputWindow},
 			{"ShowMemoryUsageWindow", &lib_ShowMemoryUsageWindow},
 			{"ShowFrameStatistics", &lib_ShowFrameStatistics},
+			{"ShowGameObjectCallbackProfiler", &lib_ShowGameObjectCallbackProfiler},
 			{"ShowResourceManagerDebugWindow", &lib_ShowResourceManagerDebugWindow},
 			{"ShowParticleSystemEditor", &lib_ShowParticleSystemEditor},
 			{NULL, NULL},
@@ -110,6 +110,8 @@ namespace luastg {
 		id = max_id;
 		unique_id = 0;
 		features.reset();
+		behavior = nullptr;
+		attachment = nullptr;
 
 		x = y = 0.0;
 		last_x = last_y = 0.0;
@@ -120,8 +122,8 @@ namespace luastg {
 		layer = 0.0;
 		hscale = vscale = 1.0;
 	#ifdef USER_SYSTEM_OPERATION
-		max_v = DBL_MAX * 0.5; // 平时应该不会有人弄那么大的速度吧，希望计算时不会溢出（
-		max_vx = max_vy = DBL_MAX;
+		max_v = std::numeric_limits<GameObjectScalar>::max() * GameObjectScalar{ 0.5 }; // 平时应该不会有人弄那么大的速度吧，希望计算时不会溢出（
+		max_vx = max_vy = std::numeric_limits<GameObjectScalar>::max();
 		ag = 0.0;
 	#endif
 
@@ -164,8 +166,8 @@ namespace luastg {
 		layer = 0.;
 		hscale = vscale = 1.;
 	#ifdef USER_SYSTEM_OPERATION
-		max_v = DBL_MAX * 0.5; // 平时应该不会有人弄那么大的速度吧，希望计算时不会溢出（
-		max_vx = max_vy = DBL_MAX;
+		max_v = std::numeric_limits<GameObjectScalar>::max() * GameObjectScalar{ 0.5 }; // 平时应该不会有人弄那么大的速度吧，希望计算时不会溢出（
+		max_vx = max_vy = std::numeric_limits<GameObjectScalar>::max();
 		ag = 0.;
 	#endif
 
@@ -176,6 +178,7 @@ namespace luastg {
 		timer = ani_timer = 0;
 
 		ReleaseResource();
+		clearBehavior();
 
 	#ifdef LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
 		resolve_move = false;
@@ -217,8 +220,8 @@ namespace luastg {
 			res = *tSprite;
 			res->retain();
 		#ifdef GLOBAL_SCALE_COLLI_SHAPE
-			a = tSprite->GetHalfSizeX() * LRES.GetGlobalImageScaleFactor();
-			b = tSprite->GetHalfSizeY() * LRES.GetGlobalImageScaleFactor();
+			a = static_cast<GameObjectScalar>(tSprite->GetHalfSizeX() * LRES.GetGlobalImageScaleFactor());
+			b = static_cast<GameObjectScalar>(tSprite->GetHalfSizeY() * LRES.GetGlobalImageScaleFactor());
 		#else
 			a = tSprite->GetHalfSizeX();
 			b = tSprite->GetHalfSizeY();
@@ -233,8 +236,8 @@ namespace luastg {
 			res = *tAnimation;
 			res->retain();
 		#ifdef GLOBAL_SCALE_COLLI_SHAPE
-			a = tAnimation->GetHalfSizeX() * LRES.GetGlobalImageScaleFactor();
-			b = tAnimation->GetHalfSizeY() * LRES.GetGlobalImageScaleFactor();
+			a = static_cast<GameObjectScalar>(tAnimation->GetHalfSizeX() * LRES.GetGlobalImageScaleFactor());
+			b = static_cast<GameObjectScalar>(tAnimation->GetHalfSizeY() * LRES.GetGlobalImageScaleFactor());
 		#else
 			a = tAnimation->GetHalfSizeX();
 			b = tAnimation->GetHalfSizeY();
@@ -260,8 +263,8 @@ namespace luastg {
 			res = *tParticle;
 			res->retain();
 		#ifdef GLOBAL_SCALE_COLLI_SHAPE
-			a = tParticle->GetHalfSizeX() * LRES.GetGlobalImageScaleFactor();
-			b = tParticle->GetHalfSizeY() * LRES.GetGlobalImageScaleFactor();
+			a = static_cast<GameObjectScalar>(tParticle->GetHalfSizeX() * LRES.GetGlobalImageScaleFactor());
+			b = static_cast<GameObjectScalar>(tParticle->GetHalfSizeY() * LRES.GetGlobalImageScaleFactor());
 		#else
 			a = tParticle->GetHalfSizeX();
 			b = tParticle->GetHalfSizeY();
@@ -319,8 +322,8 @@ namespace luastg {
 					lua_Number const speed_ = std::sqrt(vx * vx + vy * vy);
 					if (max_v < speed_ && speed_ > DBL_MIN) {
 						lua_Number const scale_ = max_v / speed_;
-						vx = scale_ * vx;
-						vy = scale_ * vy;
+						vx = static_cast<GameObjectScalar>(scale_ * vx);
+						vy = static_cast<GameObjectScalar>(scale_ * vy);
 					}
 				}
 				//针对x、y方向单独限制
@@ -406,8 +409,8 @@ namespace luastg {
 					lua_Number const speed_ = std::sqrt(vx * vx + vy * vy);
 					if (max_v < speed_ && speed_ > DBL_MIN) {
 						lua_Number const scale_ = max_v / speed_;
-						vx = scale_ * vx;
-						vy = scale_ * vy;
+						vx = static_cast<GameObjectScalar>(scale_ * vx);
+						vy = static_cast<GameObjectScalar>(scale_ * vy);
 					}
 				}
 				//针对x、y方向单独限制
@@ -32,11 +32,40 @@ namespace luastg {
 		void reset() { static_assert(sizeof(GameObjectFeatures) == sizeof(uint8_t)); *reinterpret_cast<uint8_t*>(this) = 0u; }
 	};
 
+	// 碰撞体类型
+	enum class GameObjectColliderType : uint8_t {
+		Circle = 0,
+		Ellipse = 1,
+		OBB = 2,
+	};
+
+	// 碰撞体数据，精确相交检测只依赖这些数据，可以脱离游戏对象进行检测
+	struct GameObjectCollider {
+		double x;
+		double y;
+		double col_r;
+		float a;
+		float b;
+		float rot;
+		GameObjectColliderType type;
+	};
+
+	// 游戏对象坐标、运动学、碰撞体、渲染变换等属性（字段注释中标记为 [S]）的存储类型
+	// 开启 LUASTG_GAME_OBJECT_FLOAT32_LAYOUT 后使用 float 存储，减小对象体积，以降低每帧遍历对象时的内存带宽
+#ifdef LUASTG_GAME_OBJECT_FLOAT32_LAYOUT
+	using GameObjectScalar = float;
+#else
+	using GameObjectScalar = double;
+#endif // LUASTG_GAME_OBJECT_FLOAT32_LAYOUT
+
 #pragma warning(push)
 #pragma warning(disable:26495)
 
 	// 游戏对象前向定义
 	struct GameObject;
+	struct GameObjectBehavior;
+	struct GameObjectAttachment;
+	class GameObjectBehaviorProgram;
 
 	// 游戏对象回调函数集和调用链
 	CORE_INTERFACE IGameObjectCallbacks {
@@ -56,106 +85,117 @@ namespace luastg {
 
 	// 游戏对象
 	struct GameObject {
-		static constexpr uint64_t max_id = 0xffffull;
-		static constexpr uint64_t max_unique_id = 0xffff'ffff'ffffull;
+		static constexpr uint64_t max_id = 0xf'ffffull;
+		static constexpr uint64_t max_unique_id = 0xfff'ffff'ffffull;
 
 		static constexpr int unhandled_set_group = 1;
 		static constexpr int unhandled_set_layer = 2;
 
-		// 回调函数
-
-		IGameObjectCallbacks** callbacks;	// [P] [不可见] 回调函数集和调用链
-		uint32_t callbacks_count;			// [4] [不可见]
-		uint32_t callbacks_capacity;		// [4] [不可见]
+		// 字段按访问频率排列：每帧的更新、出界检测、相交检测、渲染都会读写的字段放在前面，
+		// 使这些字段尽量落在前两个缓存行内，回调、链表维护等只在少数情况下访问的字段放在最后
 
-		// 链表部分
+		// 链表部分 - 更新链表
 
 		GameObject* update_list_previous;	// [P] [不可见] 更新链表上一个对象
 		GameObject* update_list_next;		// [P] [不可见] 更新链表下一个对象
-		GameObject* detect_list_previous;	// [P] [不可见] 相交检测链表上一个对象
-		GameObject* detect_list_next;		// [P] [不可见] 相交检测链表下一个对象
-
-		// 基本信息
-
-		uint64_t id : 16;				// [8:16] [不可见] 对象在对象池中的索引
-		uint64_t unique_id : 48;		// [8:48] [不可见] 对象全局唯一标识符
 
-		// 分组
+		// 小型属性
+		// 小型属性 - 渲染
+		core::Color4B vertex_color;		// [4] 顶点颜色
+		BlendMode blend_mode;			// [1] 混合模式
+		// 小型属性 - 基本信息
+		GameObjectFeatures features;	// [1] [不可见] 对象类的一些特性
+		GameObjectStatus status;		// [1] 对象状态
 
-	#ifdef USING_MULTI_GAME_WORLD
-		int64_t world;					// [8] 世界标记位，用于对一个对象进行分组，影响更新、渲染、碰撞检测等
-	#endif // USING_MULTI_GAME_WORLD
+		// 布尔属性
+		// 布尔属性 - 常用，占用完整的字节，以便通过 FFI 直接读写
+		uint8_t bound;					// [1] 是否离开边界自动回收
+		uint8_t colli;					// [1] 是否参与碰撞
+		uint8_t hide;					// [1] 不渲染
+		uint8_t navi;					// [1] 根据坐标增量自动设置渲染旋转角
+		// 布尔属性 - 碰撞体
+		uint8_t rect : 1;				// [b] 是否为矩形碰撞盒
+		// 布尔属性 - 更新控制
+	#ifdef LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
+		uint8_t resolve_move : 1;		// [b] 是否为计算速度而非计算位置
+	#endif // LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
+		uint8_t ignore_super_pause : 1;	// [b] 是否无视超级暂停。 超级暂停时，timer不会增加，frame不会调用，但render会调用。
+		uint8_t last_xy_touched : 1;	// [b] 是否已经更新过 last_x 和 last_y 值，如果未更新过，表明对象刚生成，获取 dx 和 dy 时应当返回 0
 
 		// 位置
 
-		double last_x;					// [8] [不可见] 对象上一帧坐标 x
-		double last_y;					// [8] [不可见] 对象上一帧坐标 y
-		double x;						// [8] 对象坐标 x
-		double y;						// [8] 对象坐标 y
-		double dx;						// [8] [只读] 对象坐标增量 x
-		double dy;						// [8] [只读] 对象坐标增量 y
+		GameObjectScalar x;				// [S] 对象坐标 x
+		GameObjectScalar y;				// [S] 对象坐标 y
+		GameObjectScalar last_x;		// [S] [不可见] 对象上一帧坐标 x
+		GameObjectScalar last_y;		// [S] [不可见] 对象上一帧坐标 y
+		GameObjectScalar dx;				// [S] [只读] 对象坐标增量 x
+		GameObjectScalar dy;				// [S] [只读] 对象坐标增量 y
 
 		// 运动学
 
-		double vx;						// [8] 对象速度 x 分量
-		double vy;						// [8] 对象速度 y 分量
-		double ax;						// [8] 对象加速度 x 分量
-		double ay;						// [8] 对象加速度 x 分量
+		GameObjectScalar vx;				// [S] 对象速度 x 分量
+		GameObjectScalar vy;				// [S] 对象速度 y 分量
+		GameObjectScalar ax;				// [S] 对象加速度 x 分量
+		GameObjectScalar ay;				// [S] 对象加速度 x 分量
 	#ifdef USER_SYSTEM_OPERATION
-		double max_vx;					// [8] 对象速度 x 分量最大值
-		double max_vy;					// [8] 对象速度 y 分量最大值
-		double max_v;					// [8] 对象速度最大值
-		double ag;						// [8] 重力加速度
+		GameObjectScalar max_vx;			// [S] 对象速度 x 分量最大值
+		GameObjectScalar max_vy;			// [S] 对象速度 y 分量最大值
+		GameObjectScalar max_v;			// [S] 对象速度最大值
+		GameObjectScalar ag;				// [S] 重力加速度
 	#endif
 		//lua_Number va, speed; // 速度方向 速度值
 
 		// 碰撞体
 
-		int64_t group;					// [8] 对象所在的碰撞组
-		double a;						// [8] 矩形模式下，为横向宽度一半；非矩形模式下，为圆半径或椭圆横向宽度一半
-		double b;						// [8] 矩形模式下，为纵向宽度一半；非矩形模式下，为圆半径或椭圆纵向宽度一半
-		double col_r;					// [8] [不可见] 碰撞体外接圆半径
+		GameObjectScalar a;				// [S] 矩形模式下，为横向宽度一半；非矩形模式下，为圆半径或椭圆横向宽度一半
+		GameObjectScalar b;				// [S] 矩形模式下，为纵向宽度一半；非矩形模式下，为圆半径或椭圆纵向宽度一半
+		GameObjectScalar col_r;			// [S] [不可见] 碰撞体外接圆半径
 
 		// 渲染
 
-		double layer;					// [8] 图层
-		double hscale;					// [8] 横向渲染缩放
-		double vscale;					// [8] 纵向渲染缩放
-		double rot;						// [8] 平面渲染旋转角
-		double omega;					// [8] 平面渲染旋转角加速度
-		int64_t ani_timer;				// [P] [只读] 动画自增计数器
-		IResourceBase* res;				// [P] 渲染资源
-		IParticlePool* ps;				// [P] 粒子系统
+		GameObjectScalar rot;			// [S] 平面渲染旋转角
+		GameObjectScalar omega;			// [S] 平面渲染旋转角加速度
+		GameObjectScalar hscale;			// [S] 横向渲染缩放
+		GameObjectScalar vscale;			// [S] 纵向渲染缩放
+		GameObjectScalar layer;			// [S] 图层
+
+		// 分组
+
+		int64_t group;					// [8] 对象所在的碰撞组
+	#ifdef USING_MULTI_GAME_WORLD
+		int64_t world;					// [8] 世界标记位，用于对一个对象进行分组，影响更新、渲染、碰撞检测等
+	#endif // USING_MULTI_GAME_WORLD
 
 		// 更新控制
 
 		int64_t timer;					// [P] 自增计数器
+		int64_t ani_timer;				// [P] [只读] 动画自增计数器
 	#ifdef LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
 		int64_t pause;					// [P] 对象被暂停的时间(帧) 对象被暂停时，将跳过速度计算，但是timer会增加，frame仍会调用
 	#endif // LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
 
-		// 小型属性
-		// 小型属性 - 渲染
-		core::Color4B vertex_color;		// [4] 顶点颜色
-		BlendMode blend_mode;			// [1] 混合模式
-		// 小型属性 - 基本信息
-		GameObjectFeatures features;	// [1] [不可见] 对象类的一些特性
-		GameObjectStatus status;		// [1] 对象状态
+		// 渲染资源
 
-		// 布尔属性
-		// 布尔属性 - 碰撞体
-		uint8_t bound : 1;				// [1] 是否离开边界自动回收
-		uint8_t colli : 1;				// [1] 是否参与碰撞
-		uint8_t rect : 1;				// [1] 是否为矩形碰撞盒
-		// 布尔属性 - 渲染
-		uint8_t hide : 1;				// [b] 不渲染
-		uint8_t navi : 1;				// [b] 根据坐标增量自动设置渲染旋转角
-		// 布尔属性 - 更新控制
-	#ifdef LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
-		uint8_t resolve_move : 1;		// [b] 是否为计算速度而非计算位置
-	#endif // LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
-		uint8_t ignore_super_pause : 1;	// [b] 是否无视超级暂停。 超级暂停时，timer不会增加，frame不会调用，但render会调用。
-		uint8_t last_xy_touched : 1;	// [b] 是否已经更新过 last_x 和 last_y 值，如果未更新过，表明对象刚生成，获取 dx 和 dy 时应当返回 0
+		IResourceBase* res;				// [P] 渲染资源
+		IParticlePool* ps;				// [P] 粒子系统
+
+		// 链表部分 - 相交检测链表
+
+		GameObject* detect_list_previous;	// [P] [不可见] 相交检测链表上一个对象
+		GameObject* detect_list_next;		// [P] [不可见] 相交检测链表下一个对象
+
+		// 基本信息
+
+		uint64_t id : 20;				// [8:20] [不可见] 对象在对象池中的索引
+		uint64_t unique_id : 44;		// [8:44] [不可见] 对象全局唯一标识符
+
+		// 回调函数
+
+		IGameObjectCallbacks** callbacks;	// [P] [不可见] 回调函数集和调用链
+		uint32_t callbacks_count;			// [4] [不可见]
+		uint32_t callbacks_capacity;		// [4] [不可见]
+		GameObjectBehavior* behavior;		// [P] [不可见] 原生行为程序的执行状态
+		GameObjectAttachment* attachment;	// [P] [不可见] 附着在父对象上时的状态，由对象池管理
 
 		// 成员方法
 
@@ -173,6 +213,14 @@ namespace luastg {
 		void UpdateV2();
 		void UpdateLastV2();
 
+		// 原生行为程序，实现位于 GameObjectBehavior.cpp
+
+		void setBehavior(GameObjectBehaviorProgram* program, bool exclusive);
+		void clearBehavior();
+		void setBehaviorTarget(GameObject const* target) noexcept;
+		void restoreBehavior(GameObjectBehavior const& state); // 恢复快照中记录的执行状态
+		void UpdateBehavior();
+
 		static std::pmr::unsynchronized_pool_resource s_callbacks_resource;
 
 		[[nodiscard]] bool containsCallbacks(IGameObjectCallbacks const* c) const noexcept;
@@ -203,21 +251,21 @@ namespace luastg {
 		void setSpeed(double const speed) noexcept {
 			if (auto const current = calculateSpeed(); current > std::numeric_limits<double>::min()) {
 				auto const a3 = speed / current;
-				vx *= a3;
-				vy *= a3;
+				vx = static_cast<GameObjectScalar>(vx * a3);
+				vy = static_cast<GameObjectScalar>(vy * a3);
 			}
 			else {
-				vx = std::cos(rot) * speed;
-				vy = std::sin(rot) * speed;
+				vx = static_cast<GameObjectScalar>(std::cos(rot) * speed);
+				vy = static_cast<GameObjectScalar>(std::sin(rot) * speed);
 			}
 		}
 		void setSpeedDirection(double const direction) noexcept {
 			if (auto const speed = calculateSpeed(); speed > std::numeric_limits<double>::min()) {
-				vx = speed * std::cos(direction);
-				vy = speed * std::sin(direction);
+				vx = static_cast<GameObjectScalar>(speed * std::cos(direction));
+				vy = static_cast<GameObjectScalar>(speed * std::sin(direction));
 			}
 			else {
-				rot = direction;
+				rot = static_cast<GameObjectScalar>(direction);
 			}
 		}
 		void setGroup(int64_t new_group);
@@ -235,8 +283,19 @@ namespace luastg {
 		[[nodiscard]] int32_t getParticleEmission() const;
 		void setParticleEmission(int32_t value) const;
 
+		[[nodiscard]] GameObjectCollider getCollider() const noexcept;
+
 		[[nodiscard]] static bool isIntersect(GameObject const* p1, GameObject const* p2) noexcept;
+		[[nodiscard]] static bool isIntersect(GameObjectCollider const& c1, GameObjectCollider const& c2) noexcept;
 	};
 
 #pragma warning(pop)
+
+	// 修改字段时需要确认对象体积，以及每帧都会访问的字段仍然在前面的缓存行内
+#ifdef LUASTG_GAME_OBJECT_FLOAT32_LAYOUT
+	static_assert(sizeof(GameObject) <= 4 * 64);
+	static_assert(offsetof(GameObject, layer) + sizeof(GameObject::layer) <= 2 * 64);
+#else
+	static_assert(sizeof(GameObject) <= 5 * 64);
+#endif // LUASTG_GAME_OBJECT_FLOAT32_LAYOUT
 }
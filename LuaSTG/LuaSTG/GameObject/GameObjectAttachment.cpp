@@ -0,0 +1,155 @@
+#include "GameObject/GameObjectPool.h"
+
+namespace {
+	using std::string_view_literals::operator ""sv;
+
+	constexpr auto queue_to_destroy_reason_parent_destroyed{ "luastg:parent_destroyed"sv };
+
+	std::pmr::unsynchronized_pool_resource s_attachment_resource;
+
+	// 父对象的槽位可能已经被回收或者重新分配给了别的对象
+	bool isParentAlive(luastg::GameObjectAttachment const* const attachment) noexcept {
+		return attachment->parent->status != luastg::GameObjectStatus::Free
+			&& attachment->parent->unique_id == attachment->parent_unique_id;
+	}
+
+	bool isParentActive(luastg::GameObjectAttachment const* const attachment) noexcept {
+		return attachment->parent->status == luastg::GameObjectStatus::Active
+			&& attachment->parent->unique_id == attachment->parent_unique_id;
+	}
+}
+
+namespace luastg {
+	bool GameObjectPool::attachObject(GameObject* const child, GameObject* const parent, GameObjectAttachmentTransform const& transform, bool const detach_on_parent_free) {
+		assert(child != nullptr && parent != nullptr);
+		if (parent->status != GameObjectStatus::Active) {
+			return false;
+		}
+		// 不允许形成环
+		for (auto object = parent; object != nullptr; object = (object->attachment != nullptr && isParentAlive(object->attachment)) ? object->attachment->parent : nullptr) {
+			if (object == child) {
+				return false;
+			}
+		}
+		if (child->attachment == nullptr) {
+			child->attachment = createAttachment({});
+			child->attachment->index = static_cast<uint32_t>(m_attached_objects.size());
+			m_attached_objects.push_back(child);
+		}
+		auto const attachment = child->attachment;
+		attachment->parent = parent;
+		attachment->parent_unique_id = parent->unique_id;
+		attachment->transform = transform;
+		attachment->detach_on_parent_free = detach_on_parent_free;
+		m_attached_objects_unordered = true;
+		return true;
+	}
+
+	void GameObjectPool::detachObject(GameObject* const child) noexcept {
+		auto const attachment = child->attachment;
+		if (attachment == nullptr) {
+			return;
+		}
+		assert(m_attached_objects[attachment->index] == child);
+		auto const last = m_attached_objects.back();
+		m_attached_objects[attachment->index] = last;
+		last->attachment->index = attachment->index;
+		m_attached_objects.pop_back();
+		m_attached_objects_unordered = true;
+		destroyAttachment(attachment);
+		child->attachment = nullptr;
+	}
+
+	GameObjectAttachment* GameObjectPool::createAttachment(GameObjectAttachment const& state) {
+		std::pmr::polymorphic_allocator<GameObjectAttachment> allocator(&s_attachment_resource);
+		return allocator.new_object<GameObjectAttachment>(state);
+	}
+
+	void GameObjectPool::destroyAttachment(GameObjectAttachment* const attachment) noexcept {
+		std::pmr::polymorphic_allocator<GameObjectAttachment> allocator(&s_attachment_resource);
+		allocator.delete_object(attachment);
+	}
+
+	GameObject* GameObjectPool::getAttachmentParent(GameObject const* const child) const noexcept {
+		if (child->attachment == nullptr || !isParentAlive(child->attachment)) {
+			return nullptr;
+		}
+		return child->attachment->parent;
+	}
+
+	void GameObjectPool::sortAttachedObjects() {
+		for (auto const child : m_attached_objects) {
+			uint32_t depth = 0;
+			for (auto object = child; object->attachment != nullptr && isParentAlive(object->attachment); object = object->attachment->parent) {
+				depth += 1;
+			}
+			child->attachment->depth = depth;
+		}
+		// 层数相同时保持原有顺序
+		std::stable_sort(m_attached_objects.begin(), m_attached_objects.end(), [](GameObject const* const l, GameObject const* const r) {
+			return l->attachment->depth < r->attachment->depth;
+		});
+		for (size_t i = 0; i < m_attached_objects.size(); i += 1) {
+			m_attached_objects[i]->attachment->index = static_cast<uint32_t>(i);
+		}
+		m_attached_objects_unordered = false;
+	}
+
+	void GameObjectPool::destroyOrphanedAttachments() {
+		if (m_attached_objects.empty()) {
+			return;
+		}
+		tracy_zone_scoped_with_name("LOBJMGR.Attachment.Orphan");
+		// 子对象被删除后，它的子对象会在下一轮处理，直到没有父对象被删除的子对象
+		while (true) {
+			m_orphaned_objects.clear();
+			for (auto const child : m_attached_objects) {
+				if (!isParentActive(child->attachment)) {
+					m_orphaned_objects.push_back(child);
+				}
+			}
+			if (m_orphaned_objects.empty()) {
+				break;
+			}
+			for (auto const child : m_orphaned_objects) {
+				// del 回调中可能修改了其他对象的附着状态
+				if (child->attachment == nullptr || isParentActive(child->attachment)) {
+					continue;
+				}
+				auto const detach_only = child->attachment->detach_on_parent_free;
+				detachObject(child);
+				if (!detach_only) {
+					queueToFreeWithCallbacks(child, queue_to_destroy_reason_parent_destroyed);
+				}
+			}
+		}
+	}
+
+	void GameObjectPool::resolveAttachments() noexcept {
+		if (m_attached_objects.empty()) {
+			return;
+		}
+		tracy_zone_scoped_with_name("LOBJMGR.Attachment.Resolve");
+		if (m_attached_objects_unordered) {
+			sortAttachedObjects();
+		}
+		// 父对象总是先于子对象计算，多层附着在同一帧内完成
+		for (auto const child : m_attached_objects) {
+			auto const attachment = child->attachment;
+			if (!isParentAlive(attachment)) {
+				continue; // 父对象已经被回收，在下一次更新时删除或解除附着
+			}
+			auto const parent = attachment->parent;
+			auto const& transform = attachment->transform;
+			auto const c = std::cos(parent->rot);
+			auto const s = std::sin(parent->rot);
+			auto const ox = transform.x * parent->hscale;
+			auto const oy = transform.y * parent->vscale;
+			child->x = static_cast<GameObjectScalar>(parent->x + ox * c - oy * s);
+			child->y = static_cast<GameObjectScalar>(parent->y + ox * s + oy * c);
+			child->rot = static_cast<GameObjectScalar>(parent->rot + transform.rot);
+			child->hscale = static_cast<GameObjectScalar>(parent->hscale * transform.hscale);
+			child->vscale = static_cast<GameObjectScalar>(parent->vscale * transform.vscale);
+		}
+	}
+}
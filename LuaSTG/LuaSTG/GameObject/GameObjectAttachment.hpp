@@ -0,0 +1,24 @@
+#pragma once
+#include "GameObject/GameObject.hpp"
+
+namespace luastg {
+	// 子对象相对父对象的变换，角度为弧度
+	struct GameObjectAttachmentTransform {
+		double x{};
+		double y{};
+		double rot{};
+		double hscale{ 1.0 };
+		double vscale{ 1.0 };
+	};
+
+	// 子对象的附着状态，由对象池统一管理
+	// 附着期间子对象的坐标、旋转和缩放每帧在运动更新后由父对象计算得到，子对象自身的速度不再影响坐标
+	struct GameObjectAttachment {
+		GameObject* parent{};
+		uint64_t parent_unique_id{};
+		GameObjectAttachmentTransform transform;
+		uint32_t index{};					// 在对象池附着列表中的位置
+		uint32_t depth{};					// 到根对象的层数，用于按拓扑顺序计算变换
+		bool detach_on_parent_free{};		// 父对象被删除时只解除附着，否则一起删除
+	};
+}
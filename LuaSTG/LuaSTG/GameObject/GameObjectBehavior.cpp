@@ -0,0 +1,158 @@
+#include "GameObject/GameObjectBehavior.hpp"
+#include "AppFrame.h"
+#include <numbers>
+
+namespace {
+	using std::string_view_literals::operator ""sv;
+
+	constexpr auto queue_to_destroy_reason_behavior{ "luastg:behavior"sv };
+
+	std::pmr::unsynchronized_pool_resource s_behavior_resource;
+
+	bool isTargetValid(luastg::GameObjectBehavior const* const behavior) noexcept {
+		return behavior->target != nullptr
+			&& behavior->target->status == luastg::GameObjectStatus::Active
+			&& behavior->target->unique_id == behavior->target_unique_id;
+	}
+
+	void rotateVelocity(luastg::GameObject* const self, double const c, double const s) noexcept {
+		auto const vx = self->vx * c - self->vy * s;
+		auto const vy = self->vx * s + self->vy * c;
+		self->vx = static_cast<luastg::GameObjectScalar>(vx);
+		self->vy = static_cast<luastg::GameObjectScalar>(vy);
+	}
+
+	// 执行一帧持续性指令，指令结束时返回 true
+	bool advanceFrame(luastg::GameObjectBehavior* const behavior, uint32_t const frames) noexcept {
+		behavior->frame += 1;
+		return frames != 0 && behavior->frame >= frames;
+	}
+
+	void nextInstruction(luastg::GameObjectBehavior* const behavior) noexcept {
+		behavior->pc += 1;
+		behavior->frame = 0;
+	}
+}
+
+namespace luastg {
+	void GameObject::setBehavior(GameObjectBehaviorProgram* const program, bool const exclusive) {
+		clearBehavior();
+		if (program == nullptr) {
+			return;
+		}
+		program->retain();
+		std::pmr::polymorphic_allocator<GameObjectBehavior> allocator(&s_behavior_resource);
+		behavior = allocator.new_object<GameObjectBehavior>();
+		behavior->program = program;
+		behavior->exclusive = exclusive;
+	}
+	void GameObject::clearBehavior() {
+		if (behavior == nullptr) {
+			return;
+		}
+		behavior->program->release();
+		std::pmr::polymorphic_allocator<GameObjectBehavior> allocator(&s_behavior_resource);
+		allocator.delete_object(behavior);
+		behavior = nullptr;
+	}
+	void GameObject::setBehaviorTarget(GameObject const* const target) noexcept {
+		if (behavior == nullptr) {
+			return;
+		}
+		behavior->target = const_cast<GameObject*>(target);
+		behavior->target_unique_id = target != nullptr ? target->unique_id : 0;
+	}
+	void GameObject::restoreBehavior(GameObjectBehavior const& state) {
+		assert(behavior == nullptr && state.program != nullptr);
+		state.program->retain();
+		std::pmr::polymorphic_allocator<GameObjectBehavior> allocator(&s_behavior_resource);
+		behavior = allocator.new_object<GameObjectBehavior>(state);
+	}
+	void GameObject::UpdateBehavior() {
+		assert(behavior != nullptr);
+		auto const& instructions = behavior->program->instructions();
+		while (behavior->pc < instructions.size()) {
+			auto const& instruction = instructions[behavior->pc];
+			switch (instruction.op) {
+			case GameObjectBehaviorOp::Wait:
+				if (instruction.frames == 0) {
+					break;
+				}
+				if (advanceFrame(behavior, instruction.frames)) {
+					nextInstruction(behavior);
+				}
+				return;
+			case GameObjectBehaviorOp::SetSpeed:
+				setSpeed(instruction.value0);
+				break;
+			case GameObjectBehaviorOp::SetAngle:
+				setSpeedDirection(instruction.value0);
+				break;
+			case GameObjectBehaviorOp::SetVelocity:
+				vx = static_cast<GameObjectScalar>(instruction.value0 * std::cos(instruction.value1));
+				vy = static_cast<GameObjectScalar>(instruction.value0 * std::sin(instruction.value1));
+				break;
+			case GameObjectBehaviorOp::Accelerate: {
+				auto const current = calculateSpeed();
+				auto const speed = current < instruction.value0
+					? std::min(current + instruction.value1, instruction.value0)
+					: std::max(current - instruction.value1, instruction.value0);
+				setSpeed(speed);
+				if (speed == instruction.value0) {
+					nextInstruction(behavior);
+				}
+				return;
+			}
+			case GameObjectBehaviorOp::Turn:
+				rotateVelocity(this, instruction.value0, instruction.value1);
+				if (advanceFrame(behavior, instruction.frames)) {
+					nextInstruction(behavior);
+				}
+				return;
+			case GameObjectBehaviorOp::Aim:
+				if (isTargetValid(behavior)) {
+					setSpeedDirection(std::atan2(behavior->target->y - y, behavior->target->x - x) + instruction.value0);
+				}
+				break;
+			case GameObjectBehaviorOp::Homing:
+				if (isTargetValid(behavior) && calculateSpeed() > std::numeric_limits<double>::min()) {
+					auto const current = std::atan2(vy, vx);
+					auto const expected = std::atan2(behavior->target->y - y, behavior->target->x - x);
+					auto delta = std::remainder(expected - current, 2.0 * std::numbers::pi);
+					delta = std::clamp(delta, -instruction.value0, instruction.value0);
+					rotateVelocity(this, std::cos(delta), std::sin(delta));
+				}
+				if (advanceFrame(behavior, instruction.frames)) {
+					nextInstruction(behavior);
+				}
+				return;
+			case GameObjectBehaviorOp::Fade: {
+				if (instruction.frames == 0) {
+					vertex_color.a = static_cast<uint8_t>(instruction.value0);
+					break;
+				}
+				if (behavior->frame == 0) {
+					behavior->fade_from = vertex_color.a;
+				}
+				behavior->frame += 1;
+				auto const t = static_cast<double>(behavior->frame) / static_cast<double>(instruction.frames);
+				auto const alpha = behavior->fade_from + (instruction.value0 - behavior->fade_from) * t;
+				vertex_color.a = static_cast<uint8_t>(std::clamp(std::round(alpha), 0.0, 255.0));
+				if (behavior->frame >= instruction.frames) {
+					nextInstruction(behavior);
+				}
+				return;
+			}
+			case GameObjectBehaviorOp::Delete:
+				// 删除时可能会调用 lua 回调，先移除行为程序，避免回调中修改行为程序
+				clearBehavior();
+				LPOOL.queueToFreeWithCallbacks(this, queue_to_destroy_reason_behavior);
+				return;
+			}
+			// 瞬时指令不占用帧，继续执行下一条指令
+			nextInstruction(behavior);
+		}
+		// 程序执行完毕
+		clearBehavior();
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "GameObject/GameObject.hpp"
+#include <vector>
+
+namespace luastg {
+	// 原生行为指令，角度均为弧度
+	enum class GameObjectBehaviorOp : uint8_t {
+		Wait,			// 等待 frames 帧
+		SetSpeed,		// 设置速度大小为 value0，方向不变
+		SetAngle,		// 设置速度方向为 value0，大小不变
+		SetVelocity,	// 设置速度大小为 value0，方向为 value1
+		Accelerate,		// 每帧速度大小向 value0 变化 value1，达到 value0 后结束
+		Turn,			// 每帧旋转速度方向，value0、value1 为旋转角的余弦和正弦，持续 frames 帧，0 表示一直持续
+		Aim,			// 速度方向指向目标对象，再加上 value0 的偏移
+		Homing,			// 每帧向目标对象转向，最多旋转 value0，持续 frames 帧，0 表示一直持续
+		Fade,			// 在 frames 帧内把顶点颜色的 alpha 线性变化到 value0
+		Delete,			// 删除对象，会调用对象的 del 回调，原因参数为 "luastg:behavior"
+	};
+
+	struct GameObjectBehaviorInstruction {
+		double value0{};
+		double value1{};
+		uint32_t frames{};
+		GameObjectBehaviorOp op{};
+	};
+
+	// 行为程序：创建后不再修改，可以被多个对象共享，通过引用计数管理生命周期
+	class GameObjectBehaviorProgram {
+	public:
+		explicit GameObjectBehaviorProgram(std::vector<GameObjectBehaviorInstruction> instructions) : m_instructions(std::move(instructions)) {}
+		GameObjectBehaviorProgram(GameObjectBehaviorProgram const&) = delete;
+		GameObjectBehaviorProgram& operator=(GameObjectBehaviorProgram const&) = delete;
+
+		void retain() noexcept { m_references += 1; }
+		void release() noexcept {
+			m_references -= 1;
+			if (m_references == 0) {
+				delete this;
+			}
+		}
+
+		[[nodiscard]] std::vector<GameObjectBehaviorInstruction> const& instructions() const noexcept { return m_instructions; }
+
+	private:
+		~GameObjectBehaviorProgram() = default;
+
+		std::vector<GameObjectBehaviorInstruction> m_instructions;
+		uint32_t m_references{ 1 };
+	};
+
+	// 游戏对象的行为程序执行状态
+	// 每帧在调用 frame 回调的位置执行，独占模式下执行期间不会调用对象的 frame 回调，程序结束或被移除后恢复
+	struct GameObjectBehavior {
+		GameObjectBehaviorProgram* program{};
+		GameObject* target{};
+		uint64_t target_unique_id{};
+		uint32_t pc{};					// 当前指令
+		uint32_t frame{};				// 当前指令已经执行的帧数
+		double fade_from{};				// Fade 指令开始时的 alpha
+		bool exclusive{};				// 独占模式，执行期间跳过 frame 回调，不修改对象的 features
+	};
+}
@@ -196,6 +196,9 @@ void GameObjectBentLaser::_UpdateNodeVertexExtend(size_t i) noexcept
 
 void GameObjectBentLaser::_UpdateAllNode() noexcept
 {
+	// 所有节点都可能被修改过
+	_MarkAllNodeDirty();
+
 	// 无论如何都重置长度
 	m_fLength = 0.0f;
 
@@ -249,10 +252,25 @@ void GameObjectBentLaser::_UpdateAllNode() noexcept
 	}
 }
 
+void GameObjectBentLaser::_UpdateLength() noexcept
+{
+	m_fLength = 0.0f;
+	for (size_t i = 1; i < m_Queue.size(); i += 1)
+	{
+		LaserNode const& last = m_Queue[i - 1];
+		LaserNode const& next = m_Queue[i];
+		if (last.active && next.active)
+		{
+			m_fLength += next.dis;
+		}
+	}
+}
+
 void GameObjectBentLaser::_PopHead() noexcept
 {
 	if (m_Queue.size() > 1)
 	{
+		_MarkNodeDirty(0);
 		LaserNode const& last = m_Queue.popHead(); // 最老的节点
 		if (m_Queue.size() > 1)
 		{
@@ -301,6 +319,7 @@ void GameObjectBentLaser::SetEnvelope(float height, float base, float rate, floa
 	m_fEnvelopeBase = std::clamp(base, 0.0f, 1.0f);
 	m_fEnvelopeRate = rate;
 	m_fEnvelopePower = 0.4f * std::floorf(power / 0.4f); // 不要问，问就是魔法数字
+	m_EnvelopeCacheSize = 0;
 }
 
 bool GameObjectBentLaser::Update(size_t id, int length, float width, bool active) noexcept
@@ -349,6 +368,7 @@ bool GameObjectBentLaser::Update(float x, float y, float rot, int length, float
 			LaserNode& last = m_Queue[m_Queue.size() - 1];
 			// 修改坐标
 			last.pos = node.pos;
+			_MarkNodeDirty(m_Queue.size() - 1);
 			//last.half_width = node.half_width; // 保留宽度
 			// 修改到上一个节点的距离和重新计算总长度
 			m_fLength -= last.dis;
@@ -367,6 +387,7 @@ bool GameObjectBentLaser::Update(float x, float y, float rot, int length, float
 			// 修改坐标和宽度
 			last.pos = node.pos;
 			last.half_width = node.half_width;
+			_MarkNodeDirty(m_Queue.size() - 1);
 			// 到上一个节点的距离和总长度直接归 0
 			last.dis = 0.0f;
 			m_fLength = 0.0f;
@@ -402,6 +423,7 @@ bool GameObjectBentLaser::Update(float x, float y, float rot, int length, float
 			//node.rot = vec_.CalcuAngle();
 			// 插入并更新节点
 			m_Queue.pushTail(node);
+			_MarkNodeDirty(m_Queue.size() - 1);
 			_UpdateNodeVertexExtend(m_Queue.size() - 1);
 			_UpdateNodeVertexExtend(m_Queue.size() - 2);
 		}
@@ -422,6 +444,7 @@ bool GameObjectBentLaser::Update(float x, float y, float rot, int length, float
 			//}
 			// 插入但不更新节点，等节点数量超过 1 再更新
 			m_Queue.pushTail(node);
+			_MarkNodeDirty(m_Queue.size() - 1);
 		}
 		return true;
 	}
@@ -433,6 +456,27 @@ void GameObjectBentLaser::SetAllWidth(float width)  noexcept
 	{
 		m_Queue[i].half_width = width / 2.0f;
 	}
+	_MarkAllNodeDirty();
+}
+
+IResourceTexture* GameObjectBentLaser::_FindTexture(const char* tex_name) noexcept
+{
+	auto& resource_manager = LRES;
+	if (m_pTexture && m_TextureGeneration == resource_manager.GetTextureGeneration() && m_TextureName == tex_name)
+	{
+		return m_pTexture.get();
+	}
+	m_pTexture = resource_manager.FindTexture(tex_name);
+	m_TextureGeneration = resource_manager.GetTextureGeneration();
+	try
+	{
+		m_TextureName = tex_name;
+	}
+	catch (...)
+	{
+		m_pTexture = nullptr; // 下一次重新查找
+	}
+	return m_pTexture.get();
 }
 
 bool GameObjectBentLaser::Render(const char* tex_name, BlendMode blend, core::Color4B c, float tex_left, float tex_top, float tex_width, float tex_height, float scale) noexcept
@@ -445,13 +489,45 @@ bool GameObjectBentLaser::Render(const char* tex_name, BlendMode blend, core::Co
 		return true;
 
 	// 首先拿到纹理
-	core::SmartReference<IResourceTexture> pTex = LRES.FindTexture(tex_name);
+	IResourceTexture* const pTex = _FindTexture(tex_name);
 	if (!pTex)
 	{
 		spdlog::error("[luastg] [GameObjectBentLaser::Render] 找不到纹理'{}'", tex_name);
 		return false;
 	}
 
+	// 两个节点之间组成一个四边形
+	uint16_t const node_count = (uint16_t)m_Queue.size();
+
+	// 检查顶点缓存，节点和渲染参数都没有变化时可以直接使用
+	core::Vector2U const texture_size = pTex->GetTexture()->getSize();
+	MeshCacheKey const mesh_key{
+		.texture = pTex,
+		.texture_width = texture_size.x,
+		.texture_height = texture_size.y,
+		.color = c.color(),
+		.tex_left = tex_left,
+		.tex_top = tex_top,
+		.tex_width = tex_width,
+		.tex_height = tex_height,
+		.scale = scale,
+		.node_version = m_NodeVersion,
+	};
+	bool const mesh_cached = m_MeshCacheValid && m_MeshCacheKey == mesh_key && m_VertexCache.size() == (size_t)node_count * 2;
+	if (!mesh_cached)
+	{
+		try
+		{
+			m_VertexCache.resize((size_t)node_count * 2);
+		}
+		catch (...)
+		{
+			m_MeshCacheValid = false;
+			spdlog::error("[luastg] [GameObjectBentLaser::Render] 内存不足");
+			return false;
+		}
+	}
+
 	// 设置纹理、混合模式等
 	const auto renderer = LAPP.getRenderer2D();
 	LAPP.updateGraph2DBlendMode(blend);
@@ -460,8 +536,6 @@ bool GameObjectBentLaser::Render(const char* tex_name, BlendMode blend, core::Co
 	// 分配顶点和索引
 	// 顶点总共需要：节点数 * 2
 	// 索引总共需要：(节点数 - 1) * 3 * 2
-	// 两个节点之间组成一个四边形
-	uint16_t const node_count = (uint16_t)m_Queue.size();
 	// 注意：从显卡映射的缓冲区，只能写入，禁止读取
 	IRenderer::DrawVertex* p_vertex = nullptr;
 	// 注意：从显卡映射的缓冲区，只能写入，禁止读取
@@ -475,8 +549,8 @@ bool GameObjectBentLaser::Render(const char* tex_name, BlendMode blend, core::Co
 		&index_offset)) return false; // 分配空间失败了
 
 	// 归一化 uv 坐标
-	float const u_scale = 1.0f / (float)pTex->GetTexture()->getSize().x;
-	float const v_scale = 1.0f / (float)pTex->GetTexture()->getSize().y;
+	float const u_scale = 1.0f / (float)texture_size.x;
+	float const v_scale = 1.0f / (float)texture_size.y;
 	float const v_top = tex_top * v_scale;
 	float const v_bottom = (tex_top + tex_height) * v_scale;
 
@@ -484,68 +558,68 @@ bool GameObjectBentLaser::Render(const char* tex_name, BlendMode blend, core::Co
 	// if (!cur.active || !next.active) continue;
 	// 得思考一下如何加进去
 
-	// 第一部分：填充顶点，从老节点到新节点
+	// 第一部分：填充顶点，从老节点到新节点，先生成到缓存中，再一次性复制
 	// 0---2---4---6
 	// |\  |\  |\  |
 	// | \ | \ | \ |
 	// |  \|  \|  \|
 	// 1---3---5---7
-	float total_length = 0.0f;
-	bool flip = false;
-	uint32_t const vertex_color = c.color();
-	c.a = 0;
-	uint32_t const vertex_color_alpha = c.color();
-	// 注意：从显卡映射的缓冲区，只能写入，禁止读取
-	IRenderer::DrawVertex* p_vert = p_vertex;
-	for (size_t i = 0; i < node_count; i += 1)
+	if (!mesh_cached)
 	{
-		LaserNode& node = m_Queue[i];
-
-		// 拐成钝角，需要翻转一下延展方向
-		if (node.sharp)
+		float total_length = 0.0f;
+		bool flip = false;
+		uint32_t const vertex_color = c.color();
+		c.a = 0;
+		uint32_t const vertex_color_alpha = c.color();
+		IRenderer::DrawVertex* p_vert = m_VertexCache.data();
+		for (size_t i = 0; i < node_count; i += 1)
 		{
-			flip = !flip;
-		}
+			LaserNode& node = m_Queue[i];
 
-		// 计算总长度，尾部节点到上一个节点的距离固定为 0
-		total_length += node.dis;
+			// 拐成钝角，需要翻转一下延展方向
+			if (node.sharp)
+			{
+				flip = !flip;
+			}
 
-		// 计算 u 坐标（像素坐标）
-		float tex_u = tex_left + (total_length / m_fLength) * tex_width;
+			// 计算总长度，尾部节点到上一个节点的距离固定为 0
+			total_length += node.dis;
 
-		// 计算延展向量，逆时针垂直于节点朝向
-		float pos_x = node.x_dir * scale * node.half_width;
-		float pos_y = node.y_dir * scale * node.half_width;
-		if (flip)
-		{
-			pos_x = -pos_x;
-			pos_y = -pos_y;
-		}
+			// 计算 u 坐标（像素坐标）
+			float tex_u = tex_left + (total_length / m_fLength) * tex_width;
 
-		// 填充顶点，顶点沿着节点向两侧延展
-		const IRenderer::DrawVertex vert2[2]{
-			IRenderer::DrawVertex(
+			// 计算延展向量，逆时针垂直于节点朝向
+			float pos_x = node.x_dir * scale * node.half_width;
+			float pos_y = node.y_dir * scale * node.half_width;
+			if (flip)
+			{
+				pos_x = -pos_x;
+				pos_y = -pos_y;
+			}
+
+			// 填充顶点，顶点沿着节点向两侧延展
+			p_vert[0] = IRenderer::DrawVertex(
 				node.pos.x - pos_x,
 				node.pos.y - pos_y,
 				0.5f,
 				tex_u * u_scale,
 				v_top,
 				node.active ? vertex_color : vertex_color_alpha
-			),
-			IRenderer::DrawVertex(
+			);
+			p_vert[1] = IRenderer::DrawVertex(
 				node.pos.x + pos_x,
 				node.pos.y + pos_y,
 				0.5f,
 				tex_u * u_scale,
 				v_bottom,
 				node.active ? vertex_color : vertex_color_alpha
-			),
-		};
-		std::memcpy(p_vert, vert2, sizeof(vert2)); // 尽可能使用内存复制，避免出现意外的读取
-
-		// 已使用 2 个顶点，接下来不要再修改这些顶点
-		p_vert += 2;
+			);
+			p_vert += 2;
+		}
+		m_MeshCacheKey = mesh_key;
+		m_MeshCacheValid = true;
 	}
+	std::memcpy(p_vertex, m_VertexCache.data(), sizeof(IRenderer::DrawVertex) * m_VertexCache.size()); // 尽可能使用内存复制，避免出现意外的读取
 
 	// 第二部分：填充索引
 	// 0 0-->2 2 2-->4 4 4-->6
@@ -623,74 +697,101 @@ void GameObjectBentLaser::RenderCollider(core::Color4B fillColor) noexcept
 	}
 }
 
-bool GameObjectBentLaser::CollisionCheck(float x, float y, float rot, float a, float b, bool rect) noexcept
+void GameObjectBentLaser::_UpdateChunks() noexcept
 {
-	// 忽略只有一个节点的情况
-	if (m_Queue.size() <= 1)
-		return false;
-
-	GameObject testObjA;
-	testObjA.Reset();
-	testObjA.rot = 0.;
-	testObjA.rect = false;
-
-	GameObject testObjB;
-	testObjB.Reset();
-	testObjB.x = x;
-	testObjB.y = y;
-	testObjB.rot = rot;
-	testObjB.a = a;
-	testObjB.b = b;
-	testObjB.rect = rect;
-	testObjB.UpdateCollisionCircleRadius();
-	size_t sn = m_Queue.size();
-	for (size_t i = 0; i < sn; ++i)
+	if (m_ChunkDirty == 0)
 	{
-		LaserNode& n = m_Queue[i];
-		if (!n.active)continue;
-		/*
-		if (i > 0) {
-			LaserNode& last = m_Queue[i - 1];
-			if (!last.active) {
-				float df = n.dis;
-				if (df > n.half_width) {
-					core::Vector2F c = (last.pos + n.pos) * 0.5;
-					testObjA.x = c.x;
-					testObjA.y = c.y;
-					testObjA.rect = true;
-					testObjA.rot = n.rot;
-					testObjA.a = df / 2;
-					testObjA.b = n.half_width;
-					testObjA.UpdateCollisionCircleRadius();
-					if (GameObject::isIntersect(&testObjA, &testObjB))
-						return true;
-
-				}
+		return;
+	}
+	size_t const node_count = m_Queue.size();
+	for (size_t c = 0; c < s_ChunkCount; c += 1)
+	{
+		if (!(m_ChunkDirty & (uint64_t(1) << c)))
+		{
+			continue;
+		}
+		NodeChunk chunk{};
+		for (size_t slot = c * LGOBJ_LASERCHUNKSIZE; slot < (c + 1) * LGOBJ_LASERCHUNKSIZE; slot += 1)
+		{
+			// 跳过未被使用的槽位
+			if (m_Queue.indexOfSlot(slot) >= node_count)
+			{
+				continue;
+			}
+			LaserNode const& n = m_Queue.slot(slot);
+			// 坐标或宽度无法用包围盒表示时，整个块退回逐节点检测
+			if (!std::isfinite(n.pos.x) || !std::isfinite(n.pos.y) || !(n.half_width >= 0.0f))
+			{
+				chunk.unbounded = true;
+			}
+			if (!chunk.has_node)
+			{
+				chunk.all_left = chunk.all_right = n.pos.x;
+				chunk.all_bottom = chunk.all_top = n.pos.y;
+				chunk.has_node = true;
+			}
+			else
+			{
+				chunk.all_left = (std::min)(chunk.all_left, n.pos.x);
+				chunk.all_right = (std::max)(chunk.all_right, n.pos.x);
+				chunk.all_bottom = (std::min)(chunk.all_bottom, n.pos.y);
+				chunk.all_top = (std::max)(chunk.all_top, n.pos.y);
+			}
+			if (!n.active)
+			{
+				continue;
+			}
+			if (!chunk.has_active)
+			{
+				chunk.left = chunk.right = n.pos.x;
+				chunk.bottom = chunk.top = n.pos.y;
+				chunk.max_half_width = n.half_width;
+				chunk.has_active = true;
+			}
+			else
+			{
+				chunk.left = (std::min)(chunk.left, n.pos.x);
+				chunk.right = (std::max)(chunk.right, n.pos.x);
+				chunk.bottom = (std::min)(chunk.bottom, n.pos.y);
+				chunk.top = (std::max)(chunk.top, n.pos.y);
+				chunk.max_half_width = (std::max)(chunk.max_half_width, n.half_width);
 			}
 		}
-		//*/
-		testObjA.x = n.pos.x;
-		testObjA.y = n.pos.y;
-		testObjA.a = testObjA.b = n.half_width * _GetEnvelope((float)i / (float)(sn - 1u)); //n.half_width;
-		testObjA.rect = false;
-		testObjA.UpdateCollisionCircleRadius();
-		if (GameObject::isIntersect(&testObjA, &testObjB))
-			return true;
+		m_Chunks[c] = chunk;
 	}
-	return false;
+	m_ChunkDirty = 0;
 }
 
-bool GameObjectBentLaser::CollisionCheckW(float x, float y, float rot, float a, float b, bool rect, float width) noexcept
+void GameObjectBentLaser::_UpdateEnvelopeCache() noexcept
+{
+	// 包络只与节点索引和节点数量有关，节点数量稳定后不需要重新计算
+	size_t const sn = m_Queue.size();
+	if (sn <= 1 || m_EnvelopeCacheSize == sn)
+	{
+		return;
+	}
+	m_EnvelopeCacheMax = 0.0f;
+	for (size_t i = 0; i < sn; i += 1)
+	{
+		float const envelope_ = _GetEnvelope((float)i / (float)(sn - 1u));
+		m_EnvelopeCache[i] = envelope_;
+		m_EnvelopeCacheMax = (std::max)(m_EnvelopeCacheMax, envelope_);
+	}
+	m_EnvelopeCacheSize = sn;
+}
+
+bool GameObjectBentLaser::_CollisionCheck(float x, float y, float rot, float a, float b, bool rect, bool use_envelope, float half_width) noexcept
 {
 	// 忽略只有一个节点的情况
-	if (m_Queue.size() <= 1)
+	size_t const sn = m_Queue.size();
+	if (sn <= 1)
 		return false;
-	
-	width = width / 2;
-	GameObject testObjA;
-	testObjA.Reset();
-	testObjA.rot = 0.;
-	testObjA.rect = false;
+
+	if (use_envelope)
+	{
+		_UpdateEnvelopeCache();
+	}
+	_UpdateChunks();
 
 	GameObject testObjB;
 	testObjB.Reset();
@@ -701,50 +802,100 @@ bool GameObjectBentLaser::CollisionCheckW(float x, float y, float rot, float a,
 	testObjB.b = b;
 	testObjB.rect = rect;
 	testObjB.UpdateCollisionCircleRadius();
-	size_t sn = m_Queue.size();
-	for (size_t i = 0; i < sn; ++i)
-	{
-		LaserNode& n = m_Queue[i];
-		if (!n.active)continue;
-		/*
-		if (i > 0) {
-			LaserNode& last = m_Queue[i - 1];
-			if (!last.active) {
-				float df = n.dis;
-				if (df > width) {
-					core::Vector2F c = (last.pos + n.pos) * 0.5;
-					testObjA.x = c.x;
-					testObjA.y = c.y;
-					testObjA.rect = true;
-					testObjA.rot = n.rot;
-					testObjA.a = df / 2;
-					testObjA.b = width;
-					testObjA.UpdateCollisionCircleRadius();
-					if (GameObject::isIntersect(&testObjA, &testObjB))
-						return true;
+	GameObjectCollider const other = testObjB.getCollider();
 
-				}
+	for (size_t c = 0; c < s_ChunkCount; c += 1)
+	{
+		NodeChunk const& chunk = m_Chunks[c];
+		if (!chunk.has_active)
+		{
+			continue;
+		}
+		// 块内节点的半径都不会超过块的半径，与精确检测的包围盒检测写法一致，被剔除的块内不会有相交的节点
+		if (!chunk.unbounded)
+		{
+			double const r = use_envelope ? (double)(chunk.max_half_width * m_EnvelopeCacheMax) : (double)half_width;
+			if ((chunk.right + r) < (other.x - other.col_r)
+				|| (chunk.left - r) > (other.x + other.col_r)
+				|| (chunk.top + r) < (other.y - other.col_r)
+				|| (chunk.bottom - r) > (other.y + other.col_r))
+			{
+				continue;
 			}
 		}
-		//*/
-		testObjA.x = n.pos.x;
-		testObjA.y = n.pos.y;
-		testObjA.a = testObjA.b = width;
-		testObjA.rect = false;
-		testObjA.UpdateCollisionCircleRadius();
-		if (GameObject::isIntersect(&testObjA, &testObjB))
-			return true;
+		for (size_t slot = c * LGOBJ_LASERCHUNKSIZE; slot < (c + 1) * LGOBJ_LASERCHUNKSIZE; slot += 1)
+		{
+			size_t const i = m_Queue.indexOfSlot(slot);
+			if (i >= sn)
+			{
+				continue;
+			}
+			LaserNode const& n = m_Queue.slot(slot);
+			if (!n.active)
+			{
+				continue;
+			}
+			float const r = use_envelope ? n.half_width * m_EnvelopeCache[i] : half_width;
+			GameObjectCollider const self{
+				.x = n.pos.x,
+				.y = n.pos.y,
+				.col_r = r,
+				.a = r,
+				.b = r,
+				.rot = 0.0f,
+				.type = GameObjectColliderType::Circle,
+			};
+			if (GameObject::isIntersect(self, other))
+				return true;
+		}
 	}
 	return false;
 }
 
+bool GameObjectBentLaser::CollisionCheck(float x, float y, float rot, float a, float b, bool rect) noexcept
+{
+	return _CollisionCheck(x, y, rot, a, b, rect, true, 0.0f);
+}
+
+bool GameObjectBentLaser::CollisionCheckW(float x, float y, float rot, float a, float b, bool rect, float width) noexcept
+{
+	return _CollisionCheck(x, y, rot, a, b, rect, false, width / 2);
+}
+
 bool GameObjectBentLaser::BoundCheck() noexcept
 {
+	_UpdateChunks();
 	auto& manager = LPOOL;
-	for (size_t i = 0u; i < m_Queue.size(); i++) {
-		LaserNode& n = m_Queue[i];
-		if (manager.isPointInBound(n.pos.x, n.pos.y)) {
-			return true;
+	for (size_t c = 0; c < s_ChunkCount; c += 1)
+	{
+		NodeChunk const& chunk = m_Chunks[c];
+		if (!chunk.has_node)
+		{
+			continue;
+		}
+		if (!chunk.unbounded)
+		{
+			// 整个块都在边界内
+			if (manager.isPointInBound(chunk.all_left, chunk.all_bottom) && manager.isPointInBound(chunk.all_right, chunk.all_top))
+			{
+				return true;
+			}
+			// 整个块都在边界外
+			if (manager.isRectOutOfBound(chunk.all_left, chunk.all_right, chunk.all_bottom, chunk.all_top))
+			{
+				continue;
+			}
+		}
+		for (size_t slot = c * LGOBJ_LASERCHUNKSIZE; slot < (c + 1) * LGOBJ_LASERCHUNKSIZE; slot += 1)
+		{
+			if (m_Queue.indexOfSlot(slot) >= m_Queue.size())
+			{
+				continue;
+			}
+			LaserNode const& n = m_Queue.slot(slot);
+			if (manager.isPointInBound(n.pos.x, n.pos.y)) {
+				return true;
+			}
 		}
 	}
 	return false;
@@ -776,7 +927,9 @@ bool GameObjectBentLaser::UpdateByNode(size_t id, int node, int length, float wi
 	{
 		LaserNode& tNode = m_Queue[node];
 		tNode.active = active;
-		_UpdateAllNode();
+		_MarkNodeDirty((size_t)node);
+		// 只改变了激活状态，节点的位置、距离和朝向都不需要重新计算
+		_UpdateLength();
 	}
 
 	return true;
@@ -942,6 +1095,7 @@ int GameObjectBentLaser::api_UpdateSingleNode(lua_State* L)
 	node.pos.y = y;
 	node.half_width = half_width;
 	node.active = true;
+	_MarkNodeDirty(node_index);
 	if (node_index > 0)
 	{
 		LaserNode& last = m_Queue[node_index - 1];
@@ -954,6 +1108,16 @@ int GameObjectBentLaser::api_UpdateSingleNode(lua_State* L)
 		node.dis = 0.0f; // 没有上一个节点
 	}
 
+	// 下一个节点到这个节点的距离也变了
+	if (node_index + 1 < m_Queue.size())
+	{
+		LaserNode& next = m_Queue[node_index + 1];
+		m_fLength -= next.dis;
+		float const len_ = (next.pos - node.pos).length();
+		next.dis = len_;
+		m_fLength += len_;
+	}
+
 	// 更新修改的节点和相邻的节点
 	_UpdateNodeVertexExtend(node_index);
 	if (m_Queue.size() > 1)
@@ -994,6 +1158,7 @@ int GameObjectBentLaser::api_UpdateAllNodeByList(lua_State* L)
 		return luaL_error(L, "invalid parameter #1, number of nodes should <= %d", (int)m_Queue.capacity());
 	}
 	m_Queue.placementResize(node_count);
+	_MarkAllNodeDirty();
 
 	// 设置所有节点的坐标和宽度
 	if (read_width)
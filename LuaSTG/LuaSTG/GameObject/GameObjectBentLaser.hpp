@@ -2,10 +2,13 @@
 #include "core/Vector2.hpp"
 #include "core/Color.hpp"
 #include "core/FixedCircularQueue.hpp"
+#include "core/Graphics/Renderer.hpp"
 #include "GameResource/ResourceBase.hpp"
+#include "GameResource/ResourceTexture.hpp"
 #include "lua.hpp"
 
 #define LGOBJ_MAXLASERNODE 512  // 曲线激光最大节点数
+#define LGOBJ_LASERCHUNKSIZE 32  // 曲线激光碰撞分块的槽位数
 
 namespace luastg
 {
@@ -42,8 +45,66 @@ namespace luastg
 				);
 			return (std::max)(0.0f, ret);
 		}
+	private:
+		// 碰撞分块：按队列的存储槽位划分，节点出入队不会导致其他节点换块，只需要重新计算被修改的块
+		struct NodeChunk
+		{
+			// 活动节点的坐标包围盒，用于碰撞检测
+			float left = 0.0f;
+			float right = 0.0f;
+			float bottom = 0.0f;
+			float top = 0.0f;
+			float max_half_width = 0.0f; // 活动节点的最大半宽
+			bool has_active = false;
+			// 所有节点的坐标包围盒，用于出界检测
+			float all_left = 0.0f;
+			float all_right = 0.0f;
+			float all_bottom = 0.0f;
+			float all_top = 0.0f;
+			bool has_node = false;
+			bool unbounded = false; // 存在非有限坐标或负数半宽时不剔除，交给逐节点检测
+		};
+		static constexpr size_t s_ChunkCount = LGOBJ_MAXLASERNODE / LGOBJ_LASERCHUNKSIZE;
+		static_assert(LGOBJ_MAXLASERNODE % LGOBJ_LASERCHUNKSIZE == 0);
+		static_assert(s_ChunkCount <= 64);
+		std::array<NodeChunk, s_ChunkCount> m_Chunks;
+		uint64_t m_ChunkDirty = ~uint64_t(0); // 需要重新计算的块
+		std::array<float, LGOBJ_MAXLASERNODE> m_EnvelopeCache; // 按节点索引缓存的包络系数
+		size_t m_EnvelopeCacheSize = 0; // 缓存对应的节点数量，0 表示缓存失效
+		float m_EnvelopeCacheMax = 0.0f;
+		uint64_t m_NodeVersion = 0; // 节点每次被修改都会递增
+		void _MarkNodeDirty(size_t i) noexcept { m_ChunkDirty |= uint64_t(1) << (m_Queue.slotOf(i) / LGOBJ_LASERCHUNKSIZE); m_NodeVersion += 1; }
+		void _MarkAllNodeDirty() noexcept { m_ChunkDirty = ~uint64_t(0); m_NodeVersion += 1; }
+		void _UpdateChunks() noexcept; // 重新计算被修改的块
+		void _UpdateEnvelopeCache() noexcept; // 节点数量或包络变化后重新计算包络系数
+		bool _CollisionCheck(float x, float y, float rot, float a, float b, bool rect, bool use_envelope, float half_width) noexcept;
+	private:
+		// 渲染缓存：节点和渲染参数都没有变化时直接复制上一次生成的顶点
+		struct MeshCacheKey
+		{
+			IResourceTexture* texture = nullptr;
+			uint32_t texture_width = 0;
+			uint32_t texture_height = 0;
+			uint32_t color = 0;
+			float tex_left = 0.0f;
+			float tex_top = 0.0f;
+			float tex_width = 0.0f;
+			float tex_height = 0.0f;
+			float scale = 0.0f;
+			uint64_t node_version = 0;
+			bool operator==(MeshCacheKey const&) const noexcept = default;
+		};
+		core::SmartReference<IResourceTexture> m_pTexture; // 上一次渲染使用的纹理
+		std::string m_TextureName;
+		uint64_t m_TextureGeneration = 0;
+		std::vector<core::Graphics::IRenderer::DrawVertex> m_VertexCache; // 按节点顺序排列的顶点
+		MeshCacheKey m_MeshCacheKey;
+		bool m_MeshCacheValid = false;
+		IResourceTexture* _FindTexture(const char* tex_name) noexcept; // 纹理池没有变化时直接使用上一次找到的纹理
+	private:
 		void _UpdateNodeVertexExtend(size_t i) noexcept; // 计算节点的渲染顶点
 		void _UpdateAllNode() noexcept; // 重新计算所有节点的朝向和距离
+		void _UpdateLength() noexcept; // 根据节点间的距离重新计算总长度，不修改节点
 		void _PopHead() noexcept; // 弹出头部节点，较早的节点
 	public:
 		// 读取
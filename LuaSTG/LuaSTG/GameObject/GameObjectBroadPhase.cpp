@@ -0,0 +1,165 @@
+#include "GameObject/GameObjectBroadPhase.hpp"
+
+namespace {
+	constexpr double min_cell_size{ 16.0 };
+	constexpr double max_cell_size{ 1024.0 };
+	constexpr double cell_size_scale{ 4.0 }; // 网格尺寸为平均外接圆半径的倍数
+	constexpr double max_cell_coordinate{ 1 << 24 };
+	constexpr int64_t max_cells_per_object{ 16 };
+	constexpr int64_t max_cells_per_query{ 64 };
+
+	int32_t toCellCoordinate(double const value, double const inv_cell_size) noexcept {
+		auto const cell = std::floor(value * inv_cell_size);
+		if (!(cell == cell)) {
+			return 0; // NaN
+		}
+		return static_cast<int32_t>(std::clamp(cell, -max_cell_coordinate, max_cell_coordinate));
+	}
+
+	// 坐标或半径异常的对象无法放入网格，当作大对象处理，保证结果与逐个检测一致
+	bool isRegular(double const x, double const y, double const r) noexcept {
+		return std::isfinite(x) && std::isfinite(y) && std::isfinite(r) && r >= 0.0;
+	}
+
+	bool isRegular(luastg::GameObject const* const object) noexcept {
+		return isRegular(object->x, object->y, object->col_r);
+	}
+
+	uint32_t nextPowerOfTwo(size_t const value) noexcept {
+		uint32_t result{ 16 };
+		while (result < value) {
+			result <<= 1;
+		}
+		return result;
+	}
+}
+
+namespace luastg {
+	void GameObjectSpatialHash::clear() noexcept {
+		m_objects.clear();
+		m_large_objects.clear();
+		m_staging.clear();
+		m_entries.clear();
+		m_bucket_offsets.clear();
+		m_bucket_mask = 0;
+	}
+
+	void GameObjectSpatialHash::add(GameObject* const object) {
+		if (!object->colli) {
+			return; // 不参与碰撞的对象永远不会相交
+		}
+		m_objects.push_back(object);
+	}
+
+	void GameObjectSpatialHash::build() {
+		m_large_objects.clear();
+		m_staging.clear();
+		m_entries.clear();
+		m_bucket_offsets.clear();
+		m_bucket_mask = 0;
+		if (m_objects.empty()) {
+			return;
+		}
+
+		// 根据平均外接圆半径选取网格尺寸
+
+		double radius_sum{};
+		for (auto const object : m_objects) {
+			if (isRegular(object)) {
+				radius_sum += object->col_r;
+			}
+		}
+		auto const average_radius = radius_sum / static_cast<double>(m_objects.size());
+		m_cell_size = std::clamp(average_radius * cell_size_scale, min_cell_size, max_cell_size);
+		m_inv_cell_size = 1.0 / m_cell_size;
+
+		// 计算每个对象覆盖的网格
+
+		for (uint32_t index = 0; index < static_cast<uint32_t>(m_objects.size()); index += 1) {
+			auto const object = m_objects[index];
+			if (!isRegular(object)) {
+				m_large_objects.push_back(index);
+				continue;
+			}
+			auto const range = getCellRange(object->x, object->y, object->col_r);
+			if (range.count() > max_cells_per_object) {
+				m_large_objects.push_back(index);
+				continue;
+			}
+			for (int32_t cell_y = range.y0; cell_y <= range.y1; cell_y += 1) {
+				for (int32_t cell_x = range.x0; cell_x <= range.x1; cell_x += 1) {
+					m_staging.push_back(Entry{ .cell_x = cell_x, .cell_y = cell_y, .index = index });
+				}
+			}
+		}
+
+		// 计数排序到哈希桶，桶内保持索引升序
+
+		auto const bucket_count = nextPowerOfTwo(m_staging.size());
+		m_bucket_mask = bucket_count - 1;
+		m_bucket_offsets.assign(static_cast<size_t>(bucket_count) + 1, 0);
+		for (auto& entry : m_staging) {
+			entry.bucket = getBucket(entry.cell_x, entry.cell_y);
+			m_bucket_offsets[entry.bucket + 1] += 1;
+		}
+		for (size_t i = 1; i < m_bucket_offsets.size(); i += 1) {
+			m_bucket_offsets[i] += m_bucket_offsets[i - 1];
+		}
+		m_entries.resize(m_staging.size());
+		m_cursors.assign(m_bucket_offsets.begin(), m_bucket_offsets.end() - 1);
+		for (auto const& entry : m_staging) {
+			m_entries[m_cursors[entry.bucket]] = entry;
+			m_cursors[entry.bucket] += 1;
+		}
+	}
+
+	void GameObjectSpatialHash::query(GameObject const* const object, std::vector<uint32_t>& output) const {
+		query(object->x, object->y, object->col_r, output);
+	}
+
+	void GameObjectSpatialHash::query(double const x, double const y, double const r, std::vector<uint32_t>& output) const {
+		output.clear();
+		if (m_objects.empty()) {
+			return;
+		}
+		auto const range = getCellRange(x, y, r);
+		if (!isRegular(x, y, r) || range.count() > max_cells_per_query) {
+			// 查询范围过大，直接退化为与所有对象配对
+			output.resize(m_objects.size());
+			for (uint32_t index = 0; index < static_cast<uint32_t>(output.size()); index += 1) {
+				output[index] = index;
+			}
+			return;
+		}
+		for (int32_t cell_y = range.y0; cell_y <= range.y1; cell_y += 1) {
+			for (int32_t cell_x = range.x0; cell_x <= range.x1; cell_x += 1) {
+				auto const bucket = getBucket(cell_x, cell_y);
+				for (auto i = m_bucket_offsets[bucket]; i < m_bucket_offsets[bucket + 1]; i += 1) {
+					if (auto const& entry = m_entries[i]; entry.cell_x == cell_x && entry.cell_y == cell_y) {
+						output.push_back(entry.index);
+					}
+				}
+			}
+		}
+		output.insert(output.end(), m_large_objects.begin(), m_large_objects.end());
+		// 保证回调顺序与链表顺序一致
+		std::sort(output.begin(), output.end());
+		output.erase(std::unique(output.begin(), output.end()), output.end());
+	}
+
+	GameObjectSpatialHash::CellRange GameObjectSpatialHash::getCellRange(double const x, double const y, double const r) const noexcept {
+		return CellRange{
+			.x0 = toCellCoordinate(x - r, m_inv_cell_size),
+			.y0 = toCellCoordinate(y - r, m_inv_cell_size),
+			.x1 = toCellCoordinate(x + r, m_inv_cell_size),
+			.y1 = toCellCoordinate(y + r, m_inv_cell_size),
+		};
+	}
+
+	uint32_t GameObjectSpatialHash::getBucket(int32_t const cell_x, int32_t const cell_y) const noexcept {
+		auto hash = static_cast<uint32_t>(cell_x) * 0x9e3779b1u;
+		hash ^= static_cast<uint32_t>(cell_y) * 0x85ebca77u;
+		hash ^= hash >> 15;
+		return hash & m_bucket_mask;
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "GameObject/GameObject.hpp"
+#include <vector>
+
+namespace luastg {
+	// 相交检测粗略阶段：均匀网格空间哈希
+	// 每次批量相交检测时按碰撞组重建，只向精确检测阶段提供外接圆包围盒所在网格有重叠的对象
+	class GameObjectSpatialHash {
+	public:
+		// 清空所有数据，保留已分配的内存
+		void clear() noexcept;
+
+		// 按碰撞组链表顺序添加对象，添加顺序即为对象的索引，不参与碰撞的对象会被忽略
+		void add(GameObject* object);
+
+		// 添加完所有对象后构建网格
+		void build();
+
+		// 查询可能与指定对象相交的对象，结果为按索引升序排列且不重复的索引，保证与链表顺序一致
+		void query(GameObject const* object, std::vector<uint32_t>& output) const;
+
+		// 同上，但查询的是以 (x, y) 为中心、半径为 r 的外接圆
+		void query(double x, double y, double r, std::vector<uint32_t>& output) const;
+
+		[[nodiscard]] GameObject* object(uint32_t const index) const noexcept { return m_objects[index]; }
+		[[nodiscard]] size_t size() const noexcept { return m_objects.size(); }
+		[[nodiscard]] bool empty() const noexcept { return m_objects.empty(); }
+
+	private:
+		struct CellRange {
+			int32_t x0{};
+			int32_t y0{};
+			int32_t x1{};
+			int32_t y1{};
+
+			[[nodiscard]] int64_t count() const noexcept {
+				return (static_cast<int64_t>(x1) - x0 + 1) * (static_cast<int64_t>(y1) - y0 + 1);
+			}
+		};
+
+		struct Entry {
+			int32_t cell_x{};
+			int32_t cell_y{};
+			uint32_t index{};
+			uint32_t bucket{};
+		};
+
+		[[nodiscard]] CellRange getCellRange(double x, double y, double r) const noexcept;
+		[[nodiscard]] uint32_t getBucket(int32_t cell_x, int32_t cell_y) const noexcept;
+
+		std::vector<GameObject*> m_objects;
+		std::vector<uint32_t> m_large_objects; // 覆盖网格过多的大对象，与所有对象配对
+		std::vector<Entry> m_staging;
+		std::vector<Entry> m_entries; // 按桶排序
+		std::vector<uint32_t> m_bucket_offsets;
+		std::vector<uint32_t> m_cursors;
+		uint32_t m_bucket_mask{};
+		double m_cell_size{ 1.0 };
+		double m_inv_cell_size{ 1.0 };
+	};
+}
@@ -0,0 +1,334 @@
+#include "GameObject/GameObjectColliderSnapshot.hpp"
+#include "Utility/CpuFeature.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace {
+	constexpr size_t simd_width{ 8 };
+
+	// 转换到单精度以及单精度运算的相对误差都远小于该值
+	constexpr float bounds_margin{ 1.0f / 65536.0f };
+
+	// 以下比较均为有序比较，NaN 永远不会被剔除
+
+	bool isRejected(luastg::GameObjectColliderBounds const& a, float const x, float const y, float const r) noexcept {
+		auto const dx = std::abs(a.x - x);
+		auto const dy = std::abs(a.y - y);
+		auto const rr = a.r + r;
+		return dx > rr || dy > rr || (dx * dx + dy * dy) > (rr * rr);
+	}
+
+#ifndef LUASTG_CPU_X86
+	void filterScalar(
+		luastg::GameObjectColliderBounds const& bounds,
+		float const* const xs, float const* const ys, float const* const rs,
+		uint32_t const base, uint32_t const count,
+		std::vector<uint32_t>& output
+	) {
+		for (uint32_t i = 0; i < count; i += 1) {
+			if (!isRejected(bounds, xs[i], ys[i], rs[i])) {
+				output.push_back(base + i);
+			}
+		}
+	}
+#else
+	void appendMask(uint32_t mask, uint32_t const base, std::vector<uint32_t>& output) {
+		while (mask != 0) {
+		#ifdef _MSC_VER
+			unsigned long bit{};
+			_BitScanForward(&bit, mask);
+		#else
+			auto const bit = static_cast<uint32_t>(__builtin_ctz(mask));
+		#endif
+			output.push_back(base + static_cast<uint32_t>(bit));
+			mask &= mask - 1;
+		}
+	}
+
+	void filterSSE(
+		luastg::GameObjectColliderBounds const& bounds,
+		float const* const xs, float const* const ys, float const* const rs,
+		uint32_t const base, uint32_t const count,
+		std::vector<uint32_t>& output
+	) {
+		auto const sign_mask = _mm_set1_ps(-0.0f);
+		auto const qx = _mm_set1_ps(bounds.x);
+		auto const qy = _mm_set1_ps(bounds.y);
+		auto const qr = _mm_set1_ps(bounds.r);
+		for (uint32_t i = 0; i < count; i += 4) {
+			auto const dx = _mm_andnot_ps(sign_mask, _mm_sub_ps(_mm_loadu_ps(xs + i), qx));
+			auto const dy = _mm_andnot_ps(sign_mask, _mm_sub_ps(_mm_loadu_ps(ys + i), qy));
+			auto const rr = _mm_add_ps(_mm_loadu_ps(rs + i), qr);
+			auto const d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+			auto const rejected = _mm_or_ps(
+				_mm_or_ps(_mm_cmpgt_ps(dx, rr), _mm_cmpgt_ps(dy, rr)),
+				_mm_cmpgt_ps(d2, _mm_mul_ps(rr, rr)));
+			auto mask = static_cast<uint32_t>(~_mm_movemask_ps(rejected)) & 0xfu;
+			if (auto const remaining = count - i; remaining < 4) {
+				mask &= (1u << remaining) - 1u;
+			}
+			appendMask(mask, base + i, output);
+		}
+	}
+
+	LUASTG_TARGET_AVX void filterAVX(
+		luastg::GameObjectColliderBounds const& bounds,
+		float const* const xs, float const* const ys, float const* const rs,
+		uint32_t const base, uint32_t const count,
+		std::vector<uint32_t>& output
+	) {
+		auto const sign_mask = _mm256_set1_ps(-0.0f);
+		auto const qx = _mm256_set1_ps(bounds.x);
+		auto const qy = _mm256_set1_ps(bounds.y);
+		auto const qr = _mm256_set1_ps(bounds.r);
+		for (uint32_t i = 0; i < count; i += 8) {
+			auto const dx = _mm256_andnot_ps(sign_mask, _mm256_sub_ps(_mm256_loadu_ps(xs + i), qx));
+			auto const dy = _mm256_andnot_ps(sign_mask, _mm256_sub_ps(_mm256_loadu_ps(ys + i), qy));
+			auto const rr = _mm256_add_ps(_mm256_loadu_ps(rs + i), qr);
+			auto const d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+			auto const rejected = _mm256_or_ps(
+				_mm256_or_ps(_mm256_cmp_ps(dx, rr, _CMP_GT_OQ), _mm256_cmp_ps(dy, rr, _CMP_GT_OQ)),
+				_mm256_cmp_ps(d2, _mm256_mul_ps(rr, rr), _CMP_GT_OQ));
+			auto mask = static_cast<uint32_t>(~_mm256_movemask_ps(rejected)) & 0xffu;
+			if (auto const remaining = count - i; remaining < 8) {
+				mask &= (1u << remaining) - 1u;
+			}
+			appendMask(mask, base + i, output);
+		}
+		_mm256_zeroupper();
+	}
+#endif
+
+	// 剔除 [begin, end) 区间内的对象，结果追加到 output
+	void filterRange(
+		luastg::GameObjectColliderBounds const& bounds,
+		float const* const xs, float const* const ys, float const* const rs,
+		uint32_t const begin, uint32_t const end,
+		std::vector<uint32_t>& output
+	) {
+	#ifdef LUASTG_CPU_X86
+		if (luastg::isAvxSupported()) {
+			filterAVX(bounds, xs + begin, ys + begin, rs + begin, begin, end - begin, output);
+		}
+		else {
+			filterSSE(bounds, xs + begin, ys + begin, rs + begin, begin, end - begin, output);
+		}
+	#else
+		filterScalar(bounds, xs + begin, ys + begin, rs + begin, begin, end - begin, output);
+	#endif
+	}
+}
+
+namespace luastg {
+	void GameObjectColliderSnapshot::clear() noexcept {
+		m_x.clear();
+		m_y.clear();
+		m_r.clear();
+		m_colliders.clear();
+		m_objects.clear();
+		m_triggers.clear();
+		m_object_counts.fill(0);
+		m_trigger_counts.fill(0);
+	#ifdef USING_MULTI_GAME_WORLD
+		m_world_masks.clear();
+		m_partitions.clear();
+		m_order.clear();
+	#endif // USING_MULTI_GAME_WORLD
+	}
+
+	void GameObjectColliderSnapshot::add(GameObject* const object) {
+	#ifdef USING_MULTI_GAME_WORLD
+		count(object, all_worlds_mask);
+	#else // USING_MULTI_GAME_WORLD
+		count(object, 0);
+	#endif // USING_MULTI_GAME_WORLD
+		if (!object->colli) {
+			return; // 不参与碰撞的对象永远不会相交
+		}
+		append(object);
+	}
+
+	void GameObjectColliderSnapshot::count(GameObject const* const object, uint32_t const bucket) noexcept {
+		m_object_counts[bucket] += 1;
+		if (object->features.has_callback_trigger) {
+			m_trigger_counts[bucket] += 1;
+		}
+	}
+
+	void GameObjectColliderSnapshot::append(GameObject* const object) {
+		auto const index = static_cast<uint32_t>(m_objects.size());
+		auto const collider = object->getCollider();
+		auto const bounds = makeBounds(collider);
+		m_x.push_back(bounds.x);
+		m_y.push_back(bounds.y);
+		m_r.push_back(bounds.r);
+		m_colliders.push_back(collider);
+		m_objects.push_back(object);
+		if (object->features.has_callback_trigger) {
+			m_triggers.push_back(index);
+		}
+	#ifdef USING_MULTI_GAME_WORLD
+		m_world_masks.push_back(static_cast<uint8_t>(all_worlds_mask));
+	#endif // USING_MULTI_GAME_WORLD
+	}
+
+	void GameObjectColliderSnapshot::build() {
+		// 补齐到 SIMD 宽度，补齐部分会在剔除时被掩码排除
+		auto padded_size = (m_objects.size() + simd_width - 1) / simd_width * simd_width;
+	#ifdef USING_MULTI_GAME_WORLD
+		partition();
+		if (m_partitions.size() > 1) {
+			padded_size += simd_width; // 分区的起点不一定对齐，最后一个分区可能读取到更多的补齐部分
+		}
+	#endif // USING_MULTI_GAME_WORLD
+		m_x.resize(padded_size, 0.0f);
+		m_y.resize(padded_size, 0.0f);
+		m_r.resize(padded_size, 0.0f);
+	}
+
+	void GameObjectColliderSnapshot::filter(GameObjectColliderBounds const& bounds, std::vector<uint32_t>& output) const {
+		output.clear();
+		filterRange(bounds, m_x.data(), m_y.data(), m_r.data(), 0, static_cast<uint32_t>(m_objects.size()), output);
+	#ifdef USING_MULTI_GAME_WORLD
+		sortByOrder(output);
+	#endif // USING_MULTI_GAME_WORLD
+	}
+
+	void GameObjectColliderSnapshot::filter(GameObjectColliderBounds const& bounds, std::vector<uint32_t> const& candidates, std::vector<uint32_t>& output) const {
+		output.clear();
+		for (auto const index : candidates) {
+			if (!isRejected(bounds, m_x[index], m_y[index], m_r[index])) {
+				output.push_back(index);
+			}
+		}
+	#ifdef USING_MULTI_GAME_WORLD
+		sortByOrder(output);
+	#endif // USING_MULTI_GAME_WORLD
+	}
+
+#ifdef USING_MULTI_GAME_WORLD
+	void GameObjectColliderSnapshot::add(GameObject* const object, uint32_t const world_mask) {
+		count(object, world_mask & all_worlds_mask);
+		if (!object->colli) {
+			return;
+		}
+		append(object);
+		m_world_masks.back() = static_cast<uint8_t>(world_mask & all_worlds_mask);
+	}
+
+	void GameObjectColliderSnapshot::filter(GameObjectColliderBounds const& bounds, uint32_t const world_mask, std::vector<uint32_t>& output) const {
+		output.clear();
+		for (auto const& [partition_mask, begin, end] : m_partitions) {
+			if ((partition_mask & world_mask) != 0) {
+				filterRange(bounds, m_x.data(), m_y.data(), m_r.data(), begin, end, output);
+			}
+		}
+		sortByOrder(output);
+	}
+
+	void GameObjectColliderSnapshot::filter(GameObjectColliderBounds const& bounds, uint32_t const world_mask, std::vector<uint32_t> const& candidates, std::vector<uint32_t>& output) const {
+		output.clear();
+		for (auto const index : candidates) {
+			if ((m_world_masks[index] & world_mask) != 0 && !isRejected(bounds, m_x[index], m_y[index], m_r[index])) {
+				output.push_back(index);
+			}
+		}
+		sortByOrder(output);
+	}
+
+	void GameObjectColliderSnapshot::partition() {
+		m_partitions.clear();
+		m_order.clear();
+		auto const count = static_cast<uint32_t>(m_objects.size());
+		if (count == 0) {
+			return;
+		}
+		std::array<uint32_t, all_worlds_mask + 1> offsets{};
+		for (auto const world_mask : m_world_masks) {
+			offsets[world_mask] += 1;
+		}
+		uint32_t begin{};
+		for (uint32_t world_mask = 0; world_mask <= all_worlds_mask; world_mask += 1) {
+			auto const size = offsets[world_mask];
+			offsets[world_mask] = begin;
+			if (size > 0) {
+				m_partitions.push_back(Partition{ .world_mask = world_mask, .begin = begin, .end = begin + size });
+			}
+			begin += size;
+		}
+		if (m_partitions.size() == 1) {
+			return; // 所有对象都在同一个分区内，不需要重新排列
+		}
+
+		// 计数排序，同一分区内保持添加顺序
+
+		m_partition_index.resize(count);
+		m_order.resize(count);
+		for (uint32_t i = 0; i < count; i += 1) {
+			auto const index = offsets[m_world_masks[i]]++;
+			m_partition_index[i] = index;
+			m_order[index] = i;
+		}
+		auto const permute = [this, count](auto& values, auto& scratch) {
+			scratch.resize(count);
+			for (uint32_t i = 0; i < count; i += 1) {
+				scratch[m_partition_index[i]] = values[i];
+			}
+			scratch.swap(values);
+		};
+		// 浮点数组共用一个临时数组，交换后临时数组保存的是上一个数组原来的数据
+		permute(m_x, m_partition_float);
+		permute(m_y, m_partition_float);
+		permute(m_r, m_partition_float);
+		permute(m_colliders, m_partition_colliders);
+		permute(m_objects, m_partition_objects);
+		permute(m_world_masks, m_partition_world_masks);
+		for (auto& index : m_triggers) {
+			index = m_partition_index[index];
+		}
+	}
+
+	void GameObjectColliderSnapshot::sortByOrder(std::vector<uint32_t>& output) const {
+		if (m_order.empty() || output.size() < 2) {
+			return;
+		}
+		std::sort(output.begin(), output.end(), [this](uint32_t const l, uint32_t const r) {
+			return m_order[l] < m_order[r];
+		});
+	}
+#endif // USING_MULTI_GAME_WORLD
+
+	GameObjectColliderBounds GameObjectColliderSnapshot::makeBounds(GameObjectCollider const& collider) noexcept {
+		// 半径为负数时原有的检测仍然可能判定为相交，不做剔除
+		if (!(collider.col_r >= 0.0)) {
+			return { static_cast<float>(collider.x), static_cast<float>(collider.y), std::numeric_limits<float>::infinity() };
+		}
+		auto const x = static_cast<float>(collider.x);
+		auto const y = static_cast<float>(collider.y);
+		auto const r = static_cast<float>(collider.col_r);
+		// 放大半径以覆盖单精度的舍入误差，保证不会剔除精确检测中相交的对象
+		auto const margin = (std::abs(x) + std::abs(y) + r) * bounds_margin + std::numeric_limits<float>::min();
+		return { x, y, r + margin };
+	}
+
+	uint64_t GameObjectColliderSnapshot::countPairs(GameObjectColliderSnapshot const& snapshot1, GameObjectColliderSnapshot const& snapshot2) noexcept {
+		uint64_t result{};
+		for (uint32_t bucket1 = 0; bucket1 < count_bucket_size; bucket1 += 1) {
+			if (snapshot1.m_trigger_counts[bucket1] == 0) {
+				continue;
+			}
+			for (uint32_t bucket2 = 0; bucket2 < count_bucket_size; bucket2 += 1) {
+			#ifdef USING_MULTI_GAME_WORLD
+				// 位集合有交集时 CheckWorlds 为 true
+				if ((bucket1 & bucket2) == 0) {
+					continue;
+				}
+			#endif // USING_MULTI_GAME_WORLD
+				result += uint64_t{ snapshot1.m_trigger_counts[bucket1] } * snapshot2.m_object_counts[bucket2];
+			}
+		}
+		return result;
+	}
+}
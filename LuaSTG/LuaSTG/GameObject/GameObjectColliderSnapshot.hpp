@@ -0,0 +1,112 @@
+#pragma once
+#include "GameObject/GameObject.hpp"
+#include <array>
+#include <vector>
+
+namespace luastg {
+	// 单精度外接圆包围盒，半径已按坐标量级放大，用于保守的快速剔除
+	struct GameObjectColliderBounds {
+		float x;
+		float y;
+		float r;
+	};
+
+	// 碰撞组快照：批量相交检测开始时按链表顺序复制碰撞体数据，以 SoA 布局存储供 SIMD 批量剔除
+	// 快速剔除只会排除一定不相交的对象，剩下的对象仍使用与逐个检测完全相同的精确检测，结果与逐个检测一致
+	class GameObjectColliderSnapshot {
+	public:
+		// 清空所有数据，保留已分配的内存
+		void clear() noexcept;
+
+		// 按碰撞组链表顺序添加对象，添加顺序即为对象的索引，不参与碰撞的对象会被忽略
+		void add(GameObject* object);
+
+		// 添加完所有对象后补齐 SIMD 宽度
+		void build();
+
+		// 剔除一定不与指定包围盒相交的对象，结果为按添加顺序排列的索引
+		void filter(GameObjectColliderBounds const& bounds, std::vector<uint32_t>& output) const;
+
+		// 同上，但只检测候选对象，候选对象索引需升序排列
+		void filter(GameObjectColliderBounds const& bounds, std::vector<uint32_t> const& candidates, std::vector<uint32_t>& output) const;
+
+	#ifdef USING_MULTI_GAME_WORLD
+		// 所有预置 world 的位集合
+		static constexpr uint32_t all_worlds_mask{ 0xfu };
+
+		// 同 add，world_mask 为对象所在的预置 world 的位集合，位集合没有交集的对象一定不会相交
+		// build 时对象按位集合分区，同一分区内保持添加顺序，分区后对象的索引会发生变化
+		void add(GameObject* object, uint32_t world_mask);
+
+		// 同 filter，但只检测位集合与 world_mask 有交集的分区
+		void filter(GameObjectColliderBounds const& bounds, uint32_t world_mask, std::vector<uint32_t>& output) const;
+
+		// 同上，但只检测候选对象，候选对象索引需升序排列
+		void filter(GameObjectColliderBounds const& bounds, uint32_t world_mask, std::vector<uint32_t> const& candidates, std::vector<uint32_t>& output) const;
+
+		[[nodiscard]] uint32_t worldMask(uint32_t const index) const noexcept { return m_world_masks[index]; }
+	#endif // USING_MULTI_GAME_WORLD
+
+		[[nodiscard]] GameObject* object(uint32_t const index) const noexcept { return m_objects[index]; }
+		[[nodiscard]] GameObjectCollider const& collider(uint32_t const index) const noexcept { return m_colliders[index]; }
+		[[nodiscard]] GameObjectColliderBounds bounds(uint32_t const index) const noexcept { return { m_x[index], m_y[index], m_r[index] }; }
+		[[nodiscard]] std::vector<uint32_t> const& triggers() const noexcept { return m_triggers; }
+		[[nodiscard]] size_t size() const noexcept { return m_objects.size(); }
+		[[nodiscard]] bool empty() const noexcept { return m_objects.empty(); }
+
+		[[nodiscard]] static GameObjectColliderBounds makeBounds(GameObjectCollider const& collider) noexcept;
+
+		// 逐个检测时需要检测的对象对数量，用于统计，与 detectIntersectionLegacy 的计数方式一致：
+		// snapshot1 中带有 trigger 回调的对象与 snapshot2 中可能在同一个 world 内的所有对象的组合，包括不参与碰撞的对象
+		[[nodiscard]] static uint64_t countPairs(GameObjectColliderSnapshot const& snapshot1, GameObjectColliderSnapshot const& snapshot2) noexcept;
+
+	private:
+	#ifdef USING_MULTI_GAME_WORLD
+		static constexpr size_t count_bucket_size{ all_worlds_mask + 1 };
+	#else // USING_MULTI_GAME_WORLD
+		static constexpr size_t count_bucket_size{ 1 };
+	#endif // USING_MULTI_GAME_WORLD
+
+		// 统计添加的对象，包括被忽略的对象
+		void count(GameObject const* object, uint32_t bucket) noexcept;
+
+		// 添加参与碰撞的对象
+		void append(GameObject* object);
+
+		// 热数据
+		std::vector<float> m_x;
+		std::vector<float> m_y;
+		std::vector<float> m_r;
+		// 冷数据，仅在精确检测阶段使用
+		std::vector<GameObjectCollider> m_colliders;
+		std::vector<GameObject*> m_objects;
+		std::vector<uint32_t> m_triggers; // 带有 trigger 回调的对象，按添加顺序排列
+		// 按 world 位集合统计的添加过的对象数量和其中带有 trigger 回调的对象数量
+		std::array<uint32_t, count_bucket_size> m_object_counts{};
+		std::array<uint32_t, count_bucket_size> m_trigger_counts{};
+
+	#ifdef USING_MULTI_GAME_WORLD
+		struct Partition {
+			uint32_t world_mask;
+			uint32_t begin;
+			uint32_t end;
+		};
+
+		// 按位集合分区，只有一个分区时不改变对象的索引
+		void partition();
+
+		// 分区后索引不再按添加顺序排列，需要按添加顺序重新排列剔除结果
+		void sortByOrder(std::vector<uint32_t>& output) const;
+
+		std::vector<uint8_t> m_world_masks;
+		std::vector<Partition> m_partitions;
+		std::vector<uint32_t> m_order; // 分区后每个对象的添加顺序，没有重新排列时为空
+		// 分区时使用的临时数据，保留内存以便下一帧复用
+		std::vector<uint32_t> m_partition_index;
+		std::vector<float> m_partition_float;
+		std::vector<GameObjectCollider> m_partition_colliders;
+		std::vector<GameObject*> m_partition_objects;
+		std::vector<uint8_t> m_partition_world_masks;
+	#endif // USING_MULTI_GAME_WORLD
+	};
+}
@@ -34,57 +34,74 @@ namespace {
 	}
 
 	bool isAxisAlignedBoundingBoxNotIntersect(
-		luastg::GameObject const* const p1,
-		luastg::GameObject const* const p2
+		luastg::GameObjectCollider const& c1,
+		luastg::GameObjectCollider const& c2
 	) noexcept {
 		return isAxisAlignedBoundingBoxNotIntersect(
-			p1->x, p1->y, p1->col_r, p1->col_r,
-			p2->x, p2->y, p2->col_r, p2->col_r);
+			c1.x, c1.y, c1.col_r, c1.col_r,
+			c2.x, c2.y, c2.col_r, c2.col_r);
 	}
 
-	xmath::collision::ColliderType getColliderType(luastg::GameObject const* const p) noexcept {
-		return p->rect
-			? xmath::collision::ColliderType::OBB
-			: p->a == p->b
-			? xmath::collision::ColliderType::Circle
-			: xmath::collision::ColliderType::Ellipse;
+	xmath::collision::ColliderType toColliderType(luastg::GameObjectColliderType const type) noexcept {
+		switch (type) {
+		case luastg::GameObjectColliderType::OBB:
+			return xmath::collision::ColliderType::OBB;
+		case luastg::GameObjectColliderType::Ellipse:
+			return xmath::collision::ColliderType::Ellipse;
+		case luastg::GameObjectColliderType::Circle:
+		default:
+			return xmath::collision::ColliderType::Circle;
+		}
 	}
 }
 
 namespace luastg {
+	GameObjectCollider GameObject::getCollider() const noexcept {
+		return GameObjectCollider{
+			.x = x,
+			.y = y,
+			.col_r = col_r,
+			.a = static_cast<float>(a),
+			.b = static_cast<float>(b),
+			.rot = static_cast<float>(rot),
+			.type = rect
+				? GameObjectColliderType::OBB
+				: a == b
+				? GameObjectColliderType::Circle
+				: GameObjectColliderType::Ellipse,
+		};
+	}
+
 	bool GameObject::isIntersect(GameObject const* const p1, GameObject const* const p2) noexcept {
 		//忽略不碰撞对象
 		if (!p1->colli || !p2->colli) {
 			return false;
 		}
 
+		return isIntersect(p1->getCollider(), p2->getCollider());
+	}
+
+	bool GameObject::isIntersect(GameObjectCollider const& c1, GameObjectCollider const& c2) noexcept {
 		//快速AABB检测
-		if (isAxisAlignedBoundingBoxNotIntersect(p1, p2)) {
+		if (isAxisAlignedBoundingBoxNotIntersect(c1, c2)) {
 			return false;
 		}
 
-		cocos2d::Vec2 const xy1(static_cast<float>(p1->x), static_cast<float>(p1->y));
-		auto const r1 = static_cast<float>(p1->col_r);
-		cocos2d::Vec2 const xy2(static_cast<float>(p2->x), static_cast<float>(p2->y));
-		auto const r2 = static_cast<float>(p2->col_r);
-
-		auto const a1 = static_cast<float>(p1->a);
-		auto const b1 = static_cast<float>(p1->b);
-		auto const rot1 = static_cast<float>(p1->rot);
-		auto const a2 = static_cast<float>(p2->a);
-		auto const b2 = static_cast<float>(p2->b);
-		auto const rot2 = static_cast<float>(p2->rot);
+		cocos2d::Vec2 const xy1(static_cast<float>(c1.x), static_cast<float>(c1.y));
+		auto const r1 = static_cast<float>(c1.col_r);
+		cocos2d::Vec2 const xy2(static_cast<float>(c2.x), static_cast<float>(c2.y));
+		auto const r2 = static_cast<float>(c2.col_r);
 
 		//外接圆碰撞检测
 		if (!xmath::collision::check(
-			xy1, r1, r1, rot1, xmath::collision::ColliderType::Circle,
-			xy2, r2, r2, rot2, xmath::collision::ColliderType::Circle)) {
+			xy1, r1, r1, c1.rot, xmath::collision::ColliderType::Circle,
+			xy2, r2, r2, c2.rot, xmath::collision::ColliderType::Circle)) {
 			return false;
 		}
 
 		// 精确碰撞检测
 		return xmath::collision::check(
-			xy1, a1, b1, rot1, getColliderType(p1),
-			xy2, a2, b2, rot2, getColliderType(p2));
+			xy1, c1.a, c1.b, c1.rot, toColliderType(c1.type),
+			xy2, c2.a, c2.b, c2.rot, toColliderType(c2.type));
 	}
 }
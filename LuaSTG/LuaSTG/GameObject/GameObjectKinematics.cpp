@@ -0,0 +1,54 @@
+#include "GameObject/GameObjectKinematics.hpp"
+#include <cfloat>
+#include <cmath>
+#include <algorithm>
+
+namespace luastg {
+	bool GameObjectKinematics::isSupported(GameObject const* const object) noexcept {
+	#ifdef LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
+		if (object->pause > 0 || object->resolve_move) {
+			return false;
+		}
+	#endif // LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
+		// 粒子系统的更新依赖更新顺序（随机数），需要按链表顺序逐个更新
+		return object->res == nullptr || object->res->GetType() != ResourceType::Particle;
+	}
+
+	void GameObjectKinematics::update(GameObject* const object) noexcept {
+		// 运算顺序与 GameObject::UpdateV2 保持一致，速度限制的分支改写为选择
+
+		// 更新速度
+		GameObjectScalar vx_ = object->vx + object->ax;
+		GameObjectScalar vy_ = object->vy + object->ay;
+	#ifdef USER_SYSTEM_OPERATION
+		// 单独应用重力加速度
+		vy_ -= object->ag;
+		// 速度限制，来自lua层，与 UpdateV2 一样以 double 计算缩放比例
+		GameObjectScalar const max_v_ = object->max_v;
+		double const speed_ = std::sqrt(vx_ * vx_ + vy_ * vy_);
+		double const scale_ = max_v_ / speed_;
+		auto const stop_ = max_v_ <= DBL_MIN;
+		auto const limit_ = max_v_ < speed_ && speed_ > DBL_MIN;
+		vx_ = stop_ ? GameObjectScalar{} : (limit_ ? static_cast<GameObjectScalar>(scale_ * vx_) : vx_);
+		vy_ = stop_ ? GameObjectScalar{} : (limit_ ? static_cast<GameObjectScalar>(scale_ * vy_) : vy_);
+		//针对x、y方向单独限制
+		vx_ = std::clamp(vx_, -object->max_vx, object->max_vx);
+		vy_ = std::clamp(vy_, -object->max_vy, object->max_vy);
+	#endif
+		object->vx = vx_;
+		object->vy = vy_;
+		object->x += vx_;
+		object->y += vy_;
+		object->rot += object->omega;
+
+		// 自动旋转
+
+		if (object->navi && object->last_xy_touched) {
+			auto const dx_ = object->x - object->last_x;
+			auto const dy_ = object->y - object->last_y;
+			if (std::abs(dx_) > DBL_MIN || std::abs(dy_) > DBL_MIN) {
+				object->rot = std::atan2(dy_, dx_);
+			}
+		}
+	}
+}
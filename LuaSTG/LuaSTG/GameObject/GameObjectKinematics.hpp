@@ -0,0 +1,15 @@
+#pragma once
+#include "GameObject/GameObject.hpp"
+
+namespace luastg {
+	// 运动学批量更新：按对象池槽位顺序就地更新对象的运动学属性，结果与 GameObject::UpdateV2 逐位一致
+	// 不复制对象的属性，Lua 层写入的值直接参与运算，不需要同步；只在所有 frame 回调结束后执行，Lua 层无法观察到中间状态
+	class GameObjectKinematics {
+	public:
+		// 判断对象是否可以批量更新，带有粒子系统或处于暂停状态的对象需要逐个更新
+		[[nodiscard]] static bool isSupported(GameObject const* object) noexcept;
+
+		// 就地更新对象的运动学属性，对象必须满足 isSupported
+		static void update(GameObject* object) noexcept;
+	};
+}
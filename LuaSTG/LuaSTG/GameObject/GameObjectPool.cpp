@@ -1,13 +1,21 @@
 #include "GameObject/GameObjectPool.h"
+#include "GameObject/GameObjectBehavior.hpp"
+#include "GameObject/GameObjectKinematics.hpp"
 #include "LuaBinding/LuaWrapper.hpp"
 #include "LuaBinding/modern/GameObject.hpp"
 #include "lua/plus.hpp"
+#include "Utility/JobSystem.hpp"
 #include "AppFrame.h"
+#include <bit>
 
 using std::string_view_literals::operator ""sv;
 
 namespace {
 	constexpr auto queue_to_destroy_reason_out_of_world_bound{ "luastg:leave_world_border"sv };
+	// 并行任务划分粒度，对象过少时线程调度的开销大于收益
+	constexpr size_t parallel_kinematics_chunk_size{ 1024 };
+	constexpr size_t parallel_bound_check_chunk_size{ 2048 };
+	constexpr size_t parallel_bound_check_min_object_count{ 4096 };
 }
 
 namespace luastg
@@ -16,13 +24,14 @@ namespace luastg
 
 	static GameObjectPool* g_GameObjectPool = nullptr;
 
-	GameObjectPool::GameObjectPool() {
+	GameObjectPool::GameObjectPool(size_t const capacity) {
 		assert(g_GameObjectPool == nullptr);
 		g_GameObjectPool = this;
 
+		setCapacity(capacity);
+
 		// initialize GameObject list
 
-		m_render_list = decltype(m_render_list){ &m_memory_resource };
 		m_callbacks = decltype(m_callbacks){&m_memory_resource};
 		resetGameObjectLists();
 
@@ -58,6 +67,9 @@ namespace luastg
 		m_statistics[m_statistics_index].object_alive = m_ObjectPool.size();
 		m_statistics[m_statistics_index].object_colli_check = 0;
 		m_statistics[m_statistics_index].object_colli_callback = 0;
+		m_statistics[m_statistics_index].object_capacity = m_ObjectPool.capacity();
+		m_statistics[m_statistics_index].object_memory = m_ObjectPool.memoryUsage();
+		m_statistics[m_statistics_index].object_move_time = 0;
 	}
 	GameObjectPool::FrameStatistics GameObjectPool::DebugGetFrameStatistics()
 	{
@@ -66,6 +78,46 @@ namespace luastg
 		return m_statistics[i];
 	}
 
+	bool GameObjectPool::setCapacity(size_t const capacity) noexcept {
+		// 批量过程中可能仍然持有对象的指针
+		if (m_is_rendering || m_is_detecting_intersect) {
+			return false;
+		}
+		auto const new_capacity = std::clamp<size_t>(capacity, 1, max_capacity);
+		try {
+			// 预留批量回收需要的空间，freeWithCallbacks 在帧中不再分配内存
+			m_pending_free_ids.reserve(new_capacity);
+		}
+		catch (std::bad_alloc const&) {
+			return false;
+		}
+		if (!m_ObjectPool.setCapacity(new_capacity)) {
+			return false;
+		}
+		// 渲染列表和空间查询缓存中可能残留已回收对象的指针，它们所在的块已经被释放
+		m_render_list.clear();
+		markSpatialQueryDirty();
+		m_generation += 1;
+		return true;
+	}
+	bool GameObjectPool::setGroupCount(size_t const count) noexcept {
+		if (count < 1 || count > LOBJPOOL_GROUPN) {
+			return false;
+		}
+		for (size_t group = count; group < m_group_count; group += 1) {
+			if (!m_detect_lists[group].empty()) {
+				return false;
+			}
+		}
+		// 清除碰撞矩阵中被移除的碰撞组
+		auto const mask = count < 64 ? ((uint64_t{ 1 } << count) - 1) : ~uint64_t{ 0 };
+		for (size_t group = 0; group < LOBJPOOL_GROUPN; group += 1) {
+			m_collision_matrix[group] = group < count ? (m_collision_matrix[group] & mask) : 0;
+		}
+		m_group_count = count;
+		return true;
+	}
+
 	void GameObjectPool::ResetPool() noexcept
 	{
 		// 回收已分配的对象和更新链表
@@ -73,9 +125,12 @@ namespace luastg
 		for (auto p = m_update_list.first(); p != nullptr;) {
 			p = freeWithCallbacks(p);
 		}
+		flushFreedObjects();
 		dispatchOnAfterBatchDestroy();
 		// 重置其他链表
 		resetGameObjectLists();
+		assert(m_attached_objects.empty());
+		m_attached_objects_unordered = false;
 		// 重置整个对象池，恢复为线性状态
 		m_ObjectPool.clear();
 		// 重置其他数据
@@ -88,6 +143,7 @@ namespace luastg
 		m_LockObjectB = nullptr;
 		m_superpause = 0;
 		m_nextsuperpause = 0;
+		markSpatialQueryDirty();
 		// 清理内存
 		m_memory_resource.release();
 	}
@@ -99,7 +155,11 @@ namespace luastg
 			if (super_pause_time > 0 && !p->ignore_super_pause) {
 				continue;
 			}
-			if (p->features.has_callback_update) {
+			// 行为程序在 frame 回调之前执行，独占模式的行为程序结束后，当前帧就会恢复调用 frame 回调
+			if (p->behavior != nullptr) {
+				p->UpdateBehavior();
+			}
+			if (p->features.has_callback_update && (p->behavior == nullptr || !p->behavior->exclusive)) {
 			#ifdef USING_MULTI_GAME_WORLD
 				m_pCurrentObject = p;
 			#endif // USING_MULTI_GAME_WORLD
@@ -110,7 +170,10 @@ namespace luastg
 			}
 			p->Update();
 		}
+		destroyOrphanedAttachments();
 		dispatchOnAfterBatchUpdate();
+		resolveAttachments();
+		markSpatialQueryDirty();
 	}
 	void GameObjectPool::updateMovements() {
 		tracy_zone_scoped_with_name("LOBJMGR.ObjFrame(New)");
@@ -118,28 +181,103 @@ namespace luastg
 		dispatchOnBeforeBatchUpdate();
 
 		auto const super_pause_time = GetSuperPauseTime();
+		dispatchOnUpdateAll(super_pause_time);
+		destroyOrphanedAttachments();
+
+		dispatchOnAfterBatchUpdate();
+
+		auto const move_start = std::chrono::steady_clock::now();
 		for (auto p = m_update_list.first(); p != nullptr; p = p->update_list_next) {
 			if (super_pause_time > 0 && !p->ignore_super_pause) {
 				continue;
 			}
-			if (p->features.has_callback_update) {
-			#ifdef USING_MULTI_GAME_WORLD
-				m_pCurrentObject = p;
-			#endif // USING_MULTI_GAME_WORLD
-				p->dispatchOnUpdate();
-			#ifdef USING_MULTI_GAME_WORLD
-				m_pCurrentObject = nullptr;
-			#endif // USING_MULTI_GAME_WORLD
-			}
+			p->UpdateV2();
 		}
+		resolveAttachments();
+		markSpatialQueryDirty();
+		recordMoveTime(move_start);
+	}
+	void GameObjectPool::updateMovementsBatch() {
+		tracy_zone_scoped_with_name("LOBJMGR.ObjFrame(New)");
+
+		dispatchOnBeforeBatchUpdate();
+
+		auto const super_pause_time = GetSuperPauseTime();
+		dispatchOnUpdateAll(super_pause_time);
+		destroyOrphanedAttachments();
 
 		dispatchOnAfterBatchUpdate();
 
+		// 所有回调已经结束，从这里开始到运动更新结束为止 Lua 层无法访问对象
+		auto const move_start = std::chrono::steady_clock::now();
+		auto& job_system = JobSystem::getInstance();
+		auto const slot_count = m_ObjectPool.slotCount();
+		auto const chunk_count = job_system.getChunkCount(slot_count, parallel_kinematics_chunk_size);
+		if (m_kinematics_individual_objects.size() < chunk_count) {
+			m_kinematics_individual_objects.resize(chunk_count);
+		}
+		{
+			// 按对象池的连续区间就地更新，每个对象只修改自身的运动学属性，可以并行执行
+			tracy_zone_scoped_with_name("LOBJMGR.ObjFrame(New).Kinematics");
+			job_system.parallelFor(slot_count, parallel_kinematics_chunk_size, [&](size_t const chunk_index, size_t const begin, size_t const end) {
+				auto& individual_objects = m_kinematics_individual_objects[chunk_index];
+				individual_objects.clear();
+				for (size_t id = begin; id < end; id += 1) {
+					auto const p = m_ObjectPool.object(id);
+					if (p == nullptr || (super_pause_time > 0 && !p->ignore_super_pause)) {
+						continue;
+					}
+					if (GameObjectKinematics::isSupported(p)) {
+						GameObjectKinematics::update(p);
+					}
+					else {
+						individual_objects.push_back(p);
+					}
+				}
+			});
+		}
+		{
+			// 粒子系统的更新依赖更新顺序，更新链表按 unique_id 升序排列，按 unique_id 排序后逐个更新
+			tracy_zone_scoped_with_name("LOBJMGR.ObjFrame(New).Individual");
+			std::pmr::vector<GameObject*> individual_objects{ &LAPP.GetFrameArena() };
+			for (size_t chunk_index = 0; chunk_index < chunk_count; chunk_index += 1) {
+				auto& output = m_kinematics_individual_objects[chunk_index];
+				individual_objects.insert(individual_objects.end(), output.begin(), output.end());
+				output.clear();
+			}
+			std::sort(individual_objects.begin(), individual_objects.end(), [](GameObject const* const l, GameObject const* const r) {
+				return l->unique_id < r->unique_id;
+			});
+			for (auto const p : individual_objects) {
+				p->UpdateV2();
+			}
+		}
+		resolveAttachments();
+		markSpatialQueryDirty();
+		recordMoveTime(move_start);
+	}
+	void GameObjectPool::recordMoveTime(std::chrono::steady_clock::time_point const start) noexcept {
+		auto const end = std::chrono::steady_clock::now();
+		m_statistics[m_statistics_index].object_move_time += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+	void GameObjectPool::dispatchOnUpdateAll(int64_t const super_pause_time) {
 		for (auto p = m_update_list.first(); p != nullptr; p = p->update_list_next) {
 			if (super_pause_time > 0 && !p->ignore_super_pause) {
 				continue;
 			}
-			p->UpdateV2();
+			// 行为程序在 frame 回调之前执行，独占模式的行为程序结束后，当前帧就会恢复调用 frame 回调
+			if (p->behavior != nullptr) {
+				p->UpdateBehavior();
+			}
+			if (p->features.has_callback_update && (p->behavior == nullptr || !p->behavior->exclusive)) {
+			#ifdef USING_MULTI_GAME_WORLD
+				m_pCurrentObject = p;
+			#endif // USING_MULTI_GAME_WORLD
+				p->dispatchOnUpdate();
+			#ifdef USING_MULTI_GAME_WORLD
+				m_pCurrentObject = nullptr;
+			#endif // USING_MULTI_GAME_WORLD
+			}
 		}
 	}
 	void GameObjectPool::render() {
@@ -150,7 +288,14 @@ namespace luastg
 		auto const world = GetWorldFlag();
 #endif // USING_MULTI_GAME_WORLD
 
-		for (auto& p : m_render_list) {
+		{
+			tracy_zone_scoped_with_name("LOBJMGR.ObjRender.Sort");
+			m_render_list.update(m_update_list.first(), &LAPP.GetFrameArena());
+		}
+
+		// 渲染回调中新创建的对象会在下一次渲染时加入渲染列表
+		for (size_t i = 0; i < m_render_list.size(); i += 1) {
+			auto const p = m_render_list[i];
 #ifdef USING_MULTI_GAME_WORLD
 			if (!p->hide && CheckWorld(p->world, world)) { // 只渲染可见对象
 				m_pCurrentObject = p;
@@ -181,6 +326,7 @@ namespace luastg
 			}
 			p->UpdateLast();
 		}
+		markSpatialQueryDirty();
 	}
 	void GameObjectPool::updateNextLegacy() {
 		tracy_zone_scoped_with_name("LOBJMGR.AfterFrame");
@@ -198,7 +344,9 @@ namespace luastg
 			p->UpdateTimer();
 			p = p->update_list_next;
 		}
+		flushFreedObjects();
 		dispatchOnAfterBatchDestroy();
+		markSpatialQueryDirty();
 	}
 	void GameObjectPool::updateNext() {
 		tracy_zone_scoped_with_name("LOBJMGR.AfterFrame(New)");
@@ -216,7 +364,9 @@ namespace luastg
 			p->UpdateLastV2();
 			p = p->update_list_next;
 		}
+		flushFreedObjects();
 		dispatchOnAfterBatchDestroy();
+		markSpatialQueryDirty();
 	}
 	void GameObjectPool::detectOutOfWorldBoundLegacy() {
 		tracy_zone_scoped_with_name("LOBJMGR.BoundCheck");
@@ -255,34 +405,64 @@ namespace luastg
 
 		dispatchOnBeforeBatchOutOfWorldBoundCheck();
 
-		struct OutOfWorldBoundDetectionResult {
-			uint64_t uid{};
-			GameObject* game_object{};
-		};
-
-		std::pmr::deque<OutOfWorldBoundDetectionResult> cache{ &m_memory_resource };
+		std::pmr::deque<OutOfWorldBoundDetectionResult> cache{ &LAPP.GetFrameArena() };
 
 #ifdef USING_MULTI_GAME_WORLD
 		auto const world = GetWorldFlag();
 #endif // USING_MULTI_GAME_WORLD
 
-		for (auto p = m_update_list.first(); p != nullptr; p = p->update_list_next) {
+		auto const check = [&](GameObject* const p, auto& output) {
 #ifdef USING_MULTI_GAME_WORLD
 			if (!CheckWorld(p->world, world)) {
-				continue;
+				return;
 			}
 #endif // USING_MULTI_GAME_WORLD
 			if (_ObjectBoundCheck(p)) {
-				continue;
+				return;
 			}
 			p->status = GameObjectStatus::Dead; // 产生副作用
 			// 需要调用 del 回调
 			if (p->features.has_callback_destroy) {
-				cache.push_back(OutOfWorldBoundDetectionResult{
+				output.push_back(OutOfWorldBoundDetectionResult{
 					.uid = p->unique_id,
 					.game_object = p,
 				});
 			}
+		};
+
+		auto& job_system = JobSystem::getInstance();
+		auto const chunk_count = job_system.getChunkCount(m_ObjectPool.slotCount(), parallel_bound_check_chunk_size);
+		if (m_ObjectPool.size() < parallel_bound_check_min_object_count || chunk_count <= 1) {
+			for (auto p = m_update_list.first(); p != nullptr; p = p->update_list_next) {
+				check(p, cache);
+			}
+		}
+		else {
+			// 按对象池的连续区间并行检测，出界检测不涉及 Lua，每个对象只修改自身状态
+			{
+				tracy_zone_scoped_with_name("LOBJMGR.BoundCheck(New).Parallel");
+				if (m_out_of_world_bound_results.size() < chunk_count) {
+					m_out_of_world_bound_results.resize(chunk_count);
+				}
+				job_system.parallelFor(m_ObjectPool.slotCount(), parallel_bound_check_chunk_size, [&](size_t const chunk_index, size_t const begin, size_t const end) {
+					auto& output = m_out_of_world_bound_results[chunk_index];
+					output.clear();
+					for (size_t id = begin; id < end; id += 1) {
+						if (auto const p = m_ObjectPool.object(id); p != nullptr) {
+							check(p, output);
+						}
+					}
+				});
+			}
+			// 更新链表按 unique_id 升序排列，按 unique_id 排序后回调顺序与逐个检测一致
+			for (size_t chunk_index = 0; chunk_index < chunk_count; chunk_index += 1) {
+				auto& output = m_out_of_world_bound_results[chunk_index];
+				cache.insert(cache.end(), output.begin(), output.end());
+				output.clear();
+			}
+			std::sort(cache.begin(), cache.end(), [](OutOfWorldBoundDetectionResult const& l, OutOfWorldBoundDetectionResult const& r) {
+				return l.uid < r.uid;
+			});
 		}
 
 		for (auto const& [uid, game_object] : cache) {
@@ -346,20 +526,83 @@ namespace luastg
 		m_is_detecting_intersect = true;
 		dispatchOnBeforeBatchIntersectDetect();
 		auto& debug_data = m_statistics[m_statistics_index];
-		std::pmr::deque<IntersectionDetectionResult> cache{ &m_memory_resource };
+		std::array<bool, LOBJPOOL_GROUPN> prepared{};
+		std::pmr::deque<IntersectionDetectionResult> cache{ &LAPP.GetFrameArena() };
 		for (const auto& [group1, group2] : group_pairs) {
-			for (auto object1 = m_detect_lists[group1].first(); object1 != nullptr; object1 = object1->detect_list_next) {
-				for (auto object2 = m_detect_lists[group2].first(); object2 != nullptr; object2 = object2->detect_list_next) {
-					if (!object1->features.has_callback_trigger) {
-						continue;
-					}
+			auto const& snapshot1 = prepareColliderSnapshot(group1, prepared);
+			auto const& snapshot2 = prepareColliderSnapshot(group2, prepared);
+			// 统计逐个检测时需要检测的对象对数量，与实际经过剔除后检测的数量无关
+			debug_data.object_colli_check += GameObjectColliderSnapshot::countPairs(snapshot1, snapshot2);
+			if (snapshot1.triggers().empty() || snapshot2.empty()) {
+				continue;
+			}
+			for (auto const index1 : snapshot1.triggers()) {
+				auto const object1 = snapshot1.object(index1);
+				auto const& collider1 = snapshot1.collider(index1);
 #ifdef USING_MULTI_GAME_WORLD
-					if (!CheckWorlds(object1->world, object2->world)) {
+				// 只检测可能在同一个 world 内的分区
+				snapshot2.filter(snapshot1.bounds(index1), snapshot1.worldMask(index1), m_collider_filter_result);
+#else // USING_MULTI_GAME_WORLD
+				snapshot2.filter(snapshot1.bounds(index1), m_collider_filter_result);
+#endif // USING_MULTI_GAME_WORLD
+				for (auto const index2 : m_collider_filter_result) {
+					auto const object2 = snapshot2.object(index2);
+					if (!GameObject::isIntersect(collider1, snapshot2.collider(index2))) {
 						continue;
 					}
+					cache.push_back(IntersectionDetectionResult{
+						.uid1 = object1->unique_id,
+						.uid2 = object2->unique_id,
+						.object1 = object1,
+						.object2 = object2,
+					});
+				}
+			}
+		}
+		dispatchIntersectionDetectionResults(cache);
+		dispatchOnAfterBatchIntersectDetect();
+		m_is_detecting_intersect = false;
+	}
+	void GameObjectPool::detectIntersectionSpatialHash(std::pmr::vector<IntersectionDetectionGroupPair> const& group_pairs) {
+		tracy_zone_scoped_with_name("LOBJMGR.CollisionCheck(SpatialHash)");
+		m_is_detecting_intersect = true;
+		dispatchOnBeforeBatchIntersectDetect();
+		auto& debug_data = m_statistics[m_statistics_index];
+		std::array<bool, LOBJPOOL_GROUPN> prepared{};
+		std::array<bool, LOBJPOOL_GROUPN> built{};
+		std::pmr::deque<IntersectionDetectionResult> cache{ &LAPP.GetFrameArena() };
+		for (const auto& [group1, group2] : group_pairs) {
+			auto const& snapshot1 = prepareColliderSnapshot(group1, prepared);
+			auto const& snapshot2 = prepareColliderSnapshot(group2, prepared);
+			// 统计逐个检测时需要检测的对象对数量，与实际经过剔除后检测的数量无关
+			debug_data.object_colli_check += GameObjectColliderSnapshot::countPairs(snapshot1, snapshot2);
+			if (snapshot1.triggers().empty() || snapshot2.empty()) {
+				continue;
+			}
+			// 每个碰撞组在一次检测中只构建一次，对象索引与快照一致
+			auto& spatial_hash = m_spatial_hashes[group2];
+			if (!built[group2]) {
+				tracy_zone_scoped_with_name("LOBJMGR.CollisionCheck(SpatialHash).Build");
+				spatial_hash.clear();
+				for (uint32_t index2 = 0; index2 < snapshot2.size(); index2 += 1) {
+					spatial_hash.add(snapshot2.object(index2)); // 快照中的对象可能已经按 world 分区重新排列
+				}
+				spatial_hash.build();
+				built[group2] = true;
+			}
+			assert(spatial_hash.size() == snapshot2.size());
+			for (auto const index1 : snapshot1.triggers()) {
+				auto const object1 = snapshot1.object(index1);
+				auto const& collider1 = snapshot1.collider(index1);
+				spatial_hash.query(object1, m_spatial_hash_query_result);
+#ifdef USING_MULTI_GAME_WORLD
+				snapshot2.filter(snapshot1.bounds(index1), snapshot1.worldMask(index1), m_spatial_hash_query_result, m_collider_filter_result);
+#else // USING_MULTI_GAME_WORLD
+				snapshot2.filter(snapshot1.bounds(index1), m_spatial_hash_query_result, m_collider_filter_result);
 #endif // USING_MULTI_GAME_WORLD
-					debug_data.object_colli_check += 1;
-					if (!GameObject::isIntersect(object1, object2)) {
+				for (auto const index2 : m_collider_filter_result) {
+					auto const object2 = snapshot2.object(index2);
+					if (!GameObject::isIntersect(collider1, snapshot2.collider(index2))) {
 						continue;
 					}
 					cache.push_back(IntersectionDetectionResult{
@@ -371,7 +614,62 @@ namespace luastg
 				}
 			}
 		}
-		for (auto const& [uid1, uid2, object1, object2] : cache) {
+		dispatchIntersectionDetectionResults(cache);
+		dispatchOnAfterBatchIntersectDetect();
+		m_is_detecting_intersect = false;
+	}
+	void GameObjectPool::setCollisionMatrix(std::pmr::vector<IntersectionDetectionGroupPair> const& group_pairs) {
+		static_assert(LOBJPOOL_GROUPN <= 64);
+		m_collision_matrix.fill(0);
+		for (auto const& [group1, group2] : group_pairs) {
+			assert(group1 < m_group_count && group2 < m_group_count);
+			m_collision_matrix[group1] |= uint64_t{ 1 } << group2;
+		}
+	}
+	void GameObjectPool::detectIntersectionMatrix(bool const spatial_hash) {
+		tracy_zone_scoped_with_name("LOBJMGR.CollisionCheck(Matrix)");
+		m_collision_matrix_group_pairs.clear();
+		for (uint32_t group1 = 0; group1 < m_group_count; group1 += 1) {
+			auto row = m_collision_matrix[group1];
+			if (row == 0 || m_detect_lists[group1].empty()) {
+				continue;
+			}
+			while (row != 0) {
+				auto const group2 = static_cast<uint32_t>(std::countr_zero(row));
+				row &= row - 1;
+				if (!m_detect_lists[group2].empty()) {
+					m_collision_matrix_group_pairs.emplace_back(group1, group2);
+				}
+			}
+		}
+		if (spatial_hash) {
+			detectIntersectionSpatialHash(m_collision_matrix_group_pairs);
+		}
+		else {
+			detectIntersection(m_collision_matrix_group_pairs);
+		}
+	}
+	GameObjectColliderSnapshot const& GameObjectPool::prepareColliderSnapshot(uint32_t const group, std::array<bool, LOBJPOOL_GROUPN>& prepared) {
+		// 回调在检测结束后统一触发，检测期间对象不会发生变化，每个碰撞组在一次检测中只复制一次
+		auto& snapshot = m_collider_snapshots[group];
+		if (!prepared[group]) {
+			tracy_zone_scoped_with_name("LOBJMGR.CollisionCheck.Snapshot");
+			snapshot.clear();
+			for (auto object = m_detect_lists[group].first(); object != nullptr; object = object->detect_list_next) {
+#ifdef USING_MULTI_GAME_WORLD
+				snapshot.add(object, GetWorldsMask(static_cast<int32_t>(object->world)));
+#else // USING_MULTI_GAME_WORLD
+				snapshot.add(object);
+#endif // USING_MULTI_GAME_WORLD
+			}
+			snapshot.build();
+			prepared[group] = true;
+		}
+		return snapshot;
+	}
+	void GameObjectPool::dispatchIntersectionDetectionResults(std::pmr::deque<IntersectionDetectionResult> const& results) {
+		auto& debug_data = m_statistics[m_statistics_index];
+		for (auto const& [uid1, uid2, object1, object2] : results) {
 			if (object1->unique_id != uid1 || object2->unique_id != uid2) {
 				assert(false); continue; // 理论上不太可能发生
 			}
@@ -388,34 +686,34 @@ namespace luastg
 			m_LockObjectA = nullptr;
 			m_LockObjectB = nullptr;
 		}
-		dispatchOnAfterBatchIntersectDetect();
-		m_is_detecting_intersect = false;
 	}
 	void GameObjectPool::DirtResetObject(GameObject* p) noexcept
 	{
 		// 分配新的 UUID 并重新插入更新链表末尾
 		m_update_list.remove(p);
-		m_render_list.erase(p);
 		assert(p != m_LockObjectA && p != m_LockObjectB);
 		m_detect_lists[p->group].remove(p);
+		detachObject(p);
 		p->unique_id = m_iUid % GameObject::max_unique_id; // GameObject::max_unique_id is reserved
 		++m_iUid;
 		m_update_list.add(p);
-		m_render_list.insert(p);
+		m_render_list.markUnordered();
 		m_detect_lists[p->group].add(p);
+		markSpatialQueryDirty(p->group);
 	}
 
 	void GameObjectPool::setGroup(GameObject* const object, size_t const group) {
 		assert(object != m_LockObjectA && object != m_LockObjectB);
 		m_detect_lists[object->group].remove(object);
+		markSpatialQueryDirty(object->group);
 		object->group = static_cast<int32_t>(group);
 		m_detect_lists[object->group].add(object);
+		markSpatialQueryDirty(object->group);
 	}
 	void GameObjectPool::setLayer(GameObject* const object, double const layer) {
 		assert(!m_is_rendering);
-		m_render_list.erase(object);
-		object->layer = layer;
-		m_render_list.insert(object);
+		object->layer = static_cast<GameObjectScalar>(layer);
+		m_render_list.markUnordered();
 	}
 
 	GameObject* GameObjectPool::allocateWithCallbacks(IGameObjectCallbacks* const callbacks) {
@@ -435,8 +733,9 @@ namespace luastg
 		}
 	#endif // USING_MULTI_GAME_WORLD
 		m_update_list.add(p);
-		m_render_list.insert(p);
+		m_render_list.markUnordered();
 		m_detect_lists[p->group].add(p);
+		markSpatialQueryDirty(p->group);
 		m_statistics[m_statistics_index].object_alloc += 1;
 		if (callbacks != nullptr) {
 			p->addCallbacks(callbacks);
@@ -448,19 +747,27 @@ namespace luastg
 		dispatchOnDestroy(object);
 		object->removeAllCallbacks();
 		object->ReleaseResource();
+		object->clearBehavior();
+		detachObject(object);
 		m_statistics[m_statistics_index].object_free += 1;
 		auto const next = m_update_list.remove(object);
-		m_render_list.erase(object);
+		m_render_list.markRemoved();
 		m_detect_lists[object->group].remove(object);
+		markSpatialQueryDirty(object->group);
 	#ifdef USING_MULTI_GAME_WORLD
 		if (m_pCurrentObject == object) {
 			m_pCurrentObject = nullptr;
 		}
 	#endif // USING_MULTI_GAME_WORLD
 		object->status = GameObjectStatus::Free;
-		m_ObjectPool.free(object->id);
+		m_pending_free_ids.push_back(object->id);
 		return next;
 	}
+	void GameObjectPool::flushFreedObjects() noexcept {
+		// 按回收顺序归还，保证之后分配到的 id 与逐个归还时一致
+		m_ObjectPool.free(m_pending_free_ids);
+		m_pending_free_ids.clear();
+	}
 	bool GameObjectPool::queueToFree(GameObject* const object, bool const legacy_kill_mode) {
 		if (object->status != GameObjectStatus::Active) {
 			return false;
@@ -470,6 +777,19 @@ namespace luastg
 		auto const has_callback_legacy_kill = legacy_kill_mode && object->features.has_callback_legacy_kill;
 		return has_callback_destroy || has_callback_legacy_kill;
 	}
+	void GameObjectPool::queueToFreeWithCallbacks(GameObject* const object, std::string_view const reason) {
+		if (!queueToFree(object)) {
+			return;
+		}
+	#ifdef USING_MULTI_GAME_WORLD
+		auto const current_object = m_pCurrentObject;
+		m_pCurrentObject = object;
+	#endif // USING_MULTI_GAME_WORLD
+		object->dispatchOnQueueToDestroy(reason);
+	#ifdef USING_MULTI_GAME_WORLD
+		m_pCurrentObject = current_object;
+	#endif // USING_MULTI_GAME_WORLD
+	}
 
 	void GameObjectPool::DrawCollider()
 	{
@@ -505,6 +825,9 @@ namespace luastg
 	}
 	void GameObjectPool::DrawGroupCollider(int groupId, core::Color4B fillColor)
 	{
+		if (groupId < 0 || static_cast<size_t>(groupId) >= m_group_count) {
+			return;
+		}
 #ifdef USING_MULTI_GAME_WORLD
 		auto const world = GetWorldFlag();
 #endif // USING_MULTI_GAME_WORLD
@@ -1,6 +1,13 @@
 #pragma once
 #include "GameObject/GameObject.hpp"
-#include "core/FixedObjectPool.hpp"
+#include "GameObject/GameObjectAttachment.hpp"
+#include "GameObject/GameObjectBroadPhase.hpp"
+#include "GameObject/GameObjectColliderSnapshot.hpp"
+#include "GameObject/GameObjectRenderList.hpp"
+#include "GameObject/GameObjectSnapshot.hpp"
+#include "GameObject/GameObjectProfiler.hpp"
+#include "core/ChunkedObjectPool.hpp"
+#include <chrono>
 #include <deque>
 #include <list>
 #include <memory_resource>
@@ -8,20 +15,13 @@
 #include <algorithm>
 
 // 对象池信息
-#define LOBJPOOL_SIZE   32768 // 最大对象数 //32768(full) //16384(half)
-#define LOBJPOOL_GROUPN 16    // 碰撞组数
+#define LOBJPOOL_SIZE   32768 // 默认最大对象数，可通过配置文件或 lua 修改
+#define LOBJPOOL_CHUNK_SIZE 1024 // 对象池按块分配内存，每块的对象数
+#define LOBJPOOL_GROUPN 64    // 碰撞组数上限，不超过 64，碰撞矩阵的每一行是一个 64 位掩码
+#define LOBJPOOL_GROUPN_DEFAULT 16 // 默认碰撞组数，可通过 lua 修改
 
 namespace luastg
 {
-	struct GameObjectLayerComparer {
-		bool operator()(GameObject const* const left, GameObject const* const right) const noexcept {
-			if (left->layer != right->layer) {
-				return left->layer < right->layer;
-			}
-			return left->unique_id < right->unique_id;
-		}
-	};
-
 	struct GameObjectUpdateLinkedListFieldAssessor {
 		static GameObject* getPrevious(GameObject const* const object) noexcept {
 			return object->update_list_previous;
@@ -102,6 +102,12 @@ namespace luastg
 			return next;
 		}
 		[[nodiscard]] GameObject* first() const noexcept { return m_first; }
+		[[nodiscard]] GameObject* last() const noexcept { return m_last; }
+		// 直接设置链表的首尾，只用于恢复快照，调用者需要保证对象的链表字段与之一致
+		void assign(GameObject* const first, GameObject* const last) noexcept {
+			m_first = first;
+			m_last = last;
+		}
 		void clear() {
 			GameObject* object = m_first;
 			while (object) {
@@ -160,6 +166,9 @@ namespace luastg
 			uint64_t object_alive{ 0 };
 			uint64_t object_colli_check{ 0 };
 			uint64_t object_colli_callback{ 0 };
+			uint64_t object_capacity{ 0 };
+			uint64_t object_memory{ 0 };
+			uint64_t object_move_time{ 0 }; // 纳秒，ObjFrame(New) 中 frame 回调之后的运动更新耗时，用于比较对象内存布局
 		};
 
 		struct IntersectionDetectionGroupPair {
@@ -168,14 +177,20 @@ namespace luastg
 		};
 
 	private:
-		core::FixedObjectPool<GameObject, LOBJPOOL_SIZE> m_ObjectPool;
+		core::ChunkedObjectPool<GameObject, LOBJPOOL_CHUNK_SIZE> m_ObjectPool;
+		std::vector<size_t> m_pending_free_ids; // 批量回收过程中已经回收、但还没有归还对象池的对象
 		uint64_t m_iUid = 0;
+		uint64_t m_generation = 0; // 每次修改最大容量后增加，之前记录的快照中的对象地址不再有效
+
+		// 把批量回收过程中回收的对象一次性归还对象池
+		void flushFreedObjects() noexcept;
 
 		// GameObject lists
 		std::pmr::unsynchronized_pool_resource m_memory_resource;
 		GameObjectUpdateLinkedList m_update_list;
-		std::pmr::set<GameObject*, GameObjectLayerComparer> m_render_list;
+		GameObjectRenderList m_render_list;
 		std::array<GameObjectDetectLinkedList, LOBJPOOL_GROUPN> m_detect_lists;
+		size_t m_group_count{ LOBJPOOL_GROUPN_DEFAULT };
 		std::pmr::vector<IGameObjectManagerCallbacks*> m_callbacks;
 
 		void resetGameObjectLists();
@@ -205,6 +220,77 @@ namespace luastg
 			GameObject* object2{};
 		};
 
+		struct OutOfWorldBoundDetectionResult {
+			uint64_t uid{};
+			GameObject* game_object{};
+		};
+
+		// 并行出界检测时每个区间的结果，保留内存以便下一帧复用
+		std::vector<std::vector<OutOfWorldBoundDetectionResult>> m_out_of_world_bound_results;
+
+		// 相交检测粗略阶段与碰撞组快照，按碰撞组缓存，保留内存以便下一帧复用
+		std::array<GameObjectSpatialHash, LOBJPOOL_GROUPN> m_spatial_hashes;
+		std::vector<uint32_t> m_spatial_hash_query_result;
+		std::array<GameObjectColliderSnapshot, LOBJPOOL_GROUPN> m_collider_snapshots;
+		std::vector<uint32_t> m_collider_filter_result;
+
+		// 获取碰撞组快照，一次批量检测中每个碰撞组只复制一次
+		GameObjectColliderSnapshot const& prepareColliderSnapshot(uint32_t group, std::array<bool, LOBJPOOL_GROUPN>& prepared);
+
+		// 空间查询索引，按碰撞组在第一次查询时构建，之后的查询复用，直到碰撞组内的对象发生变化
+		struct SpatialQueryIndex {
+			GameObjectColliderSnapshot snapshot;
+			GameObjectSpatialHash spatial_hash;
+		};
+		std::array<SpatialQueryIndex, LOBJPOOL_GROUPN> m_spatial_query_indices;
+		uint64_t m_spatial_query_dirty{ ~uint64_t{ 0 } }; // 第 i 位表示碰撞组 i 的索引需要重建
+		std::vector<uint32_t> m_spatial_query_candidates;
+		std::vector<uint32_t> m_spatial_query_filtered;
+		std::vector<GameObject*> m_spatial_query_result;
+
+		// 获取碰撞组的空间查询索引，必要时重建
+		SpatialQueryIndex const& prepareSpatialQueryIndex(uint32_t group);
+
+		// 查询与指定碰撞体相交的对象，结果按碰撞组链表顺序写入 m_spatial_query_result
+		void querySpatialIndex(uint32_t group, GameObjectCollider const& collider);
+
+		// 碰撞矩阵，第 i 行的第 j 位表示碰撞组 i 与碰撞组 j 进行相交检测
+		std::array<uint64_t, LOBJPOOL_GROUPN> m_collision_matrix{};
+		std::pmr::vector<IntersectionDetectionGroupPair> m_collision_matrix_group_pairs;
+
+		// 运动学批量更新中每个并行区间需要逐个更新的对象，保留内存以便下一帧复用
+		std::vector<std::vector<GameObject*>> m_kinematics_individual_objects;
+
+		// 回调函数耗时统计，默认关闭
+		GameObjectCallbackProfiler m_callback_profiler;
+
+		// 按更新链表顺序触发所有对象的 frame 回调
+		void dispatchOnUpdateAll(int64_t super_pause_time);
+
+		// 累计运动更新耗时
+		void recordMoveTime(std::chrono::steady_clock::time_point start) noexcept;
+
+		// 父子附着，实现位于 GameObjectAttachment.cpp
+		std::vector<GameObject*> m_attached_objects; // 所有附着在其他对象上的子对象，按到根对象的层数排列
+		std::vector<GameObject*> m_orphaned_objects; // 父对象已经被删除的子对象，保留内存以便下一帧复用
+		bool m_attached_objects_unordered{ false };
+
+		// 分配和释放附着状态，不维护附着列表
+		static GameObjectAttachment* createAttachment(GameObjectAttachment const& state);
+		static void destroyAttachment(GameObjectAttachment* attachment) noexcept;
+
+		// 按层数重新排列附着列表，保证父对象先于子对象计算
+		void sortAttachedObjects();
+
+		// 删除父对象已经被删除的子对象，或者只解除附着，会调用 del 回调，只能在更新批量过程中调用
+		void destroyOrphanedAttachments();
+
+		// 根据父对象计算子对象的坐标、旋转和缩放，在运动更新之后调用
+		void resolveAttachments() noexcept;
+
+		// 批量触发相交检测结果的回调
+		void dispatchIntersectionDetectionResults(std::pmr::deque<IntersectionDetectionResult> const& results);
+
 	private:
 
 		// 检查指定对象的坐标是否在场景边界内
@@ -295,6 +381,7 @@ namespace luastg
 		}
 		void DebugNextFrame();
 		FrameStatistics DebugGetFrameStatistics();
+		GameObjectCallbackProfiler& getCallbackProfiler() noexcept { return m_callback_profiler; }
 
 	public:
 #ifdef USING_MULTI_GAME_WORLD
@@ -307,6 +394,37 @@ namespace luastg
 		/// @brief 获取对象
 		GameObject* GetPooledObject(size_t i) noexcept { return m_ObjectPool.object(i); }
 
+		/// @brief 对象池容量的上限，GameObject::max_id 保留为无效索引
+		static constexpr size_t max_capacity{ GameObject::max_id };
+
+		/// @brief 获取已分配内存的槽位数量，对象索引小于该值
+		size_t getSlotCount() const noexcept { return m_ObjectPool.slotCount(); }
+
+		/// @brief 获取对象池最大容量
+		size_t getCapacity() const noexcept { return m_ObjectPool.capacity(); }
+
+		/// @brief 设置对象池最大容量，只能在没有已分配对象、且没有执行批量过程时调用
+		bool setCapacity(size_t capacity) noexcept;
+
+		// 快照：记录和恢复整个对象池的模拟状态，包括对象、链表、回收索引、uid 计数器、超级暂停、碰撞组设置等，实现位于 GameObjectSnapshot.cpp
+		// 只能在没有执行更新、渲染、出界检测、相交检测等批量过程时调用，恢复时不会调用任何回调，lua 侧的数据需要由调用者恢复
+		// 记录之后修改过最大容量的快照无法恢复
+
+		// 记录快照，正在执行批量过程时返回 false
+		bool captureSnapshot(GameObjectPoolSnapshot& snapshot);
+
+		// 恢复快照，快照无效或正在执行批量过程时返回 false
+		bool restoreSnapshot(GameObjectPoolSnapshot const& snapshot);
+
+		// 是否可以记录或恢复快照
+		[[nodiscard]] bool canSnapshot() const noexcept { return m_pending_free_ids.empty() && !m_is_rendering && !m_is_detecting_intersect; }
+
+		/// @brief 获取碰撞组数
+		size_t getGroupCount() const noexcept { return m_group_count; }
+
+		/// @brief 设置碰撞组数，被移除的碰撞组内不能有对象
+		bool setGroupCount(size_t count) noexcept;
+
 		// 对象更新：传统模式
 		// 回调 -> 运动更新 -> 回调 -> 运动更新 -> ...
 		void updateMovementsLegacy();
@@ -315,6 +433,10 @@ namespace luastg
 		// 回调所有 -> 更新所有运动
 		void updateMovements();
 
+		// 对象更新：批量模式，运动更新按对象池槽位顺序批量执行，结果与批量模式一致
+		// 回调所有 -> 按槽位更新所有运动
+		void updateMovementsBatch();
+
 		// 对象更新：传统模式新旧帧衔接
 		void updateNextLegacy();
 
@@ -340,6 +462,13 @@ namespace luastg
 				&& y <= m_BoundTop;
 		}
 
+		inline bool isRectOutOfBound(double const l, double const r, double const b, double const t) const noexcept {
+			return r < m_BoundLeft
+				|| l > m_BoundRight
+				|| t < m_BoundBottom
+				|| b > m_BoundTop;
+		}
+
 		// 脱离世界边界检测：传统模式
 		void detectOutOfWorldBoundLegacy();
 
@@ -354,12 +483,62 @@ namespace luastg
 		// 检测所有 -> 回调所有
 		void detectIntersection(std::pmr::vector<IntersectionDetectionGroupPair> const& group_pairs);
 
+		// 相交检测：批量模式 + 空间哈希粗略阶段
+		// 只对网格重叠的对象进行检测，回调顺序与批量模式一致
+		void detectIntersectionSpatialHash(std::pmr::vector<IntersectionDetectionGroupPair> const& group_pairs);
+
+		// 设置碰撞矩阵，替换原有的所有碰撞组对
+		void setCollisionMatrix(std::pmr::vector<IntersectionDetectionGroupPair> const& group_pairs);
+
+		// 相交检测：按碰撞矩阵执行批量模式
+		// 碰撞组对按行、列从小到大的顺序检测，跳过没有对象的碰撞组
+		void detectIntersectionMatrix(bool spatial_hash);
+
 		/// @brief 更新对象的XY坐标偏移量
 		void UpdateXY() noexcept;
+
+		// 空间查询：只查询参与碰撞且处于活跃状态的对象，查询使用的是索引构建时的碰撞体数据
+		// 索引在对象池的每个更新阶段之后、对象创建和回收以及修改碰撞组后失效，
+		// 通过 lua 对象属性修改坐标和碰撞体也会使索引失效，但通过 FFI 直接写入的修改不会
+
+		// 使所有碰撞组的空间查询索引失效
+		void markSpatialQueryDirty() noexcept { m_spatial_query_dirty = ~uint64_t{ 0 }; }
+
+		// 使指定碰撞组的空间查询索引失效
+		void markSpatialQueryDirty(size_t const group) noexcept { m_spatial_query_dirty |= uint64_t{ 1 } << group; }
+
+		// 查询中心距离 (x, y) 最近且不超过 max_distance 的对象，距离相同时返回链表中靠前的对象，没有时返回 nullptr
+		GameObject* queryNearest(uint32_t group, double x, double y, double max_distance);
+
+		// 查询与圆相交的对象，结果按碰撞组链表顺序排列，在下一次查询前有效
+		std::vector<GameObject*> const& queryCircle(uint32_t group, double x, double y, double r);
+
+		// 查询与轴对齐矩形相交的对象，结果按碰撞组链表顺序排列，在下一次查询前有效
+		std::vector<GameObject*> const& queryRect(uint32_t group, double left, double right, double bottom, double top);
+
+		// 查询与旋转矩形相交的对象，a、b 为半宽和半高，rot 为弧度，结果按碰撞组链表顺序排列，在下一次查询前有效
+		std::vector<GameObject*> const& queryOBB(uint32_t group, double x, double y, double a, double b, double rot);
+
+		// 查询从 (x1, y1) 到 (x2, y2) 的线段最先碰到的对象，half_width 为线段的半宽
+		// 按对象中心在线段方向上的投影排序，投影相同时返回链表中靠前的对象，没有时返回 nullptr
+		GameObject* querySegment(uint32_t group, double x1, double y1, double x2, double y2, double half_width);
 	
 		//重置对象的各项属性，并释放资源，保留uid和id
 		void DirtResetObject(GameObject* p) noexcept;
 
+		// 父子附着：子对象每帧在运动更新之后根据父对象的变换计算坐标、旋转和缩放，然后才进行出界检测和相交检测
+		// 父对象被删除时，子对象会在所在帧的更新阶段（父对象在 frame 回调中删除时）或下一帧的更新阶段被一起删除或解除附着
+
+		// 把 child 附着到 parent 上，已经附着的对象会改为附着到新的父对象
+		// parent 不处于活跃状态、或者 parent 就是 child 或其子孙时返回 false
+		bool attachObject(GameObject* child, GameObject* parent, GameObjectAttachmentTransform const& transform, bool detach_on_parent_free);
+
+		// 解除附着，保留当前的坐标、旋转和缩放
+		void detachObject(GameObject* child) noexcept;
+
+		// 获取父对象，未附着或者父对象已经被回收时返回 nullptr
+		GameObject* getAttachmentParent(GameObject const* child) const noexcept;
+
 		// 修改游戏对象所在的碰撞组：从原碰撞组链表移除，插入到新碰撞组链表，并更新 group 属性
 		void setGroup(GameObject* object, size_t group);
 
@@ -371,8 +550,12 @@ namespace luastg
 
 		[[nodiscard]] GameObject* allocate() { return allocateWithCallbacks(nullptr); }
 		[[nodiscard]] GameObject* allocateWithCallbacks(IGameObjectCallbacks* callbacks);
+		// 回收对象并返回更新链表中的下一个对象，只能在批量回收过程中调用
+		// 对象的槽位在批量回收结束时通过 flushFreedObjects 一次性归还对象池
 		GameObject* freeWithCallbacks(GameObject* object);
 		bool queueToFree(GameObject* object, bool legacy_kill_mode = false);
+		// 由原生代码标记对象为删除状态并调用 del 回调，只能在更新、出界检测、相交检测等会调用对象回调的批量过程中调用
+		void queueToFreeWithCallbacks(GameObject* object, std::string_view reason);
 		[[nodiscard]] bool isLockedByDetectIntersection(GameObject const* const object) const noexcept { return object == m_LockObjectA || object == m_LockObjectB; }
 		[[nodiscard]] bool isRendering() const noexcept { return m_is_rendering; }
 		[[nodiscard]] bool isDetectingIntersect() const noexcept { return m_is_detecting_intersect; }
@@ -433,6 +616,17 @@ namespace luastg
 			if (CheckWorld(a, m_Worlds[3]) && CheckWorld(b, m_Worlds[3])) return true;
 			return false;
 		}
+		// 获取 world mask 所在的预置 world 的位集合，第 i 位对应 m_Worlds[i]
+		// 两个位集合有交集时 CheckWorlds 为 true，相交检测时据此对碰撞组分区，只检测可能在同一个 world 内的对象
+		uint32_t GetWorldsMask(int32_t const world) const noexcept {
+			uint32_t mask{};
+			for (size_t i = 0; i < m_Worlds.size(); i += 1) {
+				if (CheckWorld(world, m_Worlds[i])) {
+					mask |= 1u << i;
+				}
+			}
+			return mask;
+		}
 #endif // USING_MULTI_GAME_WORLD
 
 	private:
@@ -470,7 +664,7 @@ namespace luastg
 		void DrawGroupCollider2(int groupId, core::Color4B fillColor);
 
 	public:
-		GameObjectPool();
+		explicit GameObjectPool(size_t capacity = LOBJPOOL_SIZE);
 		GameObjectPool& operator=(const GameObjectPool&) = delete;
 		GameObjectPool(const GameObjectPool&) = delete;
 		~GameObjectPool();
@@ -0,0 +1,33 @@
+#include "GameObject/GameObjectProfiler.hpp"
+
+using std::string_view_literals::operator ""sv;
+
+namespace luastg {
+	GameObjectCallbackProfiler::Entry& GameObjectCallbackProfiler::acquire(void const* const key, bool& created) {
+		auto const [it, inserted] = m_entries.try_emplace(key);
+		created = inserted;
+		return it->second;
+	}
+
+	void GameObjectCallbackProfiler::record(void const* const key, GameObjectCallbackKind const kind, uint64_t const time) noexcept {
+		if (auto const it = m_entries.find(key); it != m_entries.end()) {
+			it->second.record(kind, time);
+		}
+	}
+
+	std::string_view GameObjectCallbackProfiler::getKindName(GameObjectCallbackKind const kind) noexcept {
+		switch (kind) {
+		case GameObjectCallbackKind::Destroy:
+			return "del"sv;
+		case GameObjectCallbackKind::Update:
+			return "frame"sv;
+		case GameObjectCallbackKind::Render:
+			return "render"sv;
+		case GameObjectCallbackKind::Trigger:
+			return "colli"sv;
+		case GameObjectCallbackKind::Count:
+		default:
+			return "unknown"sv;
+		}
+	}
+}
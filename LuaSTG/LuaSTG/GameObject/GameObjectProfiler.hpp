@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <array>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace luastg {
+	// 游戏对象回调函数类型
+	enum class GameObjectCallbackKind : uint8_t {
+		Destroy = 0,
+		Update = 1,
+		Render = 2,
+		Trigger = 3,
+		Count,
+	};
+
+	// 游戏对象回调函数耗时统计，按对象类分别累计各类回调的调用次数、总耗时和最大耗时
+	// 耗时包含回调内嵌套触发的其他回调
+	class GameObjectCallbackProfiler {
+	public:
+		struct Record {
+			uint64_t count{};
+			uint64_t total_time{}; // 纳秒
+			uint64_t max_time{}; // 纳秒
+		};
+
+		struct Entry {
+			std::string name;
+			std::array<Record, static_cast<size_t>(GameObjectCallbackKind::Count)> records{};
+
+			void record(GameObjectCallbackKind const kind, uint64_t const time) noexcept {
+				auto& r = records[static_cast<size_t>(kind)];
+				r.count += 1;
+				r.total_time += time;
+				if (time > r.max_time) {
+					r.max_time = time;
+				}
+			}
+		};
+
+		[[nodiscard]] bool isEnabled() const noexcept { return m_enabled; }
+		void setEnabled(bool const enabled) noexcept { m_enabled = enabled; }
+
+		// 获取对象类对应的统计数据，不存在时创建，返回的引用在 reset 之前一直有效
+		Entry& acquire(void const* key, bool& created);
+
+		// 累计一次回调的耗时，回调执行期间统计数据可能已被 reset，此时丢弃这次记录
+		void record(void const* key, GameObjectCallbackKind kind, uint64_t time) noexcept;
+
+		// 清空所有统计数据
+		void reset() noexcept { m_entries.clear(); }
+
+		[[nodiscard]] std::unordered_map<void const*, Entry> const& entries() const noexcept { return m_entries; }
+
+		[[nodiscard]] static std::string_view getKindName(GameObjectCallbackKind kind) noexcept;
+
+	private:
+		std::unordered_map<void const*, Entry> m_entries;
+		bool m_enabled{ false };
+	};
+}
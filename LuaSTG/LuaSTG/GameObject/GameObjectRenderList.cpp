@@ -0,0 +1,78 @@
+#include "GameObject/GameObjectRenderList.hpp"
+#include <array>
+#include <bit>
+
+namespace {
+	constexpr size_t radix_bits{ 8 };
+	constexpr size_t radix_size{ 1 << radix_bits };
+	constexpr size_t radix_passes{ 64 / radix_bits };
+}
+
+namespace luastg {
+	void GameObjectRenderList::clear() noexcept {
+		m_objects.clear();
+		m_unordered = false;
+		m_removed = false;
+	}
+
+	void GameObjectRenderList::update(GameObject* const first, std::pmr::memory_resource* const resource) {
+		if (m_unordered) {
+			// 按更新链表顺序（unique_id 升序）收集，再按图层进行稳定排序，结果等价于先比较 layer 再比较 unique_id
+
+			std::pmr::vector<Entry> entries{ resource };
+			std::pmr::vector<Entry> swap_entries{ resource };
+			entries.reserve(m_objects.size());
+			for (auto object = first; object != nullptr; object = object->update_list_next) {
+				entries.push_back(Entry{ .key = toSortKey(object->layer), .object = object });
+			}
+
+			// 一次遍历统计所有位的直方图，图层通常只有少数几种取值，大部分位完全相同，可以跳过
+
+			std::array<std::array<uint32_t, radix_size>, radix_passes> histograms{};
+			for (auto const& entry : entries) {
+				for (size_t pass = 0; pass < radix_passes; pass += 1) {
+					histograms[pass][(entry.key >> (pass * radix_bits)) & (radix_size - 1)] += 1;
+				}
+			}
+
+			swap_entries.resize(entries.size());
+			auto const count = static_cast<uint32_t>(entries.size());
+			for (size_t pass = 0; pass < radix_passes; pass += 1) {
+				auto& histogram = histograms[pass];
+				if (count == 0 || histogram[(entries[0].key >> (pass * radix_bits)) & (radix_size - 1)] == count) {
+					continue;
+				}
+				uint32_t offset{};
+				for (auto& value : histogram) {
+					auto const next = offset + value;
+					value = offset;
+					offset = next;
+				}
+				for (auto const& entry : entries) {
+					auto& cursor = histogram[(entry.key >> (pass * radix_bits)) & (radix_size - 1)];
+					swap_entries[cursor] = entry;
+					cursor += 1;
+				}
+				entries.swap(swap_entries);
+			}
+
+			m_objects.resize(entries.size());
+			for (size_t i = 0; i < entries.size(); i += 1) {
+				m_objects[i] = entries[i].object;
+			}
+		}
+		else if (m_removed) {
+			// 移除已回收的对象，剩余对象的相对顺序不变
+			std::erase_if(m_objects, [](GameObject const* const object) { return object->status == GameObjectStatus::Free; });
+		}
+		m_unordered = false;
+		m_removed = false;
+	}
+
+	uint64_t GameObjectRenderList::toSortKey(double const layer) noexcept {
+		// 将浮点数映射为保序的无符号整数，-0.0 与 0.0 视为相等
+		auto const bits = std::bit_cast<uint64_t>(layer == 0.0 ? 0.0 : layer);
+		constexpr uint64_t sign_bit{ 1ull << 63 };
+		return (bits & sign_bit) ? ~bits : (bits | sign_bit);
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "GameObject/GameObject.hpp"
+#include <vector>
+#include <memory_resource>
+
+namespace luastg {
+	// 渲染列表：按 (layer, unique_id) 升序排列的连续数组
+	// 分配、回收、修改图层时只标记，渲染前统一使用稳定的基数排序重建
+	class GameObjectRenderList {
+	public:
+		// 新增对象或对象图层改变，需要重新排序
+		void markUnordered() noexcept { m_unordered = true; }
+
+		// 对象被回收，只需要移除失效的对象
+		void markRemoved() noexcept { m_removed = true; }
+
+		// 清空所有数据，保留已分配的内存
+		void clear() noexcept;
+
+		// 更新渲染列表，first 为更新链表的第一个对象，更新链表按 unique_id 升序排列
+		// 排序用的临时数据从 resource 上分配，只在本次调用期间使用
+		void update(GameObject* first, std::pmr::memory_resource* resource);
+
+		[[nodiscard]] size_t size() const noexcept { return m_objects.size(); }
+		[[nodiscard]] GameObject* operator[](size_t const index) const noexcept { return m_objects[index]; }
+
+	private:
+		struct Entry {
+			uint64_t key;
+			GameObject* object;
+		};
+
+		[[nodiscard]] static uint64_t toSortKey(double layer) noexcept;
+
+		std::vector<GameObject*> m_objects;
+		bool m_unordered{ false };
+		bool m_removed{ false };
+	};
+}
@@ -0,0 +1,271 @@
+#include "GameObject/GameObjectPool.h"
+#include <cstring>
+
+namespace {
+	[[nodiscard]] bool hasCallbacksArray(luastg::GameObject const* const object) noexcept {
+		// 只有一个回调函数集时直接存储在指针中，参考 GameObject.cpp
+		return object->callbacks != nullptr && object->callbacks_capacity != 0;
+	}
+
+	[[nodiscard]] bool hasParticlePool(luastg::GameObject const* const object) noexcept {
+		return object->res != nullptr && object->res->GetType() == luastg::ResourceType::Particle && object->ps != nullptr;
+	}
+}
+
+namespace luastg {
+	GameObjectPoolSnapshot::GameObjectPoolSnapshot(size_t const capacity) {
+		m_objects.resize(capacity);
+		m_extras.resize(capacity);
+		m_used.reserve(capacity);
+		m_free_indices.reserve(capacity);
+		m_list_ends.resize(1 + LOBJPOOL_GROUPN);
+	}
+
+	GameObjectPoolSnapshot::~GameObjectPoolSnapshot() {
+		clear();
+	}
+
+	void GameObjectPoolSnapshot::clear() noexcept {
+		m_resources.clear();
+		m_resource_set.clear();
+		m_last_resource = nullptr;
+		for (auto const program : m_programs) {
+			program->release();
+		}
+		m_programs.clear();
+		m_callbacks.clear();
+		m_behaviors.clear();
+		m_attachments.clear();
+		m_particles.clear();
+		m_object_count = 0;
+		m_changed_count = 0;
+		m_valid = false;
+	}
+
+	size_t GameObjectPoolSnapshot::memoryUsage() const noexcept {
+		return m_objects.capacity() * sizeof(GameObject)
+			+ m_extras.capacity() * sizeof(Extra)
+			+ m_used.capacity() * sizeof(uint8_t)
+			+ m_free_indices.capacity() * sizeof(size_t)
+			+ m_callbacks.capacity() * sizeof(IGameObjectCallbacks*)
+			+ m_behaviors.capacity() * sizeof(GameObjectBehavior)
+			+ m_attachments.capacity() * sizeof(GameObjectAttachment)
+			+ m_particles.capacity() * sizeof(ParticleState);
+	}
+
+	void GameObjectPoolSnapshot::retainResource(IResourceBase* const resource) {
+		// 相邻的对象通常使用相同的资源
+		if (resource == m_last_resource) {
+			return;
+		}
+		m_last_resource = resource;
+		if (m_resource_set.insert(resource).second) {
+			m_resources.emplace_back(resource);
+		}
+	}
+
+	bool GameObjectPool::captureSnapshot(GameObjectPoolSnapshot& snapshot) {
+		if (!canSnapshot()) {
+			return false;
+		}
+		tracy_zone_scoped_with_name("LOBJMGR.Snapshot.Capture");
+
+		// 同一个对象池的上一次记录可以用于比较，只复制发生变化的对象
+		auto const comparable = snapshot.m_valid && snapshot.m_pool_generation == m_generation;
+		auto const previous_slot_count = comparable ? snapshot.m_used.size() : 0;
+		snapshot.clear();
+
+		auto const slot_count = m_ObjectPool.slotCount();
+		if (snapshot.m_objects.size() < slot_count) {
+			snapshot.m_objects.resize(slot_count);
+			snapshot.m_extras.resize(slot_count);
+		}
+		snapshot.m_used.resize(slot_count);
+		for (size_t slot = 0; slot < slot_count; slot += 1) {
+			auto const object = m_ObjectPool.object(slot);
+			auto const previous_used = slot < previous_slot_count && snapshot.m_used[slot] != 0;
+			if (object == nullptr) {
+				snapshot.m_used[slot] = 0;
+				continue;
+			}
+			snapshot.m_used[slot] = 1;
+			snapshot.m_object_count += 1;
+
+			auto& record = snapshot.m_objects[slot];
+			if (!previous_used || std::memcmp(static_cast<void const*>(&record), static_cast<void const*>(object), sizeof(GameObject)) != 0) {
+				std::memcpy(static_cast<void*>(&record), static_cast<void const*>(object), sizeof(GameObject));
+				snapshot.m_changed_count += 1;
+			}
+
+			// 对象引用的堆上数据每次都重新记录
+
+			auto& extra = snapshot.m_extras[slot];
+			extra = {};
+			if (hasCallbacksArray(object)) {
+				extra.callbacks = static_cast<uint32_t>(snapshot.m_callbacks.size());
+				snapshot.m_callbacks.insert(snapshot.m_callbacks.end(), object->callbacks, object->callbacks + object->callbacks_count);
+			}
+			if (object->res != nullptr) {
+				snapshot.retainResource(object->res);
+			}
+			if (hasParticlePool(object)) {
+				extra.particle = static_cast<uint32_t>(snapshot.m_particles.size());
+				auto const ps = object->ps;
+				snapshot.m_particles.push_back(GameObjectPoolSnapshot::ParticleState{
+					.center = ps->GetCenter(),
+					.rotation = ps->GetRotation(),
+					.seed = ps->GetSeed(),
+					.emission = ps->GetEmission(),
+					.vertex_color = ps->GetVertexColor(),
+					.blend_mode = ps->GetBlendMode(),
+					.active = ps->IsActived(),
+				});
+			}
+			if (object->behavior != nullptr) {
+				extra.behavior = static_cast<uint32_t>(snapshot.m_behaviors.size());
+				snapshot.m_behaviors.push_back(*object->behavior);
+				object->behavior->program->retain();
+				snapshot.m_programs.push_back(object->behavior->program);
+			}
+			if (object->attachment != nullptr) {
+				extra.attachment = static_cast<uint32_t>(snapshot.m_attachments.size());
+				snapshot.m_attachments.push_back(*object->attachment);
+			}
+		}
+
+		auto const free_indices = m_ObjectPool.freeIndices();
+		snapshot.m_free_indices.assign(free_indices.begin(), free_indices.end());
+		snapshot.m_pool_generation = m_generation;
+		snapshot.m_chunk_count = m_ObjectPool.chunkCount();
+		snapshot.m_uid = m_iUid;
+		snapshot.m_superpause = m_superpause;
+		snapshot.m_nextsuperpause = m_nextsuperpause;
+		snapshot.m_bound = { m_BoundLeft, m_BoundRight, m_BoundBottom, m_BoundTop };
+		snapshot.m_group_count = m_group_count;
+		snapshot.m_collision_matrix = m_collision_matrix;
+	#ifdef USING_MULTI_GAME_WORLD
+		snapshot.m_world = m_iWorld;
+		snapshot.m_worlds = m_Worlds;
+	#endif // USING_MULTI_GAME_WORLD
+		snapshot.m_list_ends[0] = { m_update_list.first(), m_update_list.last() };
+		for (size_t group = 0; group < LOBJPOOL_GROUPN; group += 1) {
+			snapshot.m_list_ends[1 + group] = { m_detect_lists[group].first(), m_detect_lists[group].last() };
+		}
+		snapshot.m_valid = true;
+		return true;
+	}
+
+	bool GameObjectPool::restoreSnapshot(GameObjectPoolSnapshot const& snapshot) {
+		if (!canSnapshot() || !snapshot.m_valid || snapshot.m_pool_generation != m_generation) {
+			return false;
+		}
+		assert(snapshot.m_chunk_count <= m_ObjectPool.chunkCount());
+		tracy_zone_scoped_with_name("LOBJMGR.Snapshot.Restore");
+
+		auto const snapshot_slot_count = snapshot.m_used.size();
+		auto const isSameObject = [&](size_t const slot, GameObject const* const object) {
+			return slot < snapshot_slot_count
+				&& snapshot.m_used[slot] != 0
+				&& snapshot.m_objects[slot].unique_id == object->unique_id
+				&& snapshot.m_objects[slot].res == object->res;
+		};
+
+		// 释放当前对象持有的堆上数据，快照中的同一个对象继续使用原来的资源引用和粒子池
+
+		m_attached_objects.clear();
+		for (size_t slot = 0; slot < m_ObjectPool.slotCount(); slot += 1) {
+			auto const object = m_ObjectPool.object(slot);
+			if (object == nullptr) {
+				continue;
+			}
+			object->removeAllCallbacks();
+			object->clearBehavior();
+			if (object->attachment != nullptr) {
+				destroyAttachment(object->attachment);
+				object->attachment = nullptr;
+			}
+			if (!isSameObject(slot, object)) {
+				object->ReleaseResource();
+				object->status = GameObjectStatus::Free;
+			}
+		}
+		m_ObjectPool.restore(snapshot.m_chunk_count, snapshot.m_used, snapshot.m_free_indices);
+
+		// 复制对象，然后重新创建堆上数据
+
+		for (size_t slot = 0; slot < snapshot_slot_count; slot += 1) {
+			if (snapshot.m_used[slot] == 0) {
+				continue;
+			}
+			auto const object = m_ObjectPool.slot(slot);
+			auto const& record = snapshot.m_objects[slot];
+			auto const& extra = snapshot.m_extras[slot];
+			auto const kept = object->status != GameObjectStatus::Free && isSameObject(slot, object);
+			auto ps = kept ? object->ps : nullptr;
+			std::memcpy(static_cast<void*>(object), static_cast<void const*>(&record), sizeof(GameObject));
+			if (extra.callbacks != GameObjectPoolSnapshot::invalid_index) {
+				object->callbacks = static_cast<IGameObjectCallbacks**>(GameObject::s_callbacks_resource.allocate(sizeof(IGameObjectCallbacks*) * object->callbacks_capacity));
+				std::memset(static_cast<void*>(object->callbacks), 0, sizeof(IGameObjectCallbacks*) * object->callbacks_capacity);
+				std::memcpy(static_cast<void*>(object->callbacks), static_cast<void const*>(snapshot.m_callbacks.data() + extra.callbacks), sizeof(IGameObjectCallbacks*) * object->callbacks_count);
+			}
+			if (object->res != nullptr && !kept) {
+				object->res->retain();
+			}
+			object->ps = nullptr;
+			if (extra.particle != GameObjectPoolSnapshot::invalid_index) {
+				auto const& state = snapshot.m_particles[extra.particle];
+				if (ps == nullptr) {
+					// 重新创建的粒子池使用记录时的随机数种子
+					if (static_cast<IResourceParticle*>(object->res)->CreateInstance(&ps)) {
+						ps->SetSeed(state.seed);
+					}
+				}
+				if (ps != nullptr) {
+					ps->SetActive(false);
+					ps->SetCenter(state.center);
+					ps->SetRotation(state.rotation);
+					ps->SetEmission(state.emission);
+					ps->SetVertexColor(state.vertex_color);
+					ps->SetBlendMode(state.blend_mode);
+					ps->SetActive(state.active);
+				}
+				object->ps = ps;
+			}
+			object->behavior = nullptr;
+			if (extra.behavior != GameObjectPoolSnapshot::invalid_index) {
+				object->restoreBehavior(snapshot.m_behaviors[extra.behavior]);
+			}
+			object->attachment = nullptr;
+			if (extra.attachment != GameObjectPoolSnapshot::invalid_index) {
+				object->attachment = createAttachment(snapshot.m_attachments[extra.attachment]);
+				object->attachment->index = static_cast<uint32_t>(m_attached_objects.size());
+				m_attached_objects.push_back(object);
+			}
+		}
+
+		m_iUid = snapshot.m_uid;
+		m_superpause = snapshot.m_superpause;
+		m_nextsuperpause = snapshot.m_nextsuperpause;
+		m_BoundLeft = snapshot.m_bound[0];
+		m_BoundRight = snapshot.m_bound[1];
+		m_BoundBottom = snapshot.m_bound[2];
+		m_BoundTop = snapshot.m_bound[3];
+		m_group_count = snapshot.m_group_count;
+		m_collision_matrix = snapshot.m_collision_matrix;
+	#ifdef USING_MULTI_GAME_WORLD
+		m_iWorld = snapshot.m_world;
+		m_Worlds = snapshot.m_worlds;
+		m_pCurrentObject = nullptr;
+	#endif // USING_MULTI_GAME_WORLD
+		m_LockObjectA = nullptr;
+		m_LockObjectB = nullptr;
+		m_update_list.assign(snapshot.m_list_ends[0][0], snapshot.m_list_ends[0][1]);
+		for (size_t group = 0; group < LOBJPOOL_GROUPN; group += 1) {
+			m_detect_lists[group].assign(snapshot.m_list_ends[1 + group][0], snapshot.m_list_ends[1 + group][1]);
+		}
+		m_attached_objects_unordered = true;
+		m_render_list.markUnordered();
+		markSpatialQueryDirty();
+		return true;
+	}
+}
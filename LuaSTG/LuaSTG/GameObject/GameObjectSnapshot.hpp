@@ -0,0 +1,104 @@
+#pragma once
+#include "GameObject/GameObject.hpp"
+#include "GameObject/GameObjectAttachment.hpp"
+#include "GameObject/GameObjectBehavior.hpp"
+#include "core/SmartReference.hpp"
+#include <array>
+#include <unordered_set>
+#include <vector>
+
+namespace luastg {
+	// 对象池快照：记录整个对象池的模拟状态，用于回滚和回放跳转
+	// 对象按槽位存储，再次记录到同一个快照时只复制发生变化的对象，通常循环使用若干个快照
+	// 只能在对象池没有执行批量过程时记录和恢复，详见 GameObjectPool::captureSnapshot
+	class GameObjectPoolSnapshot {
+	public:
+		// 预分配可以容纳 capacity 个对象的空间
+		explicit GameObjectPoolSnapshot(size_t capacity);
+		GameObjectPoolSnapshot(GameObjectPoolSnapshot const&) = delete;
+		GameObjectPoolSnapshot& operator=(GameObjectPoolSnapshot const&) = delete;
+		~GameObjectPoolSnapshot();
+
+		// 释放快照持有的资源和行为程序的引用，快照变为无效
+		void clear() noexcept;
+
+		[[nodiscard]] bool valid() const noexcept { return m_valid; }
+
+		// 快照中的对象数量
+		[[nodiscard]] size_t size() const noexcept { return m_object_count; }
+
+		// 记录时对象池已分配内存的槽位数量
+		[[nodiscard]] size_t slotCount() const noexcept { return m_used.size(); }
+
+		// 记录时槽位是否已被分配
+		[[nodiscard]] bool used(size_t const slot) const noexcept { return slot < m_used.size() && m_used[slot] != 0; }
+
+		// 上一次记录时与之前的快照内容不同、需要复制的对象数量
+		[[nodiscard]] size_t changedCount() const noexcept { return m_changed_count; }
+
+		[[nodiscard]] size_t memoryUsage() const noexcept;
+
+	private:
+		friend class GameObjectPool;
+
+		// 粒子池的发射器状态，已经发射的粒子不属于模拟状态，不做记录
+		struct ParticleState {
+			core::Vector2F center;
+			float rotation;
+			uint32_t seed;
+			int emission;
+			core::Color4B vertex_color;
+			BlendMode blend_mode;
+			bool active;
+		};
+
+		// 对象引用的堆上数据在 m_objects 中的位置，没有时为 invalid_index
+		struct Extra {
+			uint32_t callbacks{ invalid_index };
+			uint32_t behavior{ invalid_index };
+			uint32_t attachment{ invalid_index };
+			uint32_t particle{ invalid_index };
+		};
+
+		static constexpr uint32_t invalid_index{ ~uint32_t{ 0 } };
+
+		// 记录对象引用的渲染资源，同一个资源只增加一次引用计数
+		void retainResource(IResourceBase* resource);
+
+		// 对象池
+		uint64_t m_pool_generation{};
+		size_t m_chunk_count{};
+		std::vector<uint8_t> m_used;
+		std::vector<size_t> m_free_indices;
+		uint64_t m_uid{};
+		int64_t m_superpause{};
+		int64_t m_nextsuperpause{};
+		std::array<double, 4> m_bound{};
+		size_t m_group_count{};
+		std::array<uint64_t, 64> m_collision_matrix{};
+	#ifdef USING_MULTI_GAME_WORLD
+		int32_t m_world{};
+		std::array<int32_t, 4> m_worlds{};
+	#endif // USING_MULTI_GAME_WORLD
+		// 链表，[0] 为更新链表，[1 + i] 为碰撞组 i 的链表
+		std::vector<std::array<GameObject*, 2>> m_list_ends;
+
+		// 对象，按槽位存储，未使用的槽位内容无意义
+		std::vector<GameObject> m_objects;
+		std::vector<Extra> m_extras;
+		std::vector<IGameObjectCallbacks*> m_callbacks;
+		std::vector<GameObjectBehavior> m_behaviors;
+		std::vector<GameObjectAttachment> m_attachments;
+		std::vector<ParticleState> m_particles;
+
+		// 快照持有的引用
+		std::vector<core::SmartReference<IResourceBase>> m_resources;
+		std::unordered_set<IResourceBase*> m_resource_set;
+		IResourceBase* m_last_resource{};
+		std::vector<GameObjectBehaviorProgram*> m_programs;
+
+		size_t m_object_count{};
+		size_t m_changed_count{};
+		bool m_valid{ false };
+	};
+}
@@ -0,0 +1,157 @@
+#include "GameObject/GameObjectPool.h"
+
+namespace {
+	// 最近对象查询从这个半径开始，每次扩大一倍
+	constexpr double nearest_query_initial_radius{ 64.0 };
+
+	luastg::GameObjectCollider makeCircleCollider(double const x, double const y, double const r) noexcept {
+		return luastg::GameObjectCollider{
+			.x = x,
+			.y = y,
+			.col_r = r,
+			.a = static_cast<float>(r),
+			.b = static_cast<float>(r),
+			.rot = 0.0f,
+			.type = luastg::GameObjectColliderType::Circle,
+		};
+	}
+
+	luastg::GameObjectCollider makeOBBCollider(double const x, double const y, double const a, double const b, double const rot) noexcept {
+		// 外接圆半径与 GameObject::UpdateCollisionCircleRadius 一致
+		return luastg::GameObjectCollider{
+			.x = x,
+			.y = y,
+			.col_r = std::hypot(a, b),
+			.a = static_cast<float>(a),
+			.b = static_cast<float>(b),
+			.rot = static_cast<float>(rot),
+			.type = luastg::GameObjectColliderType::OBB,
+		};
+	}
+
+	bool isQueryable(luastg::GameObject const* const object) noexcept {
+		return object->status == luastg::GameObjectStatus::Active;
+	}
+}
+
+namespace luastg {
+	GameObjectPool::SpatialQueryIndex const& GameObjectPool::prepareSpatialQueryIndex(uint32_t const group) {
+		assert(group < LOBJPOOL_GROUPN);
+		auto& index = m_spatial_query_indices[group];
+		auto const bit = uint64_t{ 1 } << group;
+		if (m_spatial_query_dirty & bit) {
+			tracy_zone_scoped_with_name("LOBJMGR.SpatialQuery.Build");
+			index.snapshot.clear();
+			index.spatial_hash.clear();
+			for (auto object = m_detect_lists[group].first(); object != nullptr; object = object->detect_list_next) {
+				index.snapshot.add(object);
+				index.spatial_hash.add(object);
+			}
+			index.snapshot.build();
+			index.spatial_hash.build();
+			m_spatial_query_dirty &= ~bit;
+		}
+		assert(index.snapshot.size() == index.spatial_hash.size());
+		return index;
+	}
+
+	void GameObjectPool::querySpatialIndex(uint32_t const group, GameObjectCollider const& collider) {
+		m_spatial_query_result.clear();
+		auto const& [snapshot, spatial_hash] = prepareSpatialQueryIndex(group);
+		if (snapshot.empty()) {
+			return;
+		}
+		spatial_hash.query(collider.x, collider.y, collider.col_r, m_spatial_query_candidates);
+		snapshot.filter(GameObjectColliderSnapshot::makeBounds(collider), m_spatial_query_candidates, m_spatial_query_filtered);
+		for (auto const index : m_spatial_query_filtered) {
+			auto const object = snapshot.object(index);
+			if (!isQueryable(object)) {
+				continue;
+			}
+			if (GameObject::isIntersect(collider, snapshot.collider(index))) {
+				m_spatial_query_result.push_back(object);
+			}
+		}
+	}
+
+	GameObject* GameObjectPool::queryNearest(uint32_t const group, double const x, double const y, double const max_distance) {
+		tracy_zone_scoped_with_name("LOBJMGR.SpatialQuery.Nearest");
+		auto const& [snapshot, spatial_hash] = prepareSpatialQueryIndex(group);
+		if (snapshot.empty() || !(max_distance >= 0.0)) {
+			return nullptr;
+		}
+		// 中心在查询半径内的对象一定在候选列表中，只要在某个半径内找到了对象，它就是距离最近的对象
+		auto radius = std::min(nearest_query_initial_radius, max_distance);
+		while (true) {
+			spatial_hash.query(x, y, radius, m_spatial_query_candidates);
+			auto const exhausted = m_spatial_query_candidates.size() == snapshot.size() || radius >= max_distance;
+			auto const limit = exhausted ? max_distance : radius;
+			GameObject* nearest{};
+			double nearest_distance_squared{};
+			for (auto const index : m_spatial_query_candidates) {
+				auto const object = snapshot.object(index);
+				if (!isQueryable(object)) {
+					continue;
+				}
+				auto const& collider = snapshot.collider(index);
+				auto const dx = collider.x - x;
+				auto const dy = collider.y - y;
+				auto const distance_squared = dx * dx + dy * dy;
+				if (!(distance_squared <= limit * limit)) {
+					continue;
+				}
+				// 候选列表按链表顺序排列，距离相同时保留靠前的对象
+				if (nearest == nullptr || distance_squared < nearest_distance_squared) {
+					nearest = object;
+					nearest_distance_squared = distance_squared;
+				}
+			}
+			if (nearest != nullptr || exhausted) {
+				return nearest;
+			}
+			radius = std::min(radius * 2.0, max_distance);
+		}
+	}
+
+	std::vector<GameObject*> const& GameObjectPool::queryCircle(uint32_t const group, double const x, double const y, double const r) {
+		tracy_zone_scoped_with_name("LOBJMGR.SpatialQuery.Circle");
+		querySpatialIndex(group, makeCircleCollider(x, y, r));
+		return m_spatial_query_result;
+	}
+
+	std::vector<GameObject*> const& GameObjectPool::queryRect(uint32_t const group, double const left, double const right, double const bottom, double const top) {
+		tracy_zone_scoped_with_name("LOBJMGR.SpatialQuery.Rect");
+		querySpatialIndex(group, makeOBBCollider((left + right) * 0.5, (bottom + top) * 0.5, (right - left) * 0.5, (top - bottom) * 0.5, 0.0));
+		return m_spatial_query_result;
+	}
+
+	std::vector<GameObject*> const& GameObjectPool::queryOBB(uint32_t const group, double const x, double const y, double const a, double const b, double const rot) {
+		tracy_zone_scoped_with_name("LOBJMGR.SpatialQuery.OBB");
+		querySpatialIndex(group, makeOBBCollider(x, y, a, b, rot));
+		return m_spatial_query_result;
+	}
+
+	GameObject* GameObjectPool::querySegment(uint32_t const group, double const x1, double const y1, double const x2, double const y2, double const half_width) {
+		tracy_zone_scoped_with_name("LOBJMGR.SpatialQuery.Segment");
+		auto const dx = x2 - x1;
+		auto const dy = y2 - y1;
+		auto const length = std::hypot(dx, dy);
+		if (length > 0.0) {
+			querySpatialIndex(group, makeOBBCollider((x1 + x2) * 0.5, (y1 + y2) * 0.5, length * 0.5, half_width, std::atan2(dy, dx)));
+		}
+		else {
+			querySpatialIndex(group, makeCircleCollider(x1, y1, half_width));
+		}
+		GameObject* first{};
+		double first_projection{};
+		for (auto const object : m_spatial_query_result) {
+			// 结果按链表顺序排列，投影相同时保留靠前的对象
+			auto const projection = (object->x - x1) * dx + (object->y - y1) * dy;
+			if (first == nullptr || projection < first_projection) {
+				first = object;
+				first_projection = projection;
+			}
+		}
+		return first;
+	}
+}
@@ -0,0 +1,368 @@
+#include "GameResource/Implement/ResourceParticleImpl.hpp"
+#include "Utility/CpuFeature.hpp"
+#include <mutex>
+
+// 注意：所有实现都必须与 HGE 逐个更新粒子的写法保持相同的运算顺序，不能使用融合乘加，
+// 这样才能保证不同实现、不同指令集下的结果逐位相同
+
+namespace {
+	using luastg::hgeParticleBuffer;
+
+	// 存储空间分级，每一级都是 SIMD 宽度的整数倍，每次增长容量翻倍
+	constexpr std::array<size_t, 5> s_size_classes{ 32, 64, 128, 256, hgeParticleBuffer::max_capacity };
+
+	// 每个粒子的字段数量：位置、速度各 2，重力、加速度 3，自旋、大小各 2，颜色及其增量 8，寿命 2
+	constexpr size_t s_field_count = 21;
+
+	constexpr size_t s_storage_alignment = 32;
+
+	size_t getSizeClassBytes(size_t const size_class) noexcept {
+		return s_size_classes[size_class] * s_field_count * sizeof(float);
+	}
+
+	size_t findSizeClass(size_t const capacity) noexcept {
+		for (size_t i = 0; i < s_size_classes.size(); i += 1) {
+			if (s_size_classes[i] >= capacity) {
+				return i;
+			}
+		}
+		return s_size_classes.size();
+	}
+
+	// 空闲的存储空间直接在头部保存下一个空闲存储空间的指针
+	struct FreeStorage {
+		FreeStorage* next;
+	};
+
+	// 粒子池在工作线程上并行更新时也会分配存储空间，需要加锁
+	std::mutex s_storage_mutex;
+
+	// 注意：这些全局变量都没有析构函数，程序退出时仍然存活的粒子池可以安全地归还存储空间
+	std::array<FreeStorage*, s_size_classes.size()> s_free_lists{};
+	hgeParticleBuffer::Statistics s_statistics{};
+
+	float* allocateStorage(size_t const size_class) noexcept {
+		auto const bytes = getSizeClassBytes(size_class);
+		float* storage{};
+		std::unique_lock lock(s_storage_mutex);
+		if (auto const free_storage = s_free_lists[size_class]; free_storage != nullptr) {
+			s_free_lists[size_class] = free_storage->next;
+			s_statistics.cached_bytes -= bytes;
+			storage = reinterpret_cast<float*>(free_storage);
+		}
+		else {
+			lock.unlock();
+			storage = static_cast<float*>(::operator new(bytes, std::align_val_t{ s_storage_alignment }, std::nothrow));
+			if (storage == nullptr) {
+				return nullptr;
+			}
+			lock.lock();
+		}
+		s_statistics.buffer_count += 1;
+		s_statistics.used_bytes += bytes;
+		s_statistics.peak_used_bytes = (std::max)(s_statistics.peak_used_bytes, s_statistics.used_bytes);
+		lock.unlock();
+		// 补齐部分也会参与 SIMD 运算，清零以免出现非规格化数等拖慢运算的值
+		std::memset(storage, 0, bytes);
+		return storage;
+	}
+
+	void deallocateStorage(float* const storage, size_t const size_class) noexcept {
+		auto const bytes = getSizeClassBytes(size_class);
+		auto const free_storage = reinterpret_cast<FreeStorage*>(storage);
+		std::lock_guard lock(s_storage_mutex);
+		free_storage->next = s_free_lists[size_class];
+		s_free_lists[size_class] = free_storage;
+		s_statistics.buffer_count -= 1;
+		s_statistics.used_bytes -= bytes;
+		s_statistics.cached_bytes += bytes;
+	}
+
+#ifndef LUASTG_CPU_X86
+	void updateScalar(hgeParticleBuffer& b, size_t const count, float const delta, core::Vector2F const center, hgeParticleBuffer::mask_t& dead_mask) noexcept {
+		for (size_t i = 0; i < count; i += 1) {
+			b.fAge[i] += delta;
+			if (b.fAge[i] >= b.fTerminalAge[i]) {
+				dead_mask[i / 64] |= uint64_t(1) << (i % 64);
+			}
+
+			// 计算线加速度和切向加速度
+			core::Vector2F vecAccel = (core::Vector2F(b.fLocationX[i], b.fLocationY[i]) - center).normalized();
+			core::Vector2F vecAccel2 = vecAccel;
+			vecAccel *= b.fRadialAccel[i];
+			std::swap(vecAccel2.x, vecAccel2.y);
+			vecAccel2.x = -vecAccel2.x;
+			vecAccel2 *= b.fTangentialAccel[i];
+
+			// 计算速度
+			core::Vector2F const vecAccelDelta = (vecAccel + vecAccel2) * delta;
+			b.fVelocityX[i] += vecAccelDelta.x;
+			b.fVelocityY[i] += vecAccelDelta.y;
+			b.fVelocityY[i] += b.fGravity[i] * delta;
+
+			// 计算位置
+			b.fLocationX[i] += b.fVelocityX[i] * delta;
+			b.fLocationY[i] += b.fVelocityY[i] * delta;
+
+			// 计算自旋和大小
+			b.fSpin[i] += b.fSpinDelta[i] * delta;
+			b.fSize[i] += b.fSizeDelta[i] * delta;
+			for (size_t c = 0; c < 4; c += 1) {
+				b.colColor[c][i] += b.colColorDelta[c][i] * delta;
+			}
+		}
+	}
+#else
+	// 所有字段都补齐到了 SIMD 宽度，超出 count 的部分可以直接读写，结果会被掩码排除
+
+	// value += value_delta * delta
+	inline void integrateSSE(float* const value, float const* const value_delta, __m128 const d) noexcept {
+		_mm_storeu_ps(value, _mm_add_ps(_mm_loadu_ps(value), _mm_mul_ps(_mm_loadu_ps(value_delta), d)));
+	}
+
+	LUASTG_TARGET_AVX inline void integrateAVX(float* const value, float const* const value_delta, __m256 const d) noexcept {
+		_mm256_storeu_ps(value, _mm256_add_ps(_mm256_loadu_ps(value), _mm256_mul_ps(_mm256_loadu_ps(value_delta), d)));
+	}
+
+	void updateSSE(hgeParticleBuffer& b, size_t const count, float const delta, core::Vector2F const center, hgeParticleBuffer::mask_t& dead_mask) noexcept {
+		auto const d = _mm_set1_ps(delta);
+		auto const cx = _mm_set1_ps(center.x);
+		auto const cy = _mm_set1_ps(center.y);
+		auto const min_length = _mm_set1_ps(std::numeric_limits<float>::min());
+		auto const sign_mask = _mm_set1_ps(-0.0f);
+		for (size_t i = 0; i < count; i += 4) {
+			auto const age = _mm_add_ps(_mm_loadu_ps(b.fAge + i), d);
+			_mm_storeu_ps(b.fAge + i, age);
+			auto const dead = static_cast<uint64_t>(_mm_movemask_ps(_mm_cmpge_ps(age, _mm_loadu_ps(b.fTerminalAge + i))));
+			dead_mask[i / 64] |= dead << (i % 64);
+
+			// 计算线加速度和切向加速度
+			auto const x = _mm_loadu_ps(b.fLocationX + i);
+			auto const y = _mm_loadu_ps(b.fLocationY + i);
+			auto const dx = _mm_sub_ps(x, cx);
+			auto const dy = _mm_sub_ps(y, cy);
+			auto const l = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+			auto const valid = _mm_cmpge_ps(l, min_length);
+			auto const nx = _mm_and_ps(valid, _mm_div_ps(dx, l));
+			auto const ny = _mm_and_ps(valid, _mm_div_ps(dy, l));
+			auto const ra = _mm_loadu_ps(b.fRadialAccel + i);
+			auto const ta = _mm_loadu_ps(b.fTangentialAccel + i);
+			auto const ax = _mm_add_ps(_mm_mul_ps(nx, ra), _mm_mul_ps(_mm_xor_ps(ny, sign_mask), ta));
+			auto const ay = _mm_add_ps(_mm_mul_ps(ny, ra), _mm_mul_ps(nx, ta));
+
+			// 计算速度
+			auto vx = _mm_add_ps(_mm_loadu_ps(b.fVelocityX + i), _mm_mul_ps(ax, d));
+			auto vy = _mm_add_ps(_mm_loadu_ps(b.fVelocityY + i), _mm_mul_ps(ay, d));
+			vy = _mm_add_ps(vy, _mm_mul_ps(_mm_loadu_ps(b.fGravity + i), d));
+			_mm_storeu_ps(b.fVelocityX + i, vx);
+			_mm_storeu_ps(b.fVelocityY + i, vy);
+
+			// 计算位置
+			_mm_storeu_ps(b.fLocationX + i, _mm_add_ps(x, _mm_mul_ps(vx, d)));
+			_mm_storeu_ps(b.fLocationY + i, _mm_add_ps(y, _mm_mul_ps(vy, d)));
+
+			// 计算自旋、大小和颜色
+			integrateSSE(b.fSpin + i, b.fSpinDelta + i, d);
+			integrateSSE(b.fSize + i, b.fSizeDelta + i, d);
+			for (size_t c = 0; c < 4; c += 1) {
+				integrateSSE(b.colColor[c] + i, b.colColorDelta[c] + i, d);
+			}
+		}
+	}
+
+	LUASTG_TARGET_AVX void updateAVX(hgeParticleBuffer& b, size_t const count, float const delta, core::Vector2F const center, hgeParticleBuffer::mask_t& dead_mask) noexcept {
+		auto const d = _mm256_set1_ps(delta);
+		auto const cx = _mm256_set1_ps(center.x);
+		auto const cy = _mm256_set1_ps(center.y);
+		auto const min_length = _mm256_set1_ps(std::numeric_limits<float>::min());
+		auto const sign_mask = _mm256_set1_ps(-0.0f);
+		for (size_t i = 0; i < count; i += 8) {
+			auto const age = _mm256_add_ps(_mm256_loadu_ps(b.fAge + i), d);
+			_mm256_storeu_ps(b.fAge + i, age);
+			auto const dead = static_cast<uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(age, _mm256_loadu_ps(b.fTerminalAge + i), _CMP_GE_OQ)));
+			dead_mask[i / 64] |= dead << (i % 64);
+
+			// 计算线加速度和切向加速度
+			auto const x = _mm256_loadu_ps(b.fLocationX + i);
+			auto const y = _mm256_loadu_ps(b.fLocationY + i);
+			auto const dx = _mm256_sub_ps(x, cx);
+			auto const dy = _mm256_sub_ps(y, cy);
+			auto const l = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+			auto const valid = _mm256_cmp_ps(l, min_length, _CMP_GE_OQ);
+			auto const nx = _mm256_and_ps(valid, _mm256_div_ps(dx, l));
+			auto const ny = _mm256_and_ps(valid, _mm256_div_ps(dy, l));
+			auto const ra = _mm256_loadu_ps(b.fRadialAccel + i);
+			auto const ta = _mm256_loadu_ps(b.fTangentialAccel + i);
+			auto const ax = _mm256_add_ps(_mm256_mul_ps(nx, ra), _mm256_mul_ps(_mm256_xor_ps(ny, sign_mask), ta));
+			auto const ay = _mm256_add_ps(_mm256_mul_ps(ny, ra), _mm256_mul_ps(nx, ta));
+
+			// 计算速度
+			auto vx = _mm256_add_ps(_mm256_loadu_ps(b.fVelocityX + i), _mm256_mul_ps(ax, d));
+			auto vy = _mm256_add_ps(_mm256_loadu_ps(b.fVelocityY + i), _mm256_mul_ps(ay, d));
+			vy = _mm256_add_ps(vy, _mm256_mul_ps(_mm256_loadu_ps(b.fGravity + i), d));
+			_mm256_storeu_ps(b.fVelocityX + i, vx);
+			_mm256_storeu_ps(b.fVelocityY + i, vy);
+
+			// 计算位置
+			_mm256_storeu_ps(b.fLocationX + i, _mm256_add_ps(x, _mm256_mul_ps(vx, d)));
+			_mm256_storeu_ps(b.fLocationY + i, _mm256_add_ps(y, _mm256_mul_ps(vy, d)));
+
+			// 计算自旋、大小和颜色
+			integrateAVX(b.fSpin + i, b.fSpinDelta + i, d);
+			integrateAVX(b.fSize + i, b.fSizeDelta + i, d);
+			for (size_t c = 0; c < 4; c += 1) {
+				integrateAVX(b.colColor[c] + i, b.colColorDelta[c] + i, d);
+			}
+		}
+		_mm256_zeroupper();
+	}
+#endif
+}
+
+namespace luastg
+{
+	hgeParticleBuffer::~hgeParticleBuffer()
+	{
+		release();
+	}
+	void hgeParticleBuffer::bind(float* const storage, size_t const capacity) noexcept
+	{
+		m_Storage = storage;
+		m_Capacity = capacity;
+		float* p = storage;
+		auto next = [&p, capacity]() -> float*
+		{
+			float* const field = p;
+			if (p != nullptr)
+			{
+				p += capacity;
+			}
+			return field;
+		};
+		fLocationX = next();
+		fLocationY = next();
+		fVelocityX = next();
+		fVelocityY = next();
+		fGravity = next();
+		fRadialAccel = next();
+		fTangentialAccel = next();
+		fSpin = next();
+		fSpinDelta = next();
+		fSize = next();
+		fSizeDelta = next();
+		for (auto& field : colColor)
+		{
+			field = next();
+		}
+		for (auto& field : colColorDelta)
+		{
+			field = next();
+		}
+		fAge = next();
+		fTerminalAge = next();
+		assert(storage == nullptr || p == storage + capacity * s_field_count);
+	}
+	bool hgeParticleBuffer::reserve(size_t const count, size_t const alive) noexcept
+	{
+		assert(alive <= m_Capacity);
+		if (count <= m_Capacity)
+		{
+			return true;
+		}
+		auto const size_class = findSizeClass(count);
+		if (size_class >= s_size_classes.size())
+		{
+			return false;
+		}
+		auto const capacity = s_size_classes[size_class];
+		float* const storage = allocateStorage(size_class);
+		if (storage == nullptr)
+		{
+			return false;
+		}
+		// 各个字段之间的间隔发生了变化，需要逐个字段复制
+		if (m_Storage != nullptr)
+		{
+			for (size_t f = 0; f < s_field_count; f += 1)
+			{
+				std::memcpy(storage + f * capacity, m_Storage + f * m_Capacity, sizeof(float) * alive);
+			}
+			deallocateStorage(m_Storage, findSizeClass(m_Capacity));
+		}
+		bind(storage, capacity);
+		return true;
+	}
+	void hgeParticleBuffer::release() noexcept
+	{
+		if (m_Storage != nullptr)
+		{
+			deallocateStorage(m_Storage, findSizeClass(m_Capacity));
+			bind(nullptr, 0);
+		}
+	}
+	void hgeParticleBuffer::store(size_t const i, hgeParticle const& p) noexcept
+	{
+		fLocationX[i] = p.vecLocation.x;
+		fLocationY[i] = p.vecLocation.y;
+		fVelocityX[i] = p.vecVelocity.x;
+		fVelocityY[i] = p.vecVelocity.y;
+		fGravity[i] = p.fGravity;
+		fRadialAccel[i] = p.fRadialAccel;
+		fTangentialAccel[i] = p.fTangentialAccel;
+		fSpin[i] = p.fSpin;
+		fSpinDelta[i] = p.fSpinDelta;
+		fSize[i] = p.fSize;
+		fSizeDelta[i] = p.fSizeDelta;
+		for (size_t c = 0; c < 4; c += 1)
+		{
+			colColor[c][i] = p.colColor[c];
+			colColorDelta[c][i] = p.colColorDelta[c];
+		}
+		fAge[i] = p.fAge;
+		fTerminalAge[i] = p.fTerminalAge;
+	}
+	void hgeParticleBuffer::move(size_t const from, size_t const to) noexcept
+	{
+		fLocationX[to] = fLocationX[from];
+		fLocationY[to] = fLocationY[from];
+		fVelocityX[to] = fVelocityX[from];
+		fVelocityY[to] = fVelocityY[from];
+		fGravity[to] = fGravity[from];
+		fRadialAccel[to] = fRadialAccel[from];
+		fTangentialAccel[to] = fTangentialAccel[from];
+		fSpin[to] = fSpin[from];
+		fSpinDelta[to] = fSpinDelta[from];
+		fSize[to] = fSize[from];
+		fSizeDelta[to] = fSizeDelta[from];
+		for (size_t c = 0; c < 4; c += 1)
+		{
+			colColor[c][to] = colColor[c][from];
+			colColorDelta[c][to] = colColorDelta[c][from];
+		}
+		fAge[to] = fAge[from];
+		fTerminalAge[to] = fTerminalAge[from];
+	}
+	void hgeParticleBuffer::update(size_t const count, float const delta, core::Vector2F const center, mask_t& dead_mask) noexcept
+	{
+		assert(count <= m_Capacity);
+		dead_mask.fill(0);
+	#ifdef LUASTG_CPU_X86
+		if (isAvxSupported())
+			updateAVX(*this, count, delta, center, dead_mask);
+		else
+			updateSSE(*this, count, delta, center, dead_mask);
+	#else
+		updateScalar(*this, count, delta, center, dead_mask);
+	#endif
+		// 补齐部分不是粒子
+		if (count % 64 != 0)
+		{
+			dead_mask[count / 64] &= (uint64_t(1) << (count % 64)) - 1;
+		}
+	}
+	hgeParticleBuffer::Statistics hgeParticleBuffer::getStatistics() noexcept
+	{
+		std::lock_guard lock(s_storage_mutex);
+		return s_statistics;
+	}
+}
@@ -1,11 +1,14 @@
 #include "GameResource/Implement/ResourceParticleImpl.hpp"
 #include "GameResource/LegacyBlendStateHelper.hpp"
-#include "GameResource/SharedSpriteRenderer.hpp"
 #include "AppFrame.h"
+#include "Utility/JobSystem.hpp"
+#include <bit>
 
 namespace luastg
 {
 	static std::pmr::unsynchronized_pool_resource s_particle_pool_res;
+	static std::vector<ParticlePoolImpl*> s_scheduled_particle_pools;
+	static constexpr size_t s_parallel_update_chunk_size = 8;
 	
 	bool ParticleSystemResourceInfo::LoadFromMemory(void const* data, size_t size)
 	{
@@ -76,11 +79,24 @@ namespace luastg
 		m_Info = static_cast<ResourceParticleImpl*>(ref.get())->GetResourceInfo();
 		SetSeed(uint32_t(std::rand()));
 	}
-	size_t ParticlePoolImpl::GetAliveCount() { return m_iAlive; }
-	BlendMode ParticlePoolImpl::GetBlendMode() { return m_Info.eBlendMode; }
-	void ParticlePoolImpl::SetBlendMode(BlendMode m) { m_Info.eBlendMode = m; }
+	ParticlePoolImpl::~ParticlePoolImpl()
+	{
+		// 粒子池已经被销毁，推迟的更新不再有意义，直接从待更新列表中移除
+		if (m_iScheduledIndex != no_schedule)
+		{
+			ParticlePoolImpl* const last = s_scheduled_particle_pools.back();
+			s_scheduled_particle_pools[m_iScheduledIndex] = last;
+			last->m_iScheduledIndex = m_iScheduledIndex;
+			s_scheduled_particle_pools.pop_back();
+			m_iScheduledIndex = no_schedule;
+		}
+	}
+	size_t ParticlePoolImpl::GetAliveCount() { FlushUpdate(); return m_iAlive; }
+	BlendMode ParticlePoolImpl::GetBlendMode() { FlushUpdate(); return m_Info.eBlendMode; }
+	void ParticlePoolImpl::SetBlendMode(BlendMode m) { FlushUpdate(); m_Info.eBlendMode = m; }
 	core::Color4B ParticlePoolImpl::GetVertexColor()
 	{
+		FlushUpdate();
 		return core::Color4B(
 			(uint8_t)std::clamp(m_Info.colVertexColor[0] * 255.0f, 0.0f, 255.0f),
 			(uint8_t)std::clamp(m_Info.colVertexColor[1] * 255.0f, 0.0f, 255.0f),
@@ -90,22 +106,25 @@ namespace luastg
 	}
 	void ParticlePoolImpl::SetVertexColor(core::Color4B c)
 	{
+		FlushUpdate();
 		m_Info.colVertexColor[0] = (float)c.r / 255.0f;
 		m_Info.colVertexColor[1] = (float)c.g / 255.0f;
 		m_Info.colVertexColor[2] = (float)c.b / 255.0f;
 		m_Info.colVertexColor[3] = (float)c.a / 255.0f;
 	}
-	int ParticlePoolImpl::GetEmission() { return m_Info.tParticleSystemInfo.nEmission; }
-	void ParticlePoolImpl::SetEmission(int e) { m_Info.tParticleSystemInfo.nEmission = e; }
-	uint32_t ParticlePoolImpl::GetSeed() { return m_RandomSeed; }
+	int ParticlePoolImpl::GetEmission() { FlushUpdate(); return m_Info.tParticleSystemInfo.nEmission; }
+	void ParticlePoolImpl::SetEmission(int e) { FlushUpdate(); m_Info.tParticleSystemInfo.nEmission = e; }
+	uint32_t ParticlePoolImpl::GetSeed() { FlushUpdate(); return m_RandomSeed; }
 	void ParticlePoolImpl::SetSeed(uint32_t seed)
 	{
+		FlushUpdate();
 		m_RandomSeed = seed;
 		m_Random.seed(seed);
 	}
-	bool ParticlePoolImpl::IsActived() { return m_iStatus == Status::Alive; }
+	bool ParticlePoolImpl::IsActived() { FlushUpdate(); return m_iStatus == Status::Alive; }
 	void ParticlePoolImpl::SetActive(bool v)
 	{
+		FlushUpdate();
 		if (v)
 		{
 			m_iStatus = Status::Alive;
@@ -118,16 +137,69 @@ namespace luastg
 	}
 	void ParticlePoolImpl::SetCenter(core::Vector2F pos)
 	{
+		FlushUpdate();
 		if (m_iStatus == Status::Alive)
 			m_vPrevCenter = m_vCenter;
 		else
 			m_vPrevCenter = pos;
 		m_vCenter = pos;
 	}
-	core::Vector2F ParticlePoolImpl::GetCenter() { return m_vCenter; }
-	void ParticlePoolImpl::SetRotation(float r) { m_fDirection = r; }
-	float ParticlePoolImpl::GetRotation() { return m_fDirection; }
+	core::Vector2F ParticlePoolImpl::GetCenter() { FlushUpdate(); return m_vCenter; }
+	size_t ParticlePoolImpl::GetCapacityHint()
+	{
+		// 发射速率和最长寿命都已知时，稳定状态下同时存活的粒子数不会超过两者的乘积
+		hgeParticleSystemInfo const& pInfo = m_Info.tParticleSystemInfo;
+		if (pInfo.nEmission <= 0 || !(pInfo.fParticleLifeMax > 0.0f))
+			return 0;
+		float const count = std::ceil((float)pInfo.nEmission * pInfo.fParticleLifeMax);
+		return (size_t)(std::min)(count, (float)LPARTICLE_MAXCNT);
+	}
+	void ParticlePoolImpl::SetRotation(float r) { FlushUpdate(); m_fDirection = r; }
+	float ParticlePoolImpl::GetRotation() { FlushUpdate(); return m_fDirection; }
 	void ParticlePoolImpl::Update(float delta)
+	{
+		// 同一帧内多次更新时，先执行之前推迟的更新，保持更新顺序
+		FlushUpdate();
+		m_fScheduledDelta = delta;
+		m_iScheduledIndex = s_scheduled_particle_pools.size();
+		s_scheduled_particle_pools.push_back(this);
+	}
+	void ParticlePoolImpl::FlushUpdate()
+	{
+		if (m_iScheduledIndex == no_schedule)
+		{
+			return;
+		}
+		// 从待更新列表中移除，列表的顺序不影响结果
+		ParticlePoolImpl* const last = s_scheduled_particle_pools.back();
+		s_scheduled_particle_pools[m_iScheduledIndex] = last;
+		last->m_iScheduledIndex = m_iScheduledIndex;
+		s_scheduled_particle_pools.pop_back();
+		m_iScheduledIndex = no_schedule;
+		UpdateImmediately(m_fScheduledDelta);
+	}
+	void ParticlePoolImpl::ExecuteScheduledUpdate()
+	{
+		if (s_scheduled_particle_pools.empty())
+		{
+			return;
+		}
+		// 每个粒子池只访问自己的数据和随机数发生器，可以安全地并行更新
+		JobSystem::getInstance().parallelFor(s_scheduled_particle_pools.size(), s_parallel_update_chunk_size, [](size_t, size_t const begin, size_t const end)
+		{
+			for (size_t i = begin; i < end; i += 1)
+			{
+				ParticlePoolImpl* const p = s_scheduled_particle_pools[i];
+				p->UpdateImmediately(p->m_fScheduledDelta);
+			}
+		});
+		for (auto const p : s_scheduled_particle_pools)
+		{
+			p->m_iScheduledIndex = no_schedule;
+		}
+		s_scheduled_particle_pools.clear();
+	}
+	void ParticlePoolImpl::UpdateImmediately(float delta)
 	{
 		hgeParticleSystemInfo const& pInfo = m_Info.tParticleSystemInfo;
 
@@ -140,48 +212,33 @@ namespace luastg
 			}
 		}
 
-		// 更新所有粒子
-		for (size_t i = 0; i < m_iAlive; i += 1)
+		// 更新所有粒子，超过寿命的粒子只做标记
+		hgeParticleBuffer::mask_t dead_mask;
+		m_ParticlePool.update(m_iAlive, delta, m_vCenter, dead_mask);
+
+		// 移除超过寿命的粒子，只访问被标记的粒子
+		// 与逐个更新时的行为一致：用末尾最后一个存活的粒子填补空位，保持粒子顺序不变
+		size_t alive = m_iAlive;
+		for (size_t w = 0; w < dead_mask.size() && w * 64 < alive; w += 1)
 		{
-			hgeParticle& tInst = m_ParticlePool[i];
-			tInst.fAge += delta;
-			if (tInst.fAge >= tInst.fTerminalAge)
+			uint64_t bits = dead_mask[w];
+			while (bits != 0)
 			{
-				m_iAlive -= 1;
-				if (i < m_iAlive)
+				size_t const i = w * 64 + (size_t)std::countr_zero(bits);
+				bits &= bits - 1;
+				if (i >= alive)
+					break;
+				do
+				{
+					alive -= 1;
+				} while (alive > i && (dead_mask[alive / 64] & (uint64_t(1) << (alive % 64))));
+				if (alive > i)
 				{
-					// 需要拷贝最后一个粒子到当前位置
-					std::memcpy(&tInst, &m_ParticlePool[m_iAlive], sizeof(hgeParticle));
+					m_ParticlePool.move(alive, i);
 				}
-				// 回溯索引
-				i -= 1;
-				continue;
 			}
-
-			// 计算线加速度和切向加速度
-			core::Vector2F vecAccel = (tInst.vecLocation - m_vCenter).normalized();
-			core::Vector2F vecAccel2 = vecAccel;
-			vecAccel *= tInst.fRadialAccel;
-			// 相当于旋转向量 vecAccel2.Rotate(M_PI_2);
-			std::swap(vecAccel2.x, vecAccel2.y);
-			vecAccel2.x = -vecAccel2.x;
-			vecAccel2 *= tInst.fTangentialAccel;
-
-			// 计算速度
-			tInst.vecVelocity += (vecAccel + vecAccel2) * delta;
-			tInst.vecVelocity.y += tInst.fGravity * delta;
-
-			// 计算位置
-			tInst.vecLocation += tInst.vecVelocity * delta;
-
-			// 计算自旋和大小
-			tInst.fSpin += tInst.fSpinDelta * delta;
-			tInst.fSize += tInst.fSizeDelta * delta;
-			tInst.colColor[0] += tInst.colColorDelta[0] * delta;
-			tInst.colColor[1] += tInst.colColorDelta[1] * delta;
-			tInst.colColor[2] += tInst.colColorDelta[2] * delta;
-			tInst.colColor[3] += tInst.colColorDelta[3] * delta;
 		}
+		m_iAlive = alive;
 
 		// 产生新的粒子
 		if (m_iStatus == Status::Alive)
@@ -192,11 +249,12 @@ namespace luastg
 
 			for (uint32_t i = 0; i < nParticlesCreated; ++i)
 			{
-				if (m_iAlive >= m_ParticlePool.size())
+				if (m_iAlive >= LPARTICLE_MAXCNT)
+					break;
+				if (m_iAlive >= m_ParticlePool.capacity() && !m_ParticlePool.reserve((std::max)(m_iAlive + 1, GetCapacityHint()), m_iAlive))
 					break;
 
-				hgeParticle& tInst = m_ParticlePool[m_iAlive];
-				m_iAlive += 1;
+				hgeParticle tInst;
 
 				tInst.fAge = 0.0f;
 				tInst.fTerminalAge = RandomFloat(pInfo.fParticleLifeMin, pInfo.fParticleLifeMax);
@@ -252,53 +310,157 @@ namespace luastg
 				tInst.colColorDelta[1] = (pInfo.colColorEnd[1] - tInst.colColor[1]) / tInst.fTerminalAge;
 				tInst.colColorDelta[2] = (pInfo.colColorEnd[2] - tInst.colColor[2]) / tInst.fTerminalAge;
 				tInst.colColorDelta[3] = (pInfo.colColorEnd[3] - tInst.colColor[3]) / tInst.fTerminalAge;
+
+				m_ParticlePool.store(m_iAlive, tInst);
+				m_iAlive += 1;
 			}
 		}
 
+		// 不再产生粒子并且所有粒子都消失了，归还存储空间
+		if (m_iStatus == Status::Sleep && m_iAlive == 0)
+		{
+			m_ParticlePool.release();
+		}
+
 		m_vPrevCenter = m_vCenter;
 	}
 	void ParticlePoolImpl::Render(float scaleX, float scaleY)
 	{
+		FlushUpdate();
+		if (m_iAlive == 0)
+		{
+			return;
+		}
+
 		hgeParticleSystemInfo const& pInfo = m_Info.tParticleSystemInfo;
 		core::Color4B const tVertexColor = GetVertexColor();
 		const auto sprite = m_Info.pSprite.get();
-		const auto renderer = SharedSpriteRenderer::getInstance();
 		const auto command_list = LAPP.getRenderer2D();
 		const auto blend = luastg::translateLegacyBlendState(m_Info.eBlendMode);
+		hgeParticleBuffer const& tPool = m_ParticlePool;
 
-		renderer->setSprite(sprite);
-		renderer->setZ(0.5f);
-		renderer->setLegacyBlendState(blend.vertex_color_blend_state, blend.blend_state);
+		// 所有粒子共用同一个精灵，纹理、混合模式只需要设置一次
+		command_list->setVertexColorBlendState(blend.vertex_color_blend_state);
+		command_list->setBlendState(blend.blend_state);
+		command_list->setTexture(sprite->getTexture());
 
-		for (size_t i = 0; i < m_iAlive; i += 1)
+		// 一次性分配所有粒子需要的顶点和索引
+		// 注意：从显卡映射的缓冲区，只能写入，禁止读取
+		core::Graphics::IRenderer::DrawVertex* p_vertex = nullptr;
+		core::Graphics::IRenderer::DrawIndex* p_index = nullptr;
+		uint16_t index_offset = 0;
+		uint16_t const quad_count = (uint16_t)m_iAlive;
+		if (!command_list->drawRequest(quad_count * 4, quad_count * 6, &p_vertex, &p_index, &index_offset))
 		{
-			hgeParticle const& pInst = m_ParticlePool[i];
-			if (pInfo.colColorStart[0] < 0) // r < 0
+			return; // 分配空间失败了
+		}
+
+		// 以下计算与 SpriteRenderer 的 setSprite、setColor、setTransform 保持相同的运算顺序
+
+		// 第一部分：计算顶点颜色
+		std::array<uint32_t, hgeParticleBuffer::max_capacity> colors;
+		if (pInfo.colColorStart[0] < 0) // r < 0
+		{
+			for (size_t i = 0; i < m_iAlive; i += 1)
 			{
-				renderer->setColor(core::Color4B(
+				colors[i] = core::Color4B(
 					tVertexColor.r,
 					tVertexColor.g,
 					tVertexColor.b,
-					(uint8_t)std::clamp(pInst.colColor[3] * (float)tVertexColor.a, 0.0f, 255.0f)
-				));
+					(uint8_t)std::clamp(tPool.colColor[3][i] * (float)tVertexColor.a, 0.0f, 255.0f)
+				).color();
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < m_iAlive; i += 1)
+			{
+				colors[i] = core::Color4B(
+					(uint8_t)std::clamp(tPool.colColor[0][i] * (float)tVertexColor.r, 0.0f, 255.0f),
+					(uint8_t)std::clamp(tPool.colColor[1][i] * (float)tVertexColor.g, 0.0f, 255.0f),
+					(uint8_t)std::clamp(tPool.colColor[2][i] * (float)tVertexColor.b, 0.0f, 255.0f),
+					(uint8_t)std::clamp(tPool.colColor[3][i] * (float)tVertexColor.a, 0.0f, 255.0f)
+				).color();
+			}
+		}
+
+		// 第二部分：精灵的纹理坐标和未缩放的矩形，所有粒子都相同
+		core::RectF const tex_rect = sprite->getTextureRect();
+		core::Vector2U const tex_size = sprite->getTexture()->getSize();
+		float const u_scale = 1.0f / static_cast<float>(tex_size.x);
+		float const v_scale = 1.0f / static_cast<float>(tex_size.y);
+		float const u0 = tex_rect.a.x * u_scale;
+		float const v0 = tex_rect.a.y * v_scale;
+		float const u1 = tex_rect.b.x * u_scale;
+		float const v1 = tex_rect.b.y * v_scale;
+		core::Vector2F const center0 = tex_rect.a + sprite->getTextureCenter();
+		core::RectF const rect0 = tex_rect - center0;
+		core::Vector2F const scale0(sprite->getUnitsPerPixel(), -sprite->getUnitsPerPixel()); // Y up
+		core::Vector2F const base_a = rect0.a * scale0;
+		core::Vector2F const base_b = rect0.b * scale0;
+
+		// 第三部分：填充顶点，先生成到栈上，再复制到映射的缓冲区
+		// 0---1
+		// |  /|
+		// | / |
+		// |/  |
+		// 3---2
+		core::Graphics::IRenderer::DrawVertex* p_vert = p_vertex;
+		for (size_t i = 0; i < m_iAlive; i += 1)
+		{
+			float const size = tPool.fSize[i];
+			float const ax = base_a.x * (scaleX * size);
+			float const ay = base_a.y * (scaleY * size);
+			float const bx = base_b.x * (scaleX * size);
+			float const by = base_b.y * (scaleY * size);
+			float const px = tPool.fLocationX[i];
+			float const py = tPool.fLocationY[i];
+			float const rotation = tPool.fSpin[i];
+			uint32_t const color = colors[i];
+			core::Graphics::IRenderer::DrawVertex quad[4]{
+				{ ax, ay, 0.5f, u0, v0, color },
+				{ bx, ay, 0.5f, u1, v0, color },
+				{ bx, by, 0.5f, u1, v1, color },
+				{ ax, by, 0.5f, u0, v1, color },
+			};
+			if (std::abs(rotation) < std::numeric_limits<float>::min())
+			{
+				for (auto& v : quad)
+				{
+					v.x = px + v.x;
+					v.y = py + v.y;
+				}
 			}
 			else
 			{
-				renderer->setColor(core::Color4B(
-					(uint8_t)std::clamp(pInst.colColor[0] * (float)tVertexColor.r, 0.0f, 255.0f),
-					(uint8_t)std::clamp(pInst.colColor[1] * (float)tVertexColor.g, 0.0f, 255.0f),
-					(uint8_t)std::clamp(pInst.colColor[2] * (float)tVertexColor.b, 0.0f, 255.0f),
-					(uint8_t)std::clamp(pInst.colColor[3] * (float)tVertexColor.a, 0.0f, 255.0f)
-				));
+				float const sin_v = std::sinf(rotation);
+				float const cos_v = std::cosf(rotation);
+				for (auto& v : quad)
+				{
+					float const x = v.x * cos_v - v.y * sin_v;
+					float const y = v.x * sin_v + v.y * cos_v;
+					v.x = x + px;
+					v.y = y + py;
+				}
 			}
-			renderer->setTransform(
-				core::Vector2F(pInst.vecLocation.x, pInst.vecLocation.y),
-				core::Vector2F(scaleX * pInst.fSize, scaleY * pInst.fSize),
-				pInst.fSpin
-			);
-			renderer->draw(command_list);
+			std::memcpy(p_vert, quad, sizeof(quad)); // 尽可能使用内存复制，避免出现意外的读取
+			p_vert += 4;
 		}
 
-		renderer->setSprite(nullptr);
+		// 第四部分：填充索引，与 drawQuad 的顺序相同
+		// 注意：从显卡映射的缓冲区，只能写入，禁止读取
+		core::Graphics::IRenderer::DrawIndex* p_vidx = p_index;
+		uint16_t quad_offset = index_offset;
+		for (size_t i = 0; i < m_iAlive; i += 1)
+		{
+			p_vidx[0] = quad_offset;
+			p_vidx[1] = quad_offset + 1;
+			p_vidx[2] = quad_offset + 2;
+			p_vidx[3] = quad_offset + 2;
+			p_vidx[4] = quad_offset + 3;
+			p_vidx[5] = quad_offset;
+			p_vidx += 6;
+			quad_offset += 4;
+		}
 	}
 }
@@ -33,6 +33,71 @@ namespace luastg
 		float fTerminalAge; // 终止时间
 	};
 
+	// 粒子池中的粒子数据，每个字段分别连续存储，便于使用 SIMD 指令批量更新
+	// 存储空间按需分配，按容量分级增长，释放后回收到对应级别的空闲链表
+	struct hgeParticleBuffer
+	{
+		static constexpr size_t simd_width = 8;
+		static constexpr size_t max_capacity = (LPARTICLE_MAXCNT + simd_width - 1) / simd_width * simd_width; // 补齐到 SIMD 宽度
+		static constexpr size_t mask_words = (max_capacity + 63) / 64;
+		using mask_t = std::array<uint64_t, mask_words>;
+
+		// 粒子数据占用的内存统计
+		struct Statistics
+		{
+			size_t buffer_count{}; // 持有存储空间的粒子池数量
+			size_t used_bytes{}; // 粒子池正在使用的内存
+			size_t peak_used_bytes{}; // 粒子池正在使用的内存的峰值
+			size_t cached_bytes{}; // 空闲链表中缓存的内存
+		};
+
+		float* fLocationX{};
+		float* fLocationY{};
+		float* fVelocityX{};
+		float* fVelocityY{};
+		float* fGravity{};
+		float* fRadialAccel{};
+		float* fTangentialAccel{};
+		float* fSpin{};
+		float* fSpinDelta{};
+		float* fSize{};
+		float* fSizeDelta{};
+		std::array<float*, 4> colColor{};
+		std::array<float*, 4> colColorDelta{};
+		float* fAge{};
+		float* fTerminalAge{};
+
+		// 当前容量，始终是 SIMD 宽度的整数倍
+		size_t capacity() const noexcept { return m_Capacity; }
+		// 保证容量至少为 count，保留 [0, alive) 范围内的粒子，超过最大容量或者内存不足时返回 false
+		bool reserve(size_t count, size_t alive) noexcept;
+		// 归还存储空间，容量变为 0
+		void release() noexcept;
+		// 写入一个粒子
+		void store(size_t i, hgeParticle const& p) noexcept;
+		// 将一个粒子复制到另一个位置
+		void move(size_t from, size_t to) noexcept;
+		// 更新 [0, count) 范围内的粒子，运算顺序与 HGE 逐个更新粒子完全一致
+		// 超过寿命的粒子不会被移除，而是在 dead_mask 中标记出来（第 i 位对应第 i 个粒子）
+		void update(size_t count, float delta, core::Vector2F center, mask_t& dead_mask) noexcept;
+
+		static Statistics getStatistics() noexcept;
+
+		hgeParticleBuffer() = default;
+		hgeParticleBuffer(hgeParticleBuffer const&) = delete;
+		hgeParticleBuffer(hgeParticleBuffer&&) = delete;
+		~hgeParticleBuffer();
+
+		hgeParticleBuffer& operator=(hgeParticleBuffer const&) = delete;
+		hgeParticleBuffer& operator=(hgeParticleBuffer&&) = delete;
+
+	private:
+		void bind(float* storage, size_t capacity) noexcept;
+
+		float* m_Storage{};
+		size_t m_Capacity{};
+	};
+
 	// 粒子效果资源定义
 	struct ParticleSystemResourceInfo
 	{
@@ -57,7 +122,7 @@ namespace luastg
 	private:
 		core::SmartReference<IResourceParticle> m_Res;
 		ParticleSystemResourceInfo m_Info;
-		std::array<hgeParticle, LPARTICLE_MAXCNT> m_ParticlePool;
+		hgeParticleBuffer m_ParticlePool;
 		random::xoshiro128p m_Random;
 		uint32_t m_RandomSeed = 0;
 		Status m_iStatus = Status::Alive;  // 状态
@@ -68,10 +133,19 @@ namespace luastg
 		float m_fAge = 0.f;  // 已存活时间
 		float m_fEmissionResidue = 0.f;  // 不足的粒子数
 		bool m_bOldBehavior = true; // 使用旧行为
+		size_t m_iScheduledIndex = no_schedule; // 在待更新列表中的位置
+		float m_fScheduledDelta = 0.f; // 推迟执行的更新的时间增量
 	private:
+		static constexpr size_t no_schedule = ~size_t(0);
 		float RandomFloat(float a, float b);
+		// 立即执行一次更新
+		void UpdateImmediately(float delta);
+		// 如果有推迟执行的更新，立即执行，读写粒子池状态前都需要调用
+		void FlushUpdate();
+		// 根据发射速率和粒子寿命估计需要的容量，无法估计时返回 0
+		size_t GetCapacityHint();
 	public:
-		hgeParticleSystemInfo& GetParticleSystemInfo() { return m_Info.tParticleSystemInfo; };
+		hgeParticleSystemInfo& GetParticleSystemInfo() { FlushUpdate(); return m_Info.tParticleSystemInfo; };
 		size_t GetAliveCount();
 		BlendMode GetBlendMode();
 		void SetBlendMode(BlendMode m);
@@ -87,11 +161,16 @@ namespace luastg
 		core::Vector2F GetCenter();
 		float GetRotation();
 		void SetRotation(float r);
+		// 更新被推迟到本帧的帧函数执行完以后，由 ExecuteScheduledUpdate 统一执行
 		void Update(float delta);
 		void Render(float scaleX, float scaleY);
-		void SetOldBehavior(bool b) { m_bOldBehavior = b; }
+		void SetOldBehavior(bool b) { FlushUpdate(); m_bOldBehavior = b; }
+	public:
+		// 在工作线程上并行执行所有推迟的更新，粒子池之间互不影响，结果与逐个执行相同
+		static void ExecuteScheduledUpdate();
 	public:
 		ParticlePoolImpl(core::SmartReference<IResourceParticle> ps_ref);
+		~ParticlePoolImpl();
 	};
 
 	class ResourceParticleImpl : public ResourceBaseImpl<IResourceParticle>
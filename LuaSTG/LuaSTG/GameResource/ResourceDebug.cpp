@@ -1,4 +1,5 @@
 #include "GameResource/ResourceManager.h"
+#include "GameResource/Implement/ResourceParticleImpl.hpp"
 #ifdef USING_DEAR_IMGUI
 #include "imgui.h"
 #endif
@@ -312,6 +313,14 @@ namespace luastg
 					{
 						ImGui::Text("Total Resources: %u", p_pool->m_ParticlePool.size());
 
+						// 粒子数据由所有粒子池共享的分配器管理，与资源集无关
+						auto const particle_memory = hgeParticleBuffer::getStatistics();
+						ImGui::Text("Particle Pools Holding Memory: %llu", (unsigned long long)particle_memory.buffer_count);
+						ImGui::Text("Particle Memory Usage: %s", bytes_count_to_string(particle_memory.used_bytes).c_str());
+						ImGui::Text("Particle Memory Usage (Peak): %s", bytes_count_to_string(particle_memory.peak_used_bytes).c_str());
+						ImGui::Text("Particle Memory Usage (Average Per Pool): %s", bytes_count_to_string(particle_memory.buffer_count > 0 ? particle_memory.used_bytes / particle_memory.buffer_count : 0).c_str());
+						ImGui::Text("Particle Memory Cached: %s", bytes_count_to_string(particle_memory.cached_bytes).c_str());
+
 						static ImGuiTextFilter filter;
 						filter.Draw();
 
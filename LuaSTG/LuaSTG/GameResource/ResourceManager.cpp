@@ -1,4 +1,5 @@
 #include "GameResource/ResourceManager.h"
+#include "GameResource/Implement/ResourceParticleImpl.hpp"
 
 namespace luastg
 {
@@ -143,6 +144,10 @@ namespace luastg
 			snd.second->FlushCommand();
 		}
 	}
+	void ResourceMgr::UpdateParticle()
+	{
+		ParticlePoolImpl::ExecuteScheduledUpdate();
+	}
 
 	// 其他
 
@@ -179,14 +179,19 @@ namespace luastg
         bool GetTextureSize(const char* name, core::Vector2U& out) noexcept;
         void CacheTTFFontString(const char* name, const char* text, size_t len) noexcept;
         void UpdateSound();
+        void UpdateParticle();
     private:
         static bool g_ResourceLoadingLog;
         float m_GlobalImageScaleFactor = 1.0f;
+        uint64_t m_TextureGeneration = 0;
     public:
         static void SetResourceLoadingLog(bool b);
         static bool GetResourceLoadingLog();
         float GetGlobalImageScaleFactor() const noexcept { return m_GlobalImageScaleFactor; }
         void SetGlobalImageScaleFactor(float s) noexcept { m_GlobalImageScaleFactor = s; }
+        // 纹理池每次发生变化（加载、卸载、清空）都会递增，可以用于判断缓存的纹理是否仍然有效
+        uint64_t GetTextureGeneration() const noexcept { return m_TextureGeneration; }
+        void NotifyTexturePoolChanged() noexcept { m_TextureGeneration += 1; }
         void ShowResourceManagerDebugWindow(bool* p_open = nullptr);
     public:
         ResourceMgr();
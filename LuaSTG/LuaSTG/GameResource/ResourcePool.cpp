@@ -19,6 +19,7 @@ namespace luastg
     void ResourcePool::Clear() noexcept
     {
         m_TexturePool.clear();
+        m_pMgr->NotifyTexturePoolChanged();
         m_SpritePool.clear();
         m_AnimationPool.clear();
         m_MusicPool.clear();
@@ -65,6 +66,7 @@ namespace luastg
         {
         case ResourceType::Texture:
             removeResource(m_TexturePool, name);
+            m_pMgr->NotifyTexturePoolChanged();
             break;
         case ResourceType::Sprite:
             removeResource(m_SpritePool, name);
@@ -212,6 +214,7 @@ namespace luastg
             core::SmartReference<IResourceTexture> tRes;
             tRes.attach(new ResourceTextureImpl(name, p_texture.get()));
             m_TexturePool.emplace(name, tRes);
+            m_pMgr->NotifyTexturePoolChanged();
         }
         catch (std::exception const& e)
         {
@@ -250,6 +253,7 @@ namespace luastg
             core::SmartReference<IResourceTexture> tRes;
             tRes.attach(new ResourceTextureImpl(name, p_texture.get()));
             m_TexturePool.emplace(name, tRes);
+            m_pMgr->NotifyTexturePoolChanged();
         }
         catch (std::exception const& e)
         {
@@ -291,6 +295,7 @@ namespace luastg
                 tRes.attach(new ResourceTextureImpl(name, width, height, depth_buffer));
             }
             m_TexturePool.emplace(name, tRes);
+            m_pMgr->NotifyTexturePoolChanged();
         }
         catch (std::runtime_error const& e)
         {
@@ -19,8 +19,11 @@
 #include "LuaBinding/modern/SpriteRenderer.hpp"
 #include "LuaBinding/modern/FileSystemWatcher.hpp"
 #include "LuaBinding/modern/GameObject.hpp"
+#include "LuaBinding/modern/GameObjectBehavior.hpp"
+#include "LuaBinding/modern/GameObjectSnapshot.hpp"
 #include "LuaBinding/modern/Well512.hpp"
 #include "LuaBinding/modern/ShellIntegration.hpp"
+#include "LuaBinding/modern/TaskScheduler.hpp"
 #include "LuaBinding/modern/FontCollection.hpp"
 #include "LuaBinding/modern/TextLayout.hpp"
 #include "LuaBinding/modern/TextRenderer.hpp"
@@ -97,8 +100,11 @@ namespace luastg::binding
 		SpriteQuadRenderer::registerClass(L);
 		FileSystemWatcher::registerClass(L);
 		GameObject::registerClass(L);
+		GameObjectBehavior::registerClass(L);
+		GameObjectSnapshot::registerClass(L);
 		Well512::registerClass(L);
 		ShellIntegration::registerClass(L);
+		TaskScheduler::registerClass(L);
 		FontCollection::registerClass(L);
 		TextLayout::registerClass(L);
 		TextRenderer::registerClass(L);
@@ -5,6 +5,7 @@
 #include "LuaBinding/LuaWrapper.hpp"
 #include "LuaBinding/LuaWrapperMisc.hpp"
 #include "lua/plus.hpp"
+#include <chrono>
 
 using std::string_view_literals::operator ""sv;
 
@@ -81,10 +82,252 @@ namespace {
 		lua_pushnil(vm);
 		lua_rawseti(vm, idx, 4);
 	}
+	[[maybe_unused]] bool isParticlePoolBinding(lua_State* const vm, int const idx) {
+		if (!lua_isuserdata(vm, idx) || !lua_getmetatable(vm, idx)) {
+			return false;
+		}
+		luaL_getmetatable(vm, luastg::binding::ParticleSystem::ClassID.data());
+		auto const result = lua_rawequal(vm, -1, -2) != 0;
+		lua_pop(vm, 2);
+		return result;
+	}
+
+	// FFI 视图：把游戏对象的常用字段声明为 C 结构体，字段偏移按实际内存布局生成
+	// 结构体的名称带有版本号，字段增减或含义变化时需要增加版本号
+	constexpr int32_t game_object_ffi_version{ 1 };
+
+	template<typename T>
+	constexpr std::string_view getFFITypeName() {
+		if constexpr (std::is_same_v<T, double>) return "double"sv;
+		else if constexpr (std::is_same_v<T, float>) return "float"sv;
+		else if constexpr (std::is_same_v<T, int64_t>) return "int64_t"sv;
+		else if constexpr (std::is_same_v<T, int32_t>) return "int32_t"sv;
+		else if constexpr (std::is_same_v<T, uint8_t>) return "uint8_t"sv;
+		else static_assert(sizeof(T) == 0, "unsupported FFI field type");
+	}
+
+	struct FFIField {
+		std::string_view type;
+		std::string_view name;
+		size_t offset;
+		size_t size;
+		bool readonly;
+	};
+
+	std::string const& getGameObjectFFIDeclaration() {
+		static std::string const declaration = [] {
+		#define FFI_FIELD(NAME, READONLY) FFIField{ \
+			getFFITypeName<decltype(luastg::GameObject::NAME)>(), #NAME ""sv, \
+			offsetof(luastg::GameObject, NAME), sizeof(luastg::GameObject::NAME), READONLY }
+			// 修改 group、layer、a、b、img、status 等属性有副作用，只能通过 lua 对象修改
+			std::vector<FFIField> fields{
+				FFI_FIELD(x, false),
+				FFI_FIELD(y, false),
+				FFI_FIELD(vx, false),
+				FFI_FIELD(vy, false),
+				FFI_FIELD(ax, false),
+				FFI_FIELD(ay, false),
+			#ifdef USER_SYSTEM_OPERATION
+				FFI_FIELD(max_vx, false),
+				FFI_FIELD(max_vy, false),
+				FFI_FIELD(max_v, false),
+				FFI_FIELD(ag, false),
+			#endif
+				FFI_FIELD(group, true),
+				FFI_FIELD(a, true),
+				FFI_FIELD(b, true),
+				FFI_FIELD(layer, true),
+				FFI_FIELD(hscale, false),
+				FFI_FIELD(vscale, false),
+				FFI_FIELD(rot, false),
+				FFI_FIELD(omega, false),
+				FFI_FIELD(ani_timer, true),
+				FFI_FIELD(timer, false),
+			#ifdef LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
+				FFI_FIELD(pause, false),
+			#endif // LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
+				FFI_FIELD(bound, false),
+				FFI_FIELD(colli, false),
+				FFI_FIELD(hide, false),
+				FFI_FIELD(navi, false),
+			};
+		#undef FFI_FIELD
+			std::ranges::sort(fields, {}, &FFIField::offset);
+			std::string result;
+			result.append(std::format("typedef struct lstg_GameObject_v{} {{\n", game_object_ffi_version));
+			size_t offset{};
+			for (auto const& field : fields) {
+				if (field.offset > offset) {
+					result.append(std::format("    uint8_t _padding_{}[{}];\n", offset, field.offset - offset));
+				}
+				result.append(std::format("    {}{} {};\n", field.readonly ? "const "sv : ""sv, field.type, field.name));
+				offset = field.offset + field.size;
+			}
+			if (sizeof(luastg::GameObject) > offset) {
+				result.append(std::format("    uint8_t _padding_{}[{}];\n", offset, sizeof(luastg::GameObject) - offset));
+			}
+			result.append(std::format("}} lstg_GameObject_v{};\n", game_object_ffi_version));
+			return result;
+		}();
+		return declaration;
+	}
+
+	std::byte game_object_ffi_array_length_key{};
+
+	// 检查 FFI 数组的类型并返回元素数量，不是 double 数组时返回 nil
+	// 指针、float/int 数组等类型无法得知长度或元素类型不同，不能按 double 数组读取
+	constexpr auto ffi_array_length_script = R"(--- LuaSTG Sub built-in script
+local ffi = require("ffi")
+local typeof = ffi.typeof
+local sizeof = ffi.sizeof
+local find = string.find
+local double_size = sizeof("double")
+return function(value)
+	local name = tostring(typeof(value))
+	if find(name, "^ctype<double %[") or find(name, "^ctype<const double %[") then
+		local size = sizeof(value)
+		if size then
+			return size / double_size
+		end
+	end
+	return nil
+end
+)"sv;
+
+	// 获取 index 处的 FFI double 数组的元素数量，不是 double 数组时返回 false
+	bool getFFIDoubleArrayLength(lua_State* const vm, int const index, size_t& length) {
+		auto const value_index = index < 0 ? lua_gettop(vm) + index + 1 : index;
+		lua_pushlightuserdata(vm, &game_object_ffi_array_length_key);
+		lua_gettable(vm, LUA_REGISTRYINDEX);							// ... f
+		if (!lua_isfunction(vm, -1)) {
+			lua_pop(vm, 1);
+			if (luaL_loadbuffer(vm, ffi_array_length_script.data(), ffi_array_length_script.size(), "lstg/NewBatch.lua") != LUA_OK) {
+				lua_error(vm);
+			}
+			lua_call(vm, 0, 1);											// ... f
+			lua_pushlightuserdata(vm, &game_object_ffi_array_length_key);
+			lua_pushvalue(vm, -2);
+			lua_settable(vm, LUA_REGISTRYINDEX);
+		}
+		lua_pushvalue(vm, value_index);									// ... f value
+		lua_call(vm, 1, 1);												// ... n
+		auto const result = lua_isnumber(vm, -1);
+		length = result ? static_cast<size_t>(lua_tonumber(vm, -1)) : 0;
+		lua_pop(vm, 1);
+		return result;
+	}
+
+	// 检查资源池中是否有可以作为对象渲染资源的资源，查找顺序参考 GameObject::ChangeResource
+	bool hasRenderResource(char const* const name) {
+		return LRES.FindSprite(name) || LRES.FindAnimation(name) || LRES.FindParticle(name);
+	}
+
+	// 批量创建对象时的属性来源：所有对象使用同一个值、lua 数组（从 1 开始）或 FFI double 数组（从 0 开始）
+	struct BatchAttribute {
+		// LuaJIT 扩展的类型，lua.h 中没有定义
+		static constexpr int lua_type_cdata{ 10 };
+
+		enum class Source : uint8_t {
+			None,
+			Scalar,
+			Table,
+			Pointer,
+		};
+
+		Source source{ Source::None };
+		int index{};
+		lua_Number value{};
+		lua_Number const* pointer{};
+		size_t length{};
+
+		[[nodiscard]] bool has() const noexcept { return source != Source::None; }
+		[[nodiscard]] lua_Number get(lua_State* const vm, size_t const i) const {
+			switch (source) {
+			case Source::Scalar:
+				return value;
+			case Source::Table: {
+				lua_rawgeti(vm, index, static_cast<int>(i + 1));
+				auto const result = luaL_checknumber(vm, -1);
+				lua_pop(vm, 1);
+				return result;
+			}
+			case Source::Pointer:
+				assert(i < length);
+				return pointer[i];
+			case Source::None:
+			default:
+				return 0.0;
+			}
+		}
+
+		// 在创建对象前检查前 count 个值，避免创建到一半时出错
+		void check(lua_State* const vm, size_t const count, char const* const name) const {
+			switch (source) {
+			case Source::Table:
+				for (size_t i = 0; i < count; i += 1) {
+					lua_rawgeti(vm, index, static_cast<int>(i + 1));
+					if (lua_type(vm, -1) != LUA_TNUMBER) {
+						luaL_error(vm, "invalid attribute '%s', number required at index %d.", name, static_cast<int>(i + 1));
+					}
+					lua_pop(vm, 1);
+				}
+				break;
+			case Source::Pointer:
+				if (length < count) {
+					luaL_error(vm, "invalid attribute '%s', FFI double array has %d elements, %d required.", name, static_cast<int>(length), static_cast<int>(count));
+				}
+				break;
+			case Source::None:
+			case Source::Scalar:
+			default:
+				break;
+			}
+		}
+
+		// 读取属性表中的字段，如果字段是 lua 数组或 FFI 数组，字段的值会留在栈上，直到批量创建结束
+		static BatchAttribute read(lua_State* const vm, int const table, char const* const name) {
+			BatchAttribute attribute;
+			lua_getfield(vm, table, name);
+			switch (lua_type(vm, -1)) {
+			case LUA_TNIL:
+				lua_pop(vm, 1);
+				break;
+			case LUA_TNUMBER:
+				attribute.source = Source::Scalar;
+				attribute.value = lua_tonumber(vm, -1);
+				lua_pop(vm, 1);
+				break;
+			case LUA_TTABLE:
+				attribute.source = Source::Table;
+				attribute.index = lua_gettop(vm);
+				break;
+			case lua_type_cdata:
+				// 只接受 double 数组，lua_topointer 返回数组数据的地址
+				if (!getFFIDoubleArrayLength(vm, -1, attribute.length)) {
+					luaL_error(vm, "invalid attribute '%s', FFI cdata must be a double array.", name);
+				}
+				attribute.source = Source::Pointer;
+				attribute.pointer = static_cast<lua_Number const*>(lua_topointer(vm, -1));
+				attribute.index = lua_gettop(vm); // 保持 cdata 存活
+				break;
+			default:
+				luaL_error(vm, "invalid attribute '%s', number, array or FFI double array required.", name);
+				break;
+			}
+			return attribute;
+		}
+	};
 
 	struct GameObjectManagerCallbacks : luastg::IGameObjectManagerCallbacks {
+		// 批量回收过程中只记录被回收的对象，批量回收结束时统一清理 lua 侧的数据
+		struct PendingDestroy {
+			int32_t lua_index{};
+			bool has_particle_binding{};
+		};
+
 		std::vector<lua_State*> lua_vm;
 		std::vector<lua::stack_index_t> game_object_tables_index;
+		std::vector<PendingDestroy> pending_destroy;
 
 		GameObjectManagerCallbacks() {
 			lua_vm.reserve(16);
@@ -102,25 +345,19 @@ namespace {
 			spdlog::debug("[object] free {}-{} (img = {})", object->id, object->unique_id, object->res ? object->res->GetResName() : null_name);
 		#endif
 
-			auto const vm = getInstance().lua_vm.back();
-			lua::stack_t const ctx(vm);
-
-			auto const table = getInstance().game_object_tables_index.back();
-			auto const lua_index = static_cast<int32_t>(object->id + 1);
-
-			auto const object_table = ctx.get_array_value<lua::stack_index_t>(table, lua_index); // ... t ... object
-			ctx.set_array_value(object_table, 3, std::nullopt); // object[3] = nil
-		#ifdef LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
-			releaseParticlePoolBinding(object, vm, object_table.value); // releaseParticlePoolBinding(object[4]); object[4] = nil
-		#endif // LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
-			ctx.pop_value(); // ... t ...
-
-			ctx.set_array_value(table, lua_index, std::nullopt); // table[lua_index] = nil
+			// 对象的资源会在之后释放，需要在这里记录是否绑定了粒子系统
+			pending_destroy.push_back(PendingDestroy{
+				.lua_index = static_cast<int32_t>(object->id + 1),
+			#ifdef LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
+				.has_particle_binding = object->features.is_render_class && object->hasParticlePool(),
+			#endif // LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
+			});
 		}
 		void onBeforeBatchDestroy() override {
 			beforeBatch();
 		}
 		void onAfterBatchDestroy() override {
+			flushPendingDestroy();
 			afterBatch();
 		}
 		void onBeforeBatchUpdate() override {
@@ -148,6 +385,28 @@ namespace {
 			afterBatch();
 		}
 
+		// 批量回收期间不会执行 lua 代码，被回收的槽位也不会被重新分配，可以推迟到这里统一清理
+		void flushPendingDestroy() {
+			if (pending_destroy.empty()) {
+				return;
+			}
+			auto const vm = lua_vm.back();
+			auto const table = game_object_tables_index.back().value;
+			for (auto const& pending : pending_destroy) {
+				lua_rawgeti(vm, table, pending.lua_index);			// ... t ... object
+				lua_pushnil(vm);									// ... t ... object nil
+				lua_rawseti(vm, -2, 3);								// ... t ... object
+			#ifdef LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
+				if (pending.has_particle_binding) {
+					releaseParticlePoolBinding(nullptr, vm, lua_gettop(vm)); // releaseParticlePoolBinding(object[4]); object[4] = nil
+				}
+			#endif // LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
+				lua_pop(vm, 1);										// ... t ...
+				lua_pushnil(vm);									// ... t ... nil
+				lua_rawseti(vm, table, pending.lua_index);			// ... t ...
+			}
+			pending_destroy.clear();
+		}
 		void beforeBatch() {
 			auto const vm = lua_vm.back();
 			luastg::binding::GameObject::pushGameObjectTable(vm);
@@ -165,6 +424,70 @@ namespace {
 		}
 	};
 
+	std::byte game_object_profiler_classes_key{};
+
+	// 获取对象类的名称：优先使用 __name 字段，其次在全局表中查找引用了该对象类的变量名
+	std::string getClassName(lua_State* const vm, int const class_index) {
+		lua_pushstring(vm, "__name");
+		lua_rawget(vm, class_index);
+		if (lua_type(vm, -1) == LUA_TSTRING) {
+			std::string name(lua_tostring(vm, -1));
+			lua_pop(vm, 1);
+			return name;
+		}
+		lua_pop(vm, 1);
+		std::string name;
+		lua_pushvalue(vm, LUA_GLOBALSINDEX);		// ... G
+		lua_pushnil(vm);							// ... G nil
+		while (lua_next(vm, -2) != 0) {				// ... G k v
+			if (lua_type(vm, -2) == LUA_TSTRING && lua_rawequal(vm, -1, class_index)) {
+				name = lua_tostring(vm, -2);
+				lua_pop(vm, 2);						// ... G
+				break;
+			}
+			lua_pop(vm, 1);							// ... G k
+		}
+		lua_pop(vm, 1);								// ...
+		if (name.empty()) {
+			name = std::format("class: {}", lua_topointer(vm, class_index));
+		}
+		return name;
+	}
+
+	// 调用栈顶的回调函数，开启耗时统计时记录到对象类对应的统计数据
+	void callAndProfile(lua_State* const vm, int const argument_count, int const class_index, luastg::GameObjectCallbackKind const kind) {
+		auto& profiler = LPOOL.getCallbackProfiler();
+		if (!profiler.isEnabled()) [[likely]] {
+			lua_call(vm, argument_count, 0);
+			return;
+		}
+		auto const key = lua_topointer(vm, class_index);
+		bool created{};
+		auto& entry = profiler.acquire(key, created);
+		if (created) {
+			entry.name = getClassName(vm, class_index);
+			// 保存对象类，以便通过 lua 接口返回
+			lua_pushlightuserdata(vm, &game_object_profiler_classes_key);
+			lua_rawget(vm, LUA_REGISTRYINDEX);
+			if (!lua_istable(vm, -1)) {
+				lua_pop(vm, 1);
+				lua_createtable(vm, 0, 64);
+				lua_pushlightuserdata(vm, &game_object_profiler_classes_key);
+				lua_pushvalue(vm, -2);
+				lua_rawset(vm, LUA_REGISTRYINDEX);
+			}
+			lua_pushlightuserdata(vm, const_cast<void*>(lua_topointer(vm, class_index)));
+			lua_pushvalue(vm, class_index);
+			lua_rawset(vm, -3);
+			lua_pop(vm, 1);
+		}
+		auto const start = std::chrono::steady_clock::now();
+		lua_call(vm, argument_count, 0);
+		auto const end = std::chrono::steady_clock::now();
+		// 回调中可能调用了 lstg.ResetObjectCallbackProfiler，entry 此时已经失效，需要重新查找
+		profiler.record(key, kind, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+	}
+
 	struct GameObjectCallbacks : luastg::IGameObjectCallbacks {
 		std::string_view getCallbacksName(luastg::GameObject*) const noexcept override {
 			return "lua"sv;
@@ -181,15 +504,15 @@ namespace {
 			std::ignore = ctx.get_array_value<lua::stack_index_t>(object_class, LGOBJ_CC_DEL);	 // ... t ... object class callback
 			ctx.push_value(object); // ... t ... object class callback object
 			ctx.push_value(reason); // ... t ... object class callback object reason
-			lua_call(vm, 2, 0); // ... t ... object class
+			callAndProfile(vm, 2, object_class.value, luastg::GameObjectCallbackKind::Destroy); // ... t ... object class
 			ctx.pop_value(2); // ... t ...
 		}
 		void onUpdate(luastg::GameObject* self) override {
-			call(self, LGOBJ_CC_FRAME);
+			call(self, LGOBJ_CC_FRAME, luastg::GameObjectCallbackKind::Update);
 		}
 		void onLateUpdate(luastg::GameObject*) override {}
 		void onRender(luastg::GameObject* self) override {
-			call(self, LGOBJ_CC_RENDER);
+			call(self, LGOBJ_CC_RENDER, luastg::GameObjectCallbackKind::Render);
 		}
 		void onTrigger(luastg::GameObject* self, luastg::GameObject* other) override {
 			auto const vm = GameObjectManagerCallbacks::getInstance().lua_vm.back();
@@ -204,11 +527,11 @@ namespace {
 			std::ignore = ctx.get_array_value<lua::stack_index_t>(object_class, LGOBJ_CC_COLLI);	 // ... t ... object class callback
 			ctx.push_value(object); // ... t ... object class callback object
 			std::ignore = ctx.get_array_value<lua::stack_index_t>(table, other_lua_index); // ... t ... object class callback object other
-			lua_call(vm, 2, 0); // ... t ... object class
+			callAndProfile(vm, 2, object_class.value, luastg::GameObjectCallbackKind::Trigger); // ... t ... object class
 			ctx.pop_value(2); // ... t ...
 		}
 
-		static void call(luastg::GameObject const* const self, int const type) {
+		static void call(luastg::GameObject const* const self, int const type, luastg::GameObjectCallbackKind const kind) {
 			auto const vm = GameObjectManagerCallbacks::getInstance().lua_vm.back();
 			lua::stack_t const ctx(vm);
 
@@ -219,7 +542,7 @@ namespace {
 			auto const object_class = ctx.get_array_value<lua::stack_index_t>(object, 1); // ... t ... object class
 			std::ignore = ctx.get_array_value<lua::stack_index_t>(object_class, type);	 // ... t ... object class callback
 			ctx.push_value(object); // ... t ... object class callback object
-			lua_call(vm, 1, 0); // ... t ... object class
+			callAndProfile(vm, 1, object_class.value, kind); // ... t ... object class
 			ctx.pop_value(2); // ... t ...
 		}
 
@@ -485,10 +808,12 @@ namespace luastg::binding {
 				// 位置
 
 			case LuaSTG::GameObjectMember::X:
-				self->x = ctx.get_value<lua_Number>(3);
+				self->x = ctx.get_value<luastg::GameObjectScalar>(3);
+				LPOOL.markSpatialQueryDirty(self->group);
 				return 0;
 			case LuaSTG::GameObjectMember::Y:
-				self->y = ctx.get_value<lua_Number>(3);
+				self->y = ctx.get_value<luastg::GameObjectScalar>(3);
+				LPOOL.markSpatialQueryDirty(self->group);
 				return 0;
 			case LuaSTG::GameObjectMember::DX:
 				return luaL_error(vm, "property 'dx' is readonly.");
@@ -498,29 +823,29 @@ namespace luastg::binding {
 				// 运动学
 
 			case LuaSTG::GameObjectMember::VX:
-				self->vx = ctx.get_value<lua_Number>(3);
+				self->vx = ctx.get_value<luastg::GameObjectScalar>(3);
 				return 0;
 			case LuaSTG::GameObjectMember::VY:
-				self->vy = ctx.get_value<lua_Number>(3);
+				self->vy = ctx.get_value<luastg::GameObjectScalar>(3);
 				return 0;
 			case LuaSTG::GameObjectMember::AX:
-				self->ax = ctx.get_value<lua_Number>(3);
+				self->ax = ctx.get_value<luastg::GameObjectScalar>(3);
 				return 0;
 			case LuaSTG::GameObjectMember::AY:
-				self->ay = ctx.get_value<lua_Number>(3);
+				self->ay = ctx.get_value<luastg::GameObjectScalar>(3);
 				return 0;
 			#ifdef USER_SYSTEM_OPERATION
 			case LuaSTG::GameObjectMember::MAXVX:
-				self->max_vx = std::abs(ctx.get_value<lua_Number>(3));
+				self->max_vx = std::abs(ctx.get_value<luastg::GameObjectScalar>(3));
 				return 0;
 			case LuaSTG::GameObjectMember::MAXVY:
-				self->max_vy = std::abs(ctx.get_value<lua_Number>(3));
+				self->max_vy = std::abs(ctx.get_value<luastg::GameObjectScalar>(3));
 				return 0;
 			case LuaSTG::GameObjectMember::MAXV:
-				self->max_v = std::abs(ctx.get_value<lua_Number>(3));
+				self->max_v = std::abs(ctx.get_value<luastg::GameObjectScalar>(3));
 				return 0;
 			case LuaSTG::GameObjectMember::AG:
-				self->ag = ctx.get_value<lua_Number>(3);
+				self->ag = ctx.get_value<luastg::GameObjectScalar>(3);
 				return 0;
 			#endif
 			case LuaSTG::GameObjectMember::VSPEED:
@@ -536,8 +861,8 @@ namespace luastg::binding {
 				if (LPOOL.isLockedByDetectIntersection(self)) {
 					return luaL_error(vm, "illegal operation, lstg object 'group' property should not be modified in 'lstg.CollisionCheck'");
 				}
-				if (auto const group = luaL_checkinteger(vm, 3); group < 0 || group >= LOBJPOOL_GROUPN) {
-					return luaL_error(vm, "invalid argument for property 'group', required 0 <= group <= %d.", LOBJPOOL_GROUPN - 1);
+				if (auto const group = luaL_checkinteger(vm, 3); group < 0 || group >= static_cast<lua_Integer>(LPOOL.getGroupCount())) {
+					return luaL_error(vm, "invalid argument for property 'group', required 0 <= group <= %d.", static_cast<int>(LPOOL.getGroupCount()) - 1);
 				}
 				else if (self->group != group) {
 					self->setGroup(group);
@@ -548,26 +873,30 @@ namespace luastg::binding {
 				return 0;
 			case LuaSTG::GameObjectMember::COLLI:
 				self->colli = ctx.get_value<bool>(3);
+				LPOOL.markSpatialQueryDirty(self->group);
 				return 0;
 			case LuaSTG::GameObjectMember::RECT:
 				self->rect = ctx.get_value<bool>(3);
 				self->UpdateCollisionCircleRadius();
+				LPOOL.markSpatialQueryDirty(self->group);
 				return 0;
 			case LuaSTG::GameObjectMember::A:
 			#ifdef GLOBAL_SCALE_COLLI_SHAPE
-				self->a = ctx.get_value<lua_Number>(3) * LRES.GetGlobalImageScaleFactor();
+				self->a = static_cast<luastg::GameObjectScalar>(ctx.get_value<lua_Number>(3) * LRES.GetGlobalImageScaleFactor());
 			#else
 				self->a = ctx.get_value<lua_Number>(3);
 			#endif // GLOBAL_SCALE_COLLI_SHAPE
 				self->UpdateCollisionCircleRadius();
+				LPOOL.markSpatialQueryDirty(self->group);
 				return 0;
 			case LuaSTG::GameObjectMember::B:
 			#ifdef GLOBAL_SCALE_COLLI_SHAPE
-				self->b = ctx.get_value<lua_Number>(3) * LRES.GetGlobalImageScaleFactor();
+				self->b = static_cast<luastg::GameObjectScalar>(ctx.get_value<lua_Number>(3) * LRES.GetGlobalImageScaleFactor());
 			#else
 				self->b = ctx.get_value<lua_Number>(3);
 			#endif // GLOBAL_SCALE_COLLI_SHAPE
 				self->UpdateCollisionCircleRadius();
+				LPOOL.markSpatialQueryDirty(self->group);
 				return 0;
 
 				// 渲染
@@ -581,17 +910,18 @@ namespace luastg::binding {
 				}
 				return 0;
 			case LuaSTG::GameObjectMember::HSCALE:
-				self->hscale = ctx.get_value<lua_Number>(3);
+				self->hscale = ctx.get_value<luastg::GameObjectScalar>(3);
 				return 0;
 			case LuaSTG::GameObjectMember::VSCALE:
-				self->vscale = ctx.get_value<lua_Number>(3);
+				self->vscale = ctx.get_value<luastg::GameObjectScalar>(3);
 				return 0;
 			case LuaSTG::GameObjectMember::ROT:
-				self->rot = ctx.get_value<lua_Number>(3) * L_DEG_TO_RAD;
+				self->rot = static_cast<luastg::GameObjectScalar>(ctx.get_value<lua_Number>(3) * L_DEG_TO_RAD);
+				LPOOL.markSpatialQueryDirty(self->group);
 				return 0;
 			case LuaSTG::GameObjectMember::OMEGA:
 			case LuaSTG::GameObjectMember::OMIGA:
-				self->omega = ctx.get_value<lua_Number>(3) * L_DEG_TO_RAD;
+				self->omega = static_cast<luastg::GameObjectScalar>(ctx.get_value<lua_Number>(3) * L_DEG_TO_RAD);
 				return 0;
 			case LuaSTG::GameObjectMember::_BLEND:
 				if (self->features.is_render_class) {
@@ -647,6 +977,7 @@ namespace luastg::binding {
 						self->ReleaseResource();
 						if (!self->ChangeResource(resource_name))
 							return luaL_error(vm, "can't find resource '%s' in image/animation/particle pool.", resource_name.data());
+						LPOOL.markSpatialQueryDirty(self->group); // 碰撞体大小来自资源
 					#ifdef LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
 						changeParticlePoolBinding(self, vm, 1);
 					#endif // LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
@@ -785,6 +1116,21 @@ namespace luastg::binding {
 
 		// static methods
 
+		// 创建游戏对象对应的 lua 对象，放在栈顶
+		static lua::stack_index_t createObjectTable(lua_State* const vm, luastg::GameObject* const object, int const class_index) {
+			lua::stack_t const ctx(vm);
+
+			auto const table = ctx.create_array(3);			// ... object
+			ctx.set_array_value(table, 1, lua::stack_index_t(class_index));
+			ctx.set_array_value(table, 2, static_cast<int32_t>(object->id));
+			ctx.set_array_value(table, 3, static_cast<void*>(object));
+
+			lua_pushlightuserdata(vm, &game_object_meta_table_key);		// ... object k
+			lua_gettable(vm, LUA_REGISTRYINDEX);						// ... object mt
+			lua_setmetatable(vm, table.value);							// ... object
+
+			return table;
+		}
 		static int allocateAndManage(lua_State* const vm) {
 			auto const object = LPOOL.allocateWithCallbacks(&GameObjectCallbacks::getInstance());
 			if (object == nullptr) {
@@ -801,14 +1147,7 @@ namespace luastg::binding {
 
 			object->features = features;
 
-			auto const table = ctx.create_array(3);			// class object
-			ctx.set_array_value(table, 1, lua::stack_index_t(1));
-			ctx.set_array_value(table, 2, static_cast<int32_t>(object->id));
-			ctx.set_array_value(table, 3, static_cast<void*>(object));
-
-			lua_pushlightuserdata(vm, &game_object_meta_table_key);		// class object k
-			lua_gettable(vm, LUA_REGISTRYINDEX);						// class object mt
-			lua_setmetatable(vm, table.value);							// class object
+			auto const table = createObjectTable(vm, object, 1);		// class object
 
 			pushGameObjectTable(vm);									// class object t
 			auto const objects_table = ctx.index_of_top();
@@ -826,6 +1165,242 @@ namespace luastg::binding {
 
 			return 2;
 		}
+		static int allocateAndManageBatch(lua_State* const vm) {
+			lua::stack_t const ctx(vm);
+
+			// 参数：class count attributes ...
+
+			GameObjectFeatures features{};
+			updateGameObjectFeatures(features, vm, 1);
+			if (!features.is_class) {
+				return luaL_error(vm, "invalid argument #1, luastg object class required for 'NewBatch'.");
+			}
+			auto const count = luaL_checkinteger(vm, 2);
+			if (count < 0) {
+				return luaL_error(vm, "invalid argument #2, count must not be negative.");
+			}
+			if (static_cast<size_t>(count) > LPOOL.getCapacity() - LPOOL.GetObjectCount()) {
+				return luaL_error(vm, "failed to allocate %d objects, object pool has not enough free space.", static_cast<int>(count));
+			}
+			auto const argument_count = lua_gettop(vm);
+			auto const has_attributes = !lua_isnoneornil(vm, 3);
+			if (has_attributes) {
+				luaL_checktype(vm, 3, LUA_TTABLE);
+			}
+
+			// 属性只在创建前读取一次，之后只按下标访问
+
+			BatchAttribute x, y, rot, vx, vy, speed, angle, group, layer;
+			int img_index{};
+			if (has_attributes) {
+				x = BatchAttribute::read(vm, 3, "x");
+				y = BatchAttribute::read(vm, 3, "y");
+				rot = BatchAttribute::read(vm, 3, "rot");
+				vx = BatchAttribute::read(vm, 3, "vx");
+				vy = BatchAttribute::read(vm, 3, "vy");
+				speed = BatchAttribute::read(vm, 3, "speed");
+				angle = BatchAttribute::read(vm, 3, "angle");
+				group = BatchAttribute::read(vm, 3, "group");
+				layer = BatchAttribute::read(vm, 3, "layer");
+				lua_getfield(vm, 3, "img");
+				if (lua_isnil(vm, -1)) {
+					lua_pop(vm, 1);
+				}
+				else if (lua_isstring(vm, -1) || lua_istable(vm, -1)) {
+					img_index = lua_gettop(vm);
+				}
+				else {
+					return luaL_error(vm, "invalid attribute 'img', string or array of string required.");
+				}
+			}
+			if (speed.has() != angle.has()) {
+				return luaL_error(vm, "attribute 'speed' and 'angle' must be used together.");
+			}
+			if (layer.has() && LPOOL.isRendering()) {
+				return luaL_error(vm, "illegal operation, lstg object 'layer' property should not be modified in 'lstg.ObjRender'");
+			}
+
+			// 创建对象前检查所有属性，出错时不会留下创建了一半的对象
+
+			auto const object_count = static_cast<size_t>(count);
+			x.check(vm, object_count, "x");
+			y.check(vm, object_count, "y");
+			rot.check(vm, object_count, "rot");
+			vx.check(vm, object_count, "vx");
+			vy.check(vm, object_count, "vy");
+			speed.check(vm, object_count, "speed");
+			angle.check(vm, object_count, "angle");
+			group.check(vm, object_count, "group");
+			layer.check(vm, object_count, "layer");
+			if (group.has()) {
+				for (size_t i = 0; i < object_count; i += 1) {
+					if (auto const value = static_cast<int64_t>(group.get(vm, i)); value < 0 || static_cast<size_t>(value) >= LPOOL.getGroupCount()) {
+						return luaL_error(vm, "invalid attribute 'group', required 0 <= group <= %d.", static_cast<int>(LPOOL.getGroupCount()) - 1);
+					}
+				}
+			}
+			if (img_index != 0) {
+				auto const is_array = lua_istable(vm, img_index);
+				for (size_t i = 0; i < (is_array ? object_count : std::min<size_t>(object_count, 1)); i += 1) {
+					if (is_array) {
+						lua_rawgeti(vm, img_index, static_cast<int>(i + 1));	// ... img
+					}
+					else {
+						lua_pushvalue(vm, img_index);							// ... img
+					}
+					if (lua_type(vm, -1) != LUA_TSTRING) {
+						return luaL_error(vm, "invalid attribute 'img', string required at index %d.", static_cast<int>(i + 1));
+					}
+					if (auto const resource_name = lua_tostring(vm, -1); !hasRenderResource(resource_name)) {
+						return luaL_error(vm, "can't find resource '%s' in image/animation/particle pool.", resource_name);
+					}
+					lua_pop(vm, 1);
+				}
+			}
+
+			auto const result_table = ctx.create_array(static_cast<size_t>(count));	// ... r
+			pushGameObjectTable(vm);												// ... r t
+			auto const objects_table = ctx.index_of_top();
+
+			for (size_t i = 0; i < static_cast<size_t>(count); i += 1) {
+				auto const object = LPOOL.allocateWithCallbacks(&GameObjectCallbacks::getInstance());
+				if (object == nullptr) {
+					return luaL_error(vm, "failed to allocate object, object pool has been exhausted.");
+				}
+				object->features = features;
+
+				auto const table = createObjectTable(vm, object, 1);	// ... r t object
+				ctx.set_array_value(objects_table, static_cast<int32_t>(object->id + 1), table);
+				ctx.set_array_value(result_table, static_cast<int32_t>(i + 1), table);
+
+				// 与 lstg.New 一致，先调用 init 回调，再写入属性
+				if (features.has_callback_create) {
+					lua_rawgeti(vm, 1, 1);								// ... r t object init
+					lua_pushvalue(vm, table.value);						// ... r t object init object
+					for (int arg = 4; arg <= argument_count; arg += 1) {
+						lua_pushvalue(vm, arg);							// ... r t object init object ...
+					}
+					lua_call(vm, 1 + std::max(argument_count - 3, 0), 0);	// ... r t object
+				}
+				if (group.has()) {
+					// 已经在创建前检查过
+					if (auto const value = static_cast<int64_t>(group.get(vm, i)); object->group != value) {
+						object->setGroup(value);
+					}
+				}
+				if (x.has()) {
+					object->x = static_cast<luastg::GameObjectScalar>(x.get(vm, i));
+				}
+				if (y.has()) {
+					object->y = static_cast<luastg::GameObjectScalar>(y.get(vm, i));
+				}
+				if (rot.has()) {
+					object->rot = static_cast<luastg::GameObjectScalar>(rot.get(vm, i) * L_DEG_TO_RAD);
+				}
+				if (vx.has()) {
+					object->vx = static_cast<luastg::GameObjectScalar>(vx.get(vm, i));
+				}
+				if (vy.has()) {
+					object->vy = static_cast<luastg::GameObjectScalar>(vy.get(vm, i));
+				}
+				if (speed.has()) {
+					auto const v = speed.get(vm, i);
+					auto const a = angle.get(vm, i) * L_DEG_TO_RAD;
+					object->vx = static_cast<luastg::GameObjectScalar>(v * std::cos(a));
+					object->vy = static_cast<luastg::GameObjectScalar>(v * std::sin(a));
+				}
+				if (layer.has()) {
+					if (auto const value = layer.get(vm, i); object->layer != value) {
+						object->setLayer(value);
+					}
+				}
+				if (img_index != 0) {
+					if (lua_istable(vm, img_index)) {
+						lua_rawgeti(vm, img_index, static_cast<int>(i + 1));	// ... r t object img
+					}
+					else {
+						lua_pushvalue(vm, img_index);							// ... r t object img
+					}
+					size_t resource_name_length{};
+					auto const resource_name_data = luaL_checklstring(vm, -1, &resource_name_length);
+					std::string_view const resource_name(resource_name_data, resource_name_length);
+					if (!object->hasRenderResource() || object->getRenderResourceName() != resource_name) {
+					#ifdef LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
+						releaseParticlePoolBinding(object, vm, table.value);
+					#endif // LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
+						object->ReleaseResource();
+						if (!object->ChangeResource(resource_name))
+							return luaL_error(vm, "can't find resource '%s' in image/animation/particle pool.", resource_name.data());
+					#ifdef LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
+						changeParticlePoolBinding(object, vm, table.value);
+					#endif // LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
+					}
+					ctx.pop_value();									// ... r t object
+				}
+
+				ctx.pop_value();										// ... r t
+			}
+			// init 回调中可能已经查询过，属性是之后才写入的
+			LPOOL.markSpatialQueryDirty();
+
+			ctx.pop_value();											// ... r
+			return 1;
+		}
+		static int setCallbackProfilerEnable(lua_State* const vm) {
+			LPOOL.getCallbackProfiler().setEnabled(lua_toboolean(vm, 1));
+			return 0;
+		}
+		static int resetCallbackProfiler(lua_State* const vm) {
+			LPOOL.getCallbackProfiler().reset();
+			lua_pushlightuserdata(vm, &game_object_profiler_classes_key);
+			lua_pushnil(vm);
+			lua_rawset(vm, LUA_REGISTRYINDEX);
+			return 0;
+		}
+		static int getCallbackProfile(lua_State* const vm) {
+			lua::stack_t const ctx(vm);
+			auto const& entries = LPOOL.getCallbackProfiler().entries();
+			auto const result = ctx.create_array(entries.size());	// r
+			lua_pushlightuserdata(vm, &game_object_profiler_classes_key);
+			lua_rawget(vm, LUA_REGISTRYINDEX);						// r classes
+			auto const classes = ctx.index_of_top();
+			int32_t index{ 1 };
+			for (auto const& [key, entry] : entries) {
+				auto const item = ctx.create_map(6);				// r classes item
+				if (lua_istable(vm, classes.value)) {
+					lua_pushlightuserdata(vm, const_cast<void*>(key));
+					lua_rawget(vm, classes.value);
+					lua_setfield(vm, item.value, "class");
+				}
+				ctx.set_map_value(item, "name"sv, std::string_view(entry.name));
+				for (size_t kind = 0; kind < entry.records.size(); kind += 1) {
+					auto const& record = entry.records[kind];
+					auto const record_table = ctx.create_map(3);	// r classes item record
+					ctx.set_map_value(record_table, "count"sv, static_cast<lua_Number>(record.count));
+					ctx.set_map_value(record_table, "total"sv, static_cast<lua_Number>(record.total_time) * 1e-9);
+					ctx.set_map_value(record_table, "max"sv, static_cast<lua_Number>(record.max_time) * 1e-9);
+					auto const kind_name = GameObjectCallbackProfiler::getKindName(static_cast<GameObjectCallbackKind>(kind));
+					lua_setfield(vm, item.value, kind_name.data());	// r classes item
+				}
+				ctx.set_array_value(result, index, item);
+				ctx.pop_value();									// r classes
+				index += 1;
+			}
+			ctx.pop_value();										// r
+			return 1;
+		}
+		static int getFFIDeclaration(lua_State* const vm) {
+			lua::stack_t const ctx(vm);
+			auto const& declaration = getGameObjectFFIDeclaration();
+			ctx.push_value(std::string_view(declaration));
+			ctx.push_value(game_object_ffi_version);
+			return 2;
+		}
+		static int getObjectPointer(lua_State* const vm) {
+			auto const self = as(vm, 1);
+			lua_pushlightuserdata(vm, self);
+			return 1;
+		}
 		static int dirtyReset(lua_State* const vm) {
 			auto const self = as(vm, 1);
 			LPOOL.DirtResetObject(self);
@@ -867,7 +1442,7 @@ namespace luastg::binding {
 			GameObjectManagerCallbacks::getInstance().lua_vm.push_back(vm);
 			LPOOL.ResetPool();
 		#if (defined(_DEBUG) && defined(LuaSTG_enable_GameObjectManager_Debug))
-			for (int i = 1; i <= LOBJPOOL_SIZE; i += 1) {
+			for (int i = 1; i <= static_cast<int>(LPOOL.getCapacity()); i += 1) {
 				// 确保所有 lua 侧对象都被正确回收
 				lua_rawgeti(vm, GameObjectManagerCallbacks::getInstance().game_object_tables_index.back().value, i);
 				assert(!lua_istable(vm, -1));
@@ -877,6 +1452,33 @@ namespace luastg::binding {
 			GameObjectManagerCallbacks::getInstance().lua_vm.pop_back();
 			return 0;
 		}
+		static int getGameObjectManagerCapacity(lua_State* const vm) {
+			lua::stack_t const ctx(vm);
+			ctx.push_value(static_cast<int32_t>(LPOOL.getCapacity()));
+			return 1;
+		}
+		static int setGameObjectManagerCapacity(lua_State* const vm) {
+			auto const capacity = luaL_checkinteger(vm, 1);
+			if (capacity < 1 || capacity > static_cast<lua_Integer>(luastg::GameObjectPool::max_capacity)) {
+				return luaL_error(vm, "invalid argument #1, required 1 <= capacity <= %d.", static_cast<int>(luastg::GameObjectPool::max_capacity));
+			}
+			if (LPOOL.GetObjectCount() > 0) {
+				return luaL_error(vm, "object pool capacity can only be changed when there are no alive objects.");
+			}
+			auto const old_index = static_cast<int>(LPOOL.getCapacity() + 1);
+			if (isBatchRunning() || !LPOOL.setCapacity(static_cast<size_t>(capacity))) {
+				return luaL_error(vm, "object pool capacity cannot be changed while the object pool is updating, rendering or detecting.");
+			}
+			auto const new_index = static_cast<int>(LPOOL.getCapacity() + 1);
+			// 兼容代码：游戏对象元表放在对象表最后一个对象之后
+			pushGameObjectTable(vm);				// t
+			lua_rawgeti(vm, -1, old_index);			// t mt
+			lua_pushnil(vm);						// t mt nil
+			lua_rawseti(vm, -3, old_index);			// t mt
+			lua_rawseti(vm, -2, new_index);			// t
+			lua_pop(vm, 1);
+			return 0;
+		}
 		static int updateGameObjectManager(lua_State* const vm) {
 			// TODO: 移动到 GameObjectManager 绑定
 			// version 2
@@ -887,6 +1489,13 @@ namespace luastg::binding {
 					GameObjectManagerCallbacks::getInstance().lua_vm.pop_back();
 					return 0;
 				}
+				// version 3: 运动学批量更新
+				else if (version == 3) {
+					GameObjectManagerCallbacks::getInstance().lua_vm.push_back(vm);
+					LPOOL.updateMovementsBatch();
+					GameObjectManagerCallbacks::getInstance().lua_vm.pop_back();
+					return 0;
+				}
 			}
 			// version 1
 			GameObjectManagerCallbacks::getInstance().lua_vm.push_back(vm);
@@ -918,6 +1527,25 @@ namespace luastg::binding {
 			GameObjectManagerCallbacks::getInstance().lua_vm.pop_back();
 			return 0;
 		}
+		static void readGroupPairs(lua_State* const vm, int const index, std::pmr::vector<GameObjectPool::IntersectionDetectionGroupPair>& group_pairs) {
+			lua::stack_t const ctx(vm);
+			auto const group_count = ctx.get_array_size(index);
+			auto const max_group = static_cast<uint32_t>(LPOOL.getGroupCount());
+			group_pairs.reserve(group_count);
+			for (int32_t i = 1; i <= static_cast<int32_t>(group_count); i += 1) {
+				auto const group_pair = ctx.get_array_value<lua::stack_index_t>(index, i);
+				auto const group1 = ctx.get_array_value<uint32_t>(group_pair, 1);
+				auto const group2 = ctx.get_array_value<uint32_t>(group_pair, 2);
+				if (group1 >= max_group) {
+					luaL_error(vm, "invalid collision group <%d>", group1);
+				}
+				if (group2 >= max_group) {
+					luaL_error(vm, "invalid collision group <%d>", group2);
+				}
+				ctx.pop_value();
+				group_pairs.emplace_back(group1, group2);
+			}
+		}
 		static int intersectDetectGameObjectManager(lua_State* const vm) {
 			lua::stack_t const ctx(vm);
 			if (LPOOL.isDetectingIntersect()) {
@@ -926,11 +1554,11 @@ namespace luastg::binding {
 			if (ctx.is_number(1) && ctx.is_number(2)) {
 				auto const group1 = ctx.get_value<uint32_t>(1);
 				auto const group2 = ctx.get_value<uint32_t>(2);
-				if (group1 < 0 || group1 >= LOBJPOOL_GROUPN) {
+				if (group1 >= LPOOL.getGroupCount()) {
 					return luaL_error(vm, "invalid collision group <%d>", group1);
 				}
-				if (group2 < 0 || group2 >= LOBJPOOL_GROUPN) {
-					return luaL_error(vm, "invalid collision group <%d>", group1);
+				if (group2 >= LPOOL.getGroupCount()) {
+					return luaL_error(vm, "invalid collision group <%d>", group2);
 				}
 				GameObjectManagerCallbacks::getInstance().lua_vm.push_back(vm);
 				LPOOL.detectIntersectionLegacy(group1, group2);
@@ -947,30 +1575,196 @@ namespace luastg::binding {
 				std::array<uint32_t, 32> stack_buffer{};
 				std::pmr::monotonic_buffer_resource local_memory_resource(
 					stack_buffer.data(), stack_buffer.size() * sizeof(uint32_t),
-					std::pmr::get_default_resource());
+					&LAPP.GetFrameArena());
 				std::pmr::vector<GameObjectPool::IntersectionDetectionGroupPair> group_pairs{ &local_memory_resource };
-				group_pairs.reserve(group_count);
-				for (int32_t i = 1; i <= static_cast<int32_t>(group_count); i += 1) {
-					auto const group_pair = ctx.get_array_value<lua::stack_index_t>(1, i);
-					auto const group1 = ctx.get_array_value<uint32_t>(group_pair, 1);
-					auto const group2 = ctx.get_array_value<uint32_t>(group_pair, 2);
-					if (group1 < 0 || group1 >= LOBJPOOL_GROUPN) {
-						return luaL_error(vm, "invalid collision group <%d>", group1);
-					}
-					if (group2 < 0 || group2 >= LOBJPOOL_GROUPN) {
-						return luaL_error(vm, "invalid collision group <%d>", group1);
-					}
-					ctx.pop_value();
-					group_pairs.emplace_back(group1, group2);
-				}
+				readGroupPairs(vm, 1, group_pairs);
 				// Stage 3
+				// version 3: 空间哈希粗略阶段
+				auto const version = ctx.is_number(2) ? ctx.get_value<int32_t>(2) : 2;
 				GameObjectManagerCallbacks::getInstance().lua_vm.push_back(vm);
-				LPOOL.detectIntersection(group_pairs);
+				if (version == 3) {
+					LPOOL.detectIntersectionSpatialHash(group_pairs);
+				}
+				else {
+					LPOOL.detectIntersection(group_pairs);
+				}
 				GameObjectManagerCallbacks::getInstance().lua_vm.pop_back();
 				return 0;
 			}
 			return luaL_error(vm, "invalid parameters");
 		}
+		static int intersectDetectMatrixGameObjectManager(lua_State* const vm) {
+			lua::stack_t const ctx(vm);
+			if (LPOOL.isDetectingIntersect()) {
+				return luaL_error(vm, "invalid operation");
+			}
+			// version 3: 空间哈希粗略阶段
+			auto const version = ctx.is_number(1) ? ctx.get_value<int32_t>(1) : 2;
+			GameObjectManagerCallbacks::getInstance().lua_vm.push_back(vm);
+			LPOOL.detectIntersectionMatrix(version == 3);
+			GameObjectManagerCallbacks::getInstance().lua_vm.pop_back();
+			return 0;
+		}
+		static int setCollisionMatrix(lua_State* const vm) {
+			lua::stack_t const ctx(vm);
+			if (LPOOL.isDetectingIntersect()) {
+				return luaL_error(vm, "invalid operation");
+			}
+			std::pmr::vector<GameObjectPool::IntersectionDetectionGroupPair> group_pairs{ &LAPP.GetFrameArena() };
+			if (!lua_isnoneornil(vm, 1)) {
+				luaL_checktype(vm, 1, LUA_TTABLE);
+				readGroupPairs(vm, 1, group_pairs);
+			}
+			LPOOL.setCollisionMatrix(group_pairs);
+			return 0;
+		}
+		static int getCollisionGroupCount(lua_State* const vm) {
+			lua::stack_t const ctx(vm);
+			ctx.push_value(static_cast<int32_t>(LPOOL.getGroupCount()));
+			return 1;
+		}
+		static int setCollisionGroupCount(lua_State* const vm) {
+			auto const count = luaL_checkinteger(vm, 1);
+			if (count < 1 || count > LOBJPOOL_GROUPN) {
+				return luaL_error(vm, "invalid argument #1, required 1 <= count <= %d.", LOBJPOOL_GROUPN);
+			}
+			if (LPOOL.isDetectingIntersect()) {
+				return luaL_error(vm, "invalid operation");
+			}
+			if (!LPOOL.setGroupCount(static_cast<size_t>(count))) {
+				return luaL_error(vm, "collision groups to be removed still contain objects.");
+			}
+			return 0;
+		}
+		// 空间查询
+
+		static uint32_t checkQueryGroup(lua_State* const vm, int const index) {
+			auto const group = luaL_checkinteger(vm, index);
+			if (group < 0 || group >= static_cast<lua_Integer>(LPOOL.getGroupCount())) {
+				luaL_error(vm, "invalid argument #%d, required 0 <= group <= %d.", index, static_cast<int>(LPOOL.getGroupCount()) - 1);
+			}
+			return static_cast<uint32_t>(group);
+		}
+		static void pushQueryObject(lua_State* const vm, luastg::GameObject* const object) {
+			if (object == nullptr) {
+				lua_pushnil(vm);
+				return;
+			}
+			pushGameObjectTable(vm);										// ... t
+			lua_rawgeti(vm, -1, static_cast<int>(object->id + 1));			// ... t object
+			lua_remove(vm, -2);												// ... object
+		}
+		// 返回结果表和对象数量，传入的表会被复用，多余的旧元素会被清除
+		static int pushQueryResult(lua_State* const vm, std::vector<luastg::GameObject*> const& result, int const output_index) {
+			auto const count = static_cast<int>(result.size());
+			if (lua_istable(vm, output_index)) {
+				lua_pushvalue(vm, output_index);							// ... r
+			}
+			else {
+				lua_createtable(vm, count, 0);								// ... r
+			}
+			pushGameObjectTable(vm);										// ... r t
+			for (int i = 0; i < count; i += 1) {
+				lua_rawgeti(vm, -1, static_cast<int>(result[i]->id + 1));	// ... r t object
+				lua_rawseti(vm, -3, i + 1);									// ... r t
+			}
+			lua_pop(vm, 1);													// ... r
+			for (int i = count + 1;; i += 1) {
+				lua_rawgeti(vm, -1, i);										// ... r v
+				auto const end = lua_isnil(vm, -1);
+				lua_pop(vm, 1);												// ... r
+				if (end) {
+					break;
+				}
+				lua_pushnil(vm);											// ... r nil
+				lua_rawseti(vm, -2, i);										// ... r
+			}
+			lua_pushinteger(vm, count);										// ... r n
+			return 2;
+		}
+		static int queryNearest(lua_State* const vm) {
+			auto const group = checkQueryGroup(vm, 1);
+			auto const x = luaL_checknumber(vm, 2);
+			auto const y = luaL_checknumber(vm, 3);
+			auto const max_distance = luaL_optnumber(vm, 4, std::numeric_limits<double>::infinity());
+			pushQueryObject(vm, LPOOL.queryNearest(group, x, y, max_distance));
+			return 1;
+		}
+		static int queryCircle(lua_State* const vm) {
+			auto const group = checkQueryGroup(vm, 1);
+			auto const x = luaL_checknumber(vm, 2);
+			auto const y = luaL_checknumber(vm, 3);
+			auto const r = luaL_checknumber(vm, 4);
+			return pushQueryResult(vm, LPOOL.queryCircle(group, x, y, r), 5);
+		}
+		static int queryRect(lua_State* const vm) {
+			auto const group = checkQueryGroup(vm, 1);
+			auto const left = luaL_checknumber(vm, 2);
+			auto const right = luaL_checknumber(vm, 3);
+			auto const bottom = luaL_checknumber(vm, 4);
+			auto const top = luaL_checknumber(vm, 5);
+			return pushQueryResult(vm, LPOOL.queryRect(group, left, right, bottom, top), 6);
+		}
+		static int queryOBB(lua_State* const vm) {
+			auto const group = checkQueryGroup(vm, 1);
+			auto const x = luaL_checknumber(vm, 2);
+			auto const y = luaL_checknumber(vm, 3);
+			auto const a = luaL_checknumber(vm, 4);
+			auto const b = luaL_checknumber(vm, 5);
+			auto const rot = luaL_checknumber(vm, 6) * L_DEG_TO_RAD;
+			return pushQueryResult(vm, LPOOL.queryOBB(group, x, y, a, b, rot), 7);
+		}
+		static int querySegment(lua_State* const vm) {
+			auto const group = checkQueryGroup(vm, 1);
+			auto const x1 = luaL_checknumber(vm, 2);
+			auto const y1 = luaL_checknumber(vm, 3);
+			auto const x2 = luaL_checknumber(vm, 4);
+			auto const y2 = luaL_checknumber(vm, 5);
+			auto const half_width = luaL_optnumber(vm, 6, 0.0);
+			pushQueryObject(vm, LPOOL.querySegment(group, x1, y1, x2, y2, half_width));
+			return 1;
+		}
+
+		// 父子附着
+
+		static luastg::GameObjectAttachmentTransform checkAttachmentTransform(lua_State* const vm, int const index) {
+			return luastg::GameObjectAttachmentTransform{
+				.x = luaL_optnumber(vm, index, 0.0),
+				.y = luaL_optnumber(vm, index + 1, 0.0),
+				.rot = luaL_optnumber(vm, index + 2, 0.0) * L_DEG_TO_RAD,
+				.hscale = luaL_optnumber(vm, index + 3, 1.0),
+				.vscale = luaL_optnumber(vm, index + 4, 1.0),
+			};
+		}
+		static int attachObject(lua_State* const vm) {
+			auto const child = as(vm, 1);
+			auto const parent = as(vm, 2);
+			auto const transform = checkAttachmentTransform(vm, 3);
+			auto const detach_on_parent_free = lua_toboolean(vm, 8) != 0;
+			if (!LPOOL.attachObject(child, parent, transform, detach_on_parent_free)) {
+				return luaL_error(vm, "cannot attach to an inactive object or to the object itself and its descendants.");
+			}
+			return 0;
+		}
+		static int detachObject(lua_State* const vm) {
+			auto const child = as(vm, 1);
+			LPOOL.detachObject(child);
+			return 0;
+		}
+		static int getObjectParent(lua_State* const vm) {
+			auto const child = as(vm, 1);
+			pushQueryObject(vm, LPOOL.getAttachmentParent(child));
+			return 1;
+		}
+		static int setAttachmentTransform(lua_State* const vm) {
+			auto const child = as(vm, 1);
+			if (child->attachment == nullptr) {
+				return luaL_error(vm, "object is not attached.");
+			}
+			child->attachment->transform = checkAttachmentTransform(vm, 2);
+			return 0;
+		}
+
 		static int getUpdateListFirst(lua_State* const vm) {
 			if (auto const object = LPOOL.getUpdateListFirst(); object == nullptr) {
 				lua_pushinteger(vm, 0);
@@ -1057,6 +1851,28 @@ namespace luastg::binding {
 		return 1;
 	}
 
+	bool GameObject::isBatchRunning() {
+		return !GameObjectManagerCallbacks::getInstance().game_object_tables_index.empty();
+	}
+
+	void GameObject::rebindParticlePool([[maybe_unused]] lua_State* const vm, [[maybe_unused]] int const idx, [[maybe_unused]] luastg::GameObject const* const object) {
+	#ifdef LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
+		// 快照中的同一个对象继续使用原来的粒子池，此时绑定仍然有效；重新创建的粒子池需要新的绑定
+		lua_rawgeti(vm, idx, 4);								// ... rc
+		auto const bound = isParticlePoolBinding(vm, -1) ? ParticleSystem::Cast(vm, -1) : nullptr;
+		lua_pop(vm, 1);										// ...
+		if (bound != nullptr && object != nullptr && object->features.is_render_class && object->hasParticlePool() && bound->ptr == object->ps) {
+			return;
+		}
+		if (bound != nullptr) {
+			releaseParticlePoolBinding(object, vm, idx);
+		}
+		if (object != nullptr) {
+			changeParticlePoolBinding(object, vm, idx);
+		}
+	#endif // LUASTG_GAME_OBJECT_PARTICLE_SYSTEM_OBJECT
+	}
+
 	void GameObject::registerClass(lua_State* const vm) {
 		lua::stack_balancer_t sb(vm);
 		lua::stack_t const ctx(vm);
@@ -1070,8 +1886,9 @@ namespace luastg::binding {
 		lua_settable(vm, LUA_REGISTRYINDEX);
 
 		lua_pushlightuserdata(vm, &game_object_tables_key);
-		auto const objects_table = ctx.create_array(LOBJPOOL_SIZE + 1); // TODO: 移除兼容代码
-		ctx.set_array_value(objects_table, LOBJPOOL_SIZE + 1, meta_table);
+		auto const capacity = static_cast<int32_t>(LPOOL.getCapacity());
+		auto const objects_table = ctx.create_array(static_cast<size_t>(std::min(capacity, LOBJPOOL_SIZE)) + 1);
+		ctx.set_array_value(objects_table, capacity + 1, meta_table); // TODO: 移除兼容代码
 		lua_settable(vm, LUA_REGISTRYINDEX);
 
 		auto const lstg_table = ctx.push_module("lstg"sv);
@@ -1088,20 +1905,41 @@ namespace luastg::binding {
 		ctx.set_map_value(lstg_table, "BoxCheck"sv, &GameObjectBinding::isInRect);
 		ctx.set_map_value(lstg_table, "ColliCheck"sv, &GameObjectBinding::isIntersect);
 		ctx.set_map_value(lstg_table, "_New"sv, &GameObjectBinding::allocateAndManage);
+		ctx.set_map_value(lstg_table, "NewBatch"sv, &GameObjectBinding::allocateAndManageBatch);
+		ctx.set_map_value(lstg_table, "GetObjectFFIDeclaration"sv, &GameObjectBinding::getFFIDeclaration);
+		ctx.set_map_value(lstg_table, "SetObjectCallbackProfilerEnable"sv, &GameObjectBinding::setCallbackProfilerEnable);
+		ctx.set_map_value(lstg_table, "ResetObjectCallbackProfiler"sv, &GameObjectBinding::resetCallbackProfiler);
+		ctx.set_map_value(lstg_table, "GetObjectCallbackProfile"sv, &GameObjectBinding::getCallbackProfile);
+		ctx.set_map_value(lstg_table, "GetObjectPointer"sv, &GameObjectBinding::getObjectPointer);
 		ctx.set_map_value(lstg_table, "ResetObject"sv, &GameObjectBinding::dirtyReset); // TODO: WTF?
 		ctx.set_map_value(lstg_table, "_Del"sv, &GameObjectBinding::queueToFree);
 		ctx.set_map_value(lstg_table, "_Kill"sv, &GameObjectBinding::queueToFreeLegacyKillMode);
 		ctx.set_map_value(lstg_table, "AfterFrame"sv, &GameObjectBinding::updateNext);
 		ctx.set_map_value(lstg_table, "ResetPool"sv, &GameObjectBinding::resetGameObjectManager);
+		ctx.set_map_value(lstg_table, "GetObjectPoolCapacity"sv, &GameObjectBinding::getGameObjectManagerCapacity);
+		ctx.set_map_value(lstg_table, "SetObjectPoolCapacity"sv, &GameObjectBinding::setGameObjectManagerCapacity);
 		ctx.set_map_value(lstg_table, "ObjFrame"sv, &GameObjectBinding::updateGameObjectManager);
 		ctx.set_map_value(lstg_table, "ObjRender"sv, &GameObjectBinding::renderGameObjectManager);
 		ctx.set_map_value(lstg_table, "BoundCheck"sv, &GameObjectBinding::boundCheckGameObjectManager);
 		ctx.set_map_value(lstg_table, "CollisionCheck"sv, &GameObjectBinding::intersectDetectGameObjectManager);
+		ctx.set_map_value(lstg_table, "CollisionCheckMatrix"sv, &GameObjectBinding::intersectDetectMatrixGameObjectManager);
+		ctx.set_map_value(lstg_table, "SetCollisionMatrix"sv, &GameObjectBinding::setCollisionMatrix);
+		ctx.set_map_value(lstg_table, "GetCollisionGroupCount"sv, &GameObjectBinding::getCollisionGroupCount);
+		ctx.set_map_value(lstg_table, "SetCollisionGroupCount"sv, &GameObjectBinding::setCollisionGroupCount);
 		ctx.set_map_value(lstg_table, "_UpdateListFirst"sv, &GameObjectBinding::getUpdateListFirst);
 		ctx.set_map_value(lstg_table, "_UpdateListNext"sv, &GameObjectBinding::getUpdateListNext);
 		ctx.set_map_value(lstg_table, "_DetectListFirst"sv, &GameObjectBinding::getDetectListFirst);
 		ctx.set_map_value(lstg_table, "_DetectListNext"sv, &GameObjectBinding::getDetectListNext);
 		ctx.set_map_value(lstg_table, "IsValid"sv, &GameObjectBinding::isValid);
+		ctx.set_map_value(lstg_table, "QueryNearestObject"sv, &GameObjectBinding::queryNearest);
+		ctx.set_map_value(lstg_table, "QueryObjectsInCircle"sv, &GameObjectBinding::queryCircle);
+		ctx.set_map_value(lstg_table, "QueryObjectsInRect"sv, &GameObjectBinding::queryRect);
+		ctx.set_map_value(lstg_table, "QueryObjectsInOBB"sv, &GameObjectBinding::queryOBB);
+		ctx.set_map_value(lstg_table, "QueryFirstObjectOnSegment"sv, &GameObjectBinding::querySegment);
+		ctx.set_map_value(lstg_table, "AttachObject"sv, &GameObjectBinding::attachObject);
+		ctx.set_map_value(lstg_table, "DetachObject"sv, &GameObjectBinding::detachObject);
+		ctx.set_map_value(lstg_table, "GetObjectParent"sv, &GameObjectBinding::getObjectParent);
+		ctx.set_map_value(lstg_table, "SetAttachmentTransform"sv, &GameObjectBinding::setAttachmentTransform);
 		ctx.set_map_value(lstg_table, "ObjTable"sv, &pushGameObjectTable);
 
 		LPOOL.addCallbacks(&GameObjectManagerCallbacks::getInstance());
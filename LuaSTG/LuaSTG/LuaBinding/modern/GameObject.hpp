@@ -14,6 +14,12 @@ namespace luastg::binding {
 
 		static int pushGameObjectTable(lua_State* vm);
 
+		// 对象池是否正在执行会调用 lua 回调的批量过程
+		static bool isBatchRunning();
+
+		// 快照恢复后重新绑定对象表（位于 idx）中的粒子池对象 object[4]，object 为空时只解除绑定
+		static void rebindParticlePool(lua_State* vm, int idx, luastg::GameObject const* object);
+
 		static void registerClass(lua_State* vm);
 
 	};
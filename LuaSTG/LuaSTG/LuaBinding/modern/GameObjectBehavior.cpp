@@ -0,0 +1,201 @@
+#include "LuaBinding/modern/GameObjectBehavior.hpp"
+#include "LuaBinding/modern/GameObject.hpp"
+#include "lua/plus.hpp"
+
+using std::string_view_literals::operator ""sv;
+
+namespace {
+	using luastg::GameObjectBehaviorOp;
+	using luastg::GameObjectBehaviorInstruction;
+
+	// 读取指令表中的参数，指令表位于栈顶
+	double getInstructionNumber(lua_State* const vm, int const index, int const argument, std::optional<double> const default_value = std::nullopt) {
+		lua_rawgeti(vm, -1, argument);
+		if (lua_isnil(vm, -1) && default_value.has_value()) {
+			lua_pop(vm, 1);
+			return *default_value;
+		}
+		if (!lua_isnumber(vm, -1)) {
+			luaL_error(vm, "invalid behavior instruction #%d, argument #%d must be a number.", index, argument - 1);
+		}
+		auto const value = lua_tonumber(vm, -1);
+		lua_pop(vm, 1);
+		return value;
+	}
+	uint32_t getInstructionFrames(lua_State* const vm, int const index, int const argument, std::optional<double> const default_value = std::nullopt) {
+		auto const value = getInstructionNumber(vm, index, argument, default_value);
+		if (!(value >= 0.0 && value <= static_cast<double>(std::numeric_limits<uint32_t>::max()))) {
+			luaL_error(vm, "invalid behavior instruction #%d, frames must be a non-negative integer.", index);
+		}
+		return static_cast<uint32_t>(value);
+	}
+
+	GameObjectBehaviorInstruction parseInstruction(lua_State* const vm, int const index) {
+		lua_rawgeti(vm, -1, 1);
+		if (!lua_isstring(vm, -1)) {
+			luaL_error(vm, "invalid behavior instruction #%d, instruction name required.", index);
+		}
+		std::string_view const name(lua_tostring(vm, -1));
+		lua_pop(vm, 1);
+
+		GameObjectBehaviorInstruction instruction;
+		if (name == "wait"sv) {
+			instruction.op = GameObjectBehaviorOp::Wait;
+			instruction.frames = getInstructionFrames(vm, index, 2);
+		}
+		else if (name == "speed"sv) {
+			instruction.op = GameObjectBehaviorOp::SetSpeed;
+			instruction.value0 = getInstructionNumber(vm, index, 2);
+		}
+		else if (name == "angle"sv) {
+			instruction.op = GameObjectBehaviorOp::SetAngle;
+			instruction.value0 = getInstructionNumber(vm, index, 2) * L_DEG_TO_RAD;
+		}
+		else if (name == "velocity"sv) {
+			instruction.op = GameObjectBehaviorOp::SetVelocity;
+			instruction.value0 = getInstructionNumber(vm, index, 2);
+			instruction.value1 = getInstructionNumber(vm, index, 3) * L_DEG_TO_RAD;
+		}
+		else if (name == "accelerate"sv) {
+			instruction.op = GameObjectBehaviorOp::Accelerate;
+			instruction.value0 = getInstructionNumber(vm, index, 2);
+			instruction.value1 = getInstructionNumber(vm, index, 3);
+			if (!(instruction.value0 >= 0.0) || !(instruction.value1 > 0.0)) {
+				luaL_error(vm, "invalid behavior instruction #%d, required speed >= 0 and step > 0.", index);
+			}
+		}
+		else if (name == "turn"sv) {
+			instruction.op = GameObjectBehaviorOp::Turn;
+			auto const omega = getInstructionNumber(vm, index, 2) * L_DEG_TO_RAD;
+			instruction.value0 = std::cos(omega);
+			instruction.value1 = std::sin(omega);
+			instruction.frames = getInstructionFrames(vm, index, 3, 0.0);
+		}
+		else if (name == "aim"sv) {
+			instruction.op = GameObjectBehaviorOp::Aim;
+			instruction.value0 = getInstructionNumber(vm, index, 2, 0.0) * L_DEG_TO_RAD;
+		}
+		else if (name == "homing"sv) {
+			instruction.op = GameObjectBehaviorOp::Homing;
+			instruction.value0 = std::abs(getInstructionNumber(vm, index, 2)) * L_DEG_TO_RAD;
+			instruction.frames = getInstructionFrames(vm, index, 3, 0.0);
+		}
+		else if (name == "fade"sv) {
+			instruction.op = GameObjectBehaviorOp::Fade;
+			instruction.value0 = std::clamp(getInstructionNumber(vm, index, 2), 0.0, 255.0);
+			instruction.frames = getInstructionFrames(vm, index, 3, 0.0);
+		}
+		else if (name == "del"sv) {
+			instruction.op = GameObjectBehaviorOp::Delete;
+		}
+		else {
+			luaL_error(vm, "invalid behavior instruction #%d, unknown instruction '%s'.", index, name.data());
+		}
+		return instruction;
+	}
+}
+
+namespace luastg::binding {
+	std::string_view const GameObjectBehavior::class_name{ "lstg.GameObjectBehavior" };
+
+	struct GameObjectBehaviorBinding : GameObjectBehavior {
+		// meta methods
+
+		// NOLINTBEGIN(*-reserved-identifier)
+
+		static int __gc(lua_State* const vm) {
+			if (auto const self = as(vm, 1); self->data) {
+				self->data->release();
+				self->data = nullptr;
+			}
+			return 0;
+		}
+		static int __tostring(lua_State* const vm) {
+			lua::stack_t const ctx(vm);
+			[[maybe_unused]] auto const self = as(vm, 1);
+			ctx.push_value(class_name);
+			return 1;
+		}
+
+		// NOLINTEND(*-reserved-identifier)
+
+		// static method
+
+		static int create(lua_State* const vm) {
+			luaL_checktype(vm, 1, LUA_TTABLE);
+			auto const count = static_cast<int>(lua_objlen(vm, 1));
+			std::vector<GameObjectBehaviorInstruction> instructions;
+			instructions.reserve(static_cast<size_t>(count));
+			for (int i = 1; i <= count; i += 1) {
+				lua_rawgeti(vm, 1, i);					// ... instruction
+				if (!lua_istable(vm, -1)) {
+					return luaL_error(vm, "invalid behavior instruction #%d, table required.", i);
+				}
+				instructions.push_back(parseInstruction(vm, i));
+				lua_pop(vm, 1);							// ...
+			}
+			auto const self = GameObjectBehavior::create(vm);
+			self->data = new GameObjectBehaviorProgram(std::move(instructions));
+			return 1;
+		}
+		static int setObjectBehavior(lua_State* const vm) {
+			auto const object = luastg::binding::GameObject::as(vm, 1);
+			if (lua_isnoneornil(vm, 2)) {
+				object->clearBehavior();
+				return 0;
+			}
+			auto const self = as(vm, 2);
+			auto const exclusive = lua_toboolean(vm, 3) != 0;
+			object->setBehavior(self->data, exclusive);
+			if (!lua_isnoneornil(vm, 4)) {
+				object->setBehaviorTarget(luastg::binding::GameObject::as(vm, 4));
+			}
+			return 0;
+		}
+		static int setObjectBehaviorTarget(lua_State* const vm) {
+			auto const object = luastg::binding::GameObject::as(vm, 1);
+			object->setBehaviorTarget(lua_isnoneornil(vm, 2) ? nullptr : luastg::binding::GameObject::as(vm, 2));
+			return 0;
+		}
+		static int isObjectBehaviorRunning(lua_State* const vm) {
+			auto const object = luastg::binding::GameObject::as(vm, 1);
+			lua_pushboolean(vm, object->behavior != nullptr);
+			return 1;
+		}
+	};
+
+	bool GameObjectBehavior::is(lua_State* const vm, int const index) {
+		lua::stack_t const ctx(vm);
+		return ctx.is_metatable(index, class_name);
+	}
+	GameObjectBehavior* GameObjectBehavior::as(lua_State* const vm, int const index) {
+		lua::stack_t const ctx(vm);
+		return ctx.as_userdata<GameObjectBehavior>(index);
+	}
+	GameObjectBehavior* GameObjectBehavior::create(lua_State* const vm) {
+		lua::stack_t const ctx(vm);
+		auto const self = ctx.create_userdata<GameObjectBehavior>();
+		auto const self_index = ctx.index_of_top();
+		ctx.set_metatable(self_index, class_name);
+		self->data = nullptr;
+		return self;
+	}
+	void GameObjectBehavior::registerClass(lua_State* const vm) {
+		[[maybe_unused]] lua::stack_balancer_t stack_balancer(vm);
+		lua::stack_t const ctx(vm);
+
+		// metatable
+
+		auto const metatable = ctx.create_metatable(class_name);
+		ctx.set_map_value(metatable, "__gc", &GameObjectBehaviorBinding::__gc);
+		ctx.set_map_value(metatable, "__tostring", &GameObjectBehaviorBinding::__tostring);
+
+		// lstg
+
+		auto const lstg_table = ctx.push_module("lstg"sv);
+		ctx.set_map_value(lstg_table, "CreateObjectBehavior"sv, &GameObjectBehaviorBinding::create);
+		ctx.set_map_value(lstg_table, "SetObjectBehavior"sv, &GameObjectBehaviorBinding::setObjectBehavior);
+		ctx.set_map_value(lstg_table, "SetObjectBehaviorTarget"sv, &GameObjectBehaviorBinding::setObjectBehaviorTarget);
+		ctx.set_map_value(lstg_table, "IsObjectBehaviorRunning"sv, &GameObjectBehaviorBinding::isObjectBehaviorRunning);
+	}
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include "lua.hpp"
+#include "GameObject/GameObjectBehavior.hpp"
+
+namespace luastg::binding {
+	struct GameObjectBehavior {
+		static std::string_view const class_name;
+
+		[[maybe_unused]] luastg::GameObjectBehaviorProgram* data{};
+
+		static bool is(lua_State* vm, int index);
+		static GameObjectBehavior* as(lua_State* vm, int index);
+		static GameObjectBehavior* create(lua_State* vm);
+		static void registerClass(lua_State* vm);
+	};
+}
@@ -0,0 +1,236 @@
+#include "LuaBinding/modern/GameObjectSnapshot.hpp"
+#include "LuaBinding/modern/GameObject.hpp"
+#include "lua/plus.hpp"
+#include "AppFrame.h"
+
+using std::string_view_literals::operator ""sv;
+
+namespace {
+	std::byte game_object_snapshot_callbacks_key{};
+
+	// 快照的环境表中保存的 lua 侧数据
+	constexpr int snapshot_object_tables{ 1 }; // 记录时对象表的浅拷贝，按槽位索引 + 1 存储
+	constexpr int snapshot_user_data{ 2 }; // 保存回调的返回值
+
+	// 获取快照的环境表，没有时创建，环境表位于栈顶
+	void pushSnapshotEnvironment(lua_State* const vm, int const index) {
+		lua_getfenv(vm, index);								// ... env
+		if (lua_istable(vm, -1)) {
+			return;
+		}
+		lua_pop(vm, 1);										// ...
+		lua_createtable(vm, 2, 0);							// ... env
+		lua_pushvalue(vm, -1);								// ... env env
+		lua_setfenv(vm, index);								// ... env
+	}
+
+	// 调用保存或恢复回调，回调不存在时什么都不做
+	void callSnapshotCallback(lua_State* const vm, int const callback, int const snapshot, int const environment, bool const save) {
+		lua_pushlightuserdata(vm, &game_object_snapshot_callbacks_key);
+		lua_gettable(vm, LUA_REGISTRYINDEX);				// ... callbacks
+		if (!lua_istable(vm, -1)) {
+			lua_pop(vm, 1);
+			return;
+		}
+		lua_rawgeti(vm, -1, callback);						// ... callbacks f
+		if (!lua_isfunction(vm, -1)) {
+			lua_pop(vm, 2);
+			return;
+		}
+		lua_pushvalue(vm, snapshot);						// ... callbacks f snapshot
+		if (save) {
+			lua_call(vm, 1, 1);								// ... callbacks data
+			lua_rawseti(vm, environment, snapshot_user_data);	// ... callbacks
+		}
+		else {
+			lua_rawgeti(vm, environment, snapshot_user_data);	// ... callbacks f snapshot data
+			lua_call(vm, 2, 0);								// ... callbacks
+		}
+		lua_pop(vm, 1);										// ...
+	}
+}
+
+namespace luastg::binding {
+	std::string_view const GameObjectSnapshot::class_name{ "lstg.GameObjectSnapshot" };
+
+	struct GameObjectSnapshotBinding : GameObjectSnapshot {
+		// meta methods
+
+		// NOLINTBEGIN(*-reserved-identifier)
+
+		static int __gc(lua_State* const vm) {
+			if (auto const self = as(vm, 1); self->data) {
+				delete self->data;
+				self->data = nullptr;
+			}
+			return 0;
+		}
+		static int __tostring(lua_State* const vm) {
+			lua::stack_t const ctx(vm);
+			[[maybe_unused]] auto const self = as(vm, 1);
+			ctx.push_value(class_name);
+			return 1;
+		}
+
+		// NOLINTEND(*-reserved-identifier)
+
+		// static method
+
+		static int create(lua_State* const vm) {
+			auto const self = GameObjectSnapshot::create(vm);
+			self->data = new luastg::GameObjectPoolSnapshot(LPOOL.getCapacity());
+			return 1;
+		}
+		static int save(lua_State* const vm) {
+			auto const self = as(vm, 1);
+			if (luastg::binding::GameObject::isBatchRunning() || !LPOOL.captureSnapshot(*self->data)) {
+				return luaL_error(vm, "cannot save snapshot while the object pool is updating, rendering or detecting.");
+			}
+			lua_settop(vm, 1);
+			pushSnapshotEnvironment(vm, 1);						// snapshot env
+			auto const environment = lua_gettop(vm);
+
+			// 对象表的浅拷贝，对象表中的字段由保存回调负责
+			lua_rawgeti(vm, environment, snapshot_object_tables);	// snapshot env copy
+			if (!lua_istable(vm, -1)) {
+				lua_pop(vm, 1);
+				lua_createtable(vm, static_cast<int>(LPOOL.getCapacity()), 0);
+				lua_pushvalue(vm, -1);
+				lua_rawseti(vm, environment, snapshot_object_tables);
+			}
+			auto const copy = lua_gettop(vm);
+			GameObject::pushGameObjectTable(vm);				// snapshot env copy t
+			auto const objects_table = lua_gettop(vm);
+			auto const slot_count = self->data->slotCount();
+			for (size_t slot = 0; slot < slot_count; slot += 1) {
+				auto const lua_index = static_cast<int>(slot + 1);
+				if (self->data->used(slot)) {
+					lua_rawgeti(vm, objects_table, lua_index);
+				}
+				else {
+					lua_pushnil(vm);
+				}
+				lua_rawseti(vm, copy, lua_index);
+			}
+			lua_settop(vm, environment);						// snapshot env
+
+			callSnapshotCallback(vm, 1, 1, environment, true);
+			return 0;
+		}
+		static int load(lua_State* const vm) {
+			auto const self = as(vm, 1);
+			if (luastg::binding::GameObject::isBatchRunning() || !LPOOL.canSnapshot()) {
+				return luaL_error(vm, "cannot load snapshot while the object pool is updating, rendering or detecting.");
+			}
+			lua_settop(vm, 1);
+			pushSnapshotEnvironment(vm, 1);						// snapshot env
+			auto const environment = lua_gettop(vm);
+			lua_rawgeti(vm, environment, snapshot_object_tables);	// snapshot env copy
+			auto const copy = lua_gettop(vm);
+			if (!lua_istable(vm, copy) || !LPOOL.restoreSnapshot(*self->data)) {
+				return luaL_error(vm, "invalid snapshot, it has never been saved or the object pool capacity has changed.");
+			}
+
+			// 恢复对象表，不在快照中的对象的 lua 表会变为无效对象，粒子池绑定指向恢复后的粒子池
+			GameObject::pushGameObjectTable(vm);				// snapshot env copy t
+			auto const objects_table = lua_gettop(vm);
+			auto const slot_count = LPOOL.getSlotCount();
+			for (size_t slot = 0; slot < slot_count; slot += 1) {
+				auto const lua_index = static_cast<int>(slot + 1);
+				auto const object = LPOOL.GetPooledObject(slot);
+				lua_rawgeti(vm, objects_table, lua_index);		// ... current
+				if (object != nullptr) {
+					lua_rawgeti(vm, copy, lua_index);			// ... current restored
+				}
+				else {
+					lua_pushnil(vm);							// ... current nil
+				}
+				auto const restored = lua_gettop(vm);
+				if (lua_istable(vm, restored - 1) && !lua_rawequal(vm, restored, restored - 1)) {
+					lua_pushnil(vm);
+					lua_rawseti(vm, restored - 1, 3);			// current[3] = nil
+					GameObject::rebindParticlePool(vm, restored - 1, nullptr);
+				}
+				if (lua_istable(vm, restored)) {
+					lua_pushlightuserdata(vm, object);
+					lua_rawseti(vm, restored, 3);				// restored[3] = object
+					GameObject::rebindParticlePool(vm, restored, object);
+				}
+				lua_rawseti(vm, objects_table, lua_index);		// ... current
+				lua_pop(vm, 1);									// ...
+			}
+			lua_settop(vm, environment);						// snapshot env
+
+			callSnapshotCallback(vm, 2, 1, environment, false);
+			return 0;
+		}
+		static int clear(lua_State* const vm) {
+			auto const self = as(vm, 1);
+			self->data->clear();
+			lua_newtable(vm);
+			lua_setfenv(vm, 1);
+			return 0;
+		}
+		static int getInfo(lua_State* const vm) {
+			auto const self = as(vm, 1);
+			lua_pushinteger(vm, static_cast<lua_Integer>(self->data->size()));
+			lua_pushinteger(vm, static_cast<lua_Integer>(self->data->changedCount()));
+			lua_pushinteger(vm, static_cast<lua_Integer>(self->data->memoryUsage()));
+			return 3;
+		}
+		static int setCallbacks(lua_State* const vm) {
+			if (!lua_isnoneornil(vm, 1)) {
+				luaL_checktype(vm, 1, LUA_TFUNCTION);
+			}
+			if (!lua_isnoneornil(vm, 2)) {
+				luaL_checktype(vm, 2, LUA_TFUNCTION);
+			}
+			lua_settop(vm, 2);
+			lua_pushlightuserdata(vm, &game_object_snapshot_callbacks_key);
+			lua_createtable(vm, 2, 0);
+			lua_pushvalue(vm, 1);
+			lua_rawseti(vm, -2, 1);
+			lua_pushvalue(vm, 2);
+			lua_rawseti(vm, -2, 2);
+			lua_settable(vm, LUA_REGISTRYINDEX);
+			return 0;
+		}
+	};
+
+	bool GameObjectSnapshot::is(lua_State* const vm, int const index) {
+		lua::stack_t const ctx(vm);
+		return ctx.is_metatable(index, class_name);
+	}
+	GameObjectSnapshot* GameObjectSnapshot::as(lua_State* const vm, int const index) {
+		lua::stack_t const ctx(vm);
+		return ctx.as_userdata<GameObjectSnapshot>(index);
+	}
+	GameObjectSnapshot* GameObjectSnapshot::create(lua_State* const vm) {
+		lua::stack_t const ctx(vm);
+		auto const self = ctx.create_userdata<GameObjectSnapshot>();
+		auto const self_index = ctx.index_of_top();
+		ctx.set_metatable(self_index, class_name);
+		self->data = nullptr;
+		return self;
+	}
+	void GameObjectSnapshot::registerClass(lua_State* const vm) {
+		[[maybe_unused]] lua::stack_balancer_t stack_balancer(vm);
+		lua::stack_t const ctx(vm);
+
+		// metatable
+
+		auto const metatable = ctx.create_metatable(class_name);
+		ctx.set_map_value(metatable, "__gc", &GameObjectSnapshotBinding::__gc);
+		ctx.set_map_value(metatable, "__tostring", &GameObjectSnapshotBinding::__tostring);
+
+		// lstg
+
+		auto const lstg_table = ctx.push_module("lstg"sv);
+		ctx.set_map_value(lstg_table, "CreateWorldSnapshot"sv, &GameObjectSnapshotBinding::create);
+		ctx.set_map_value(lstg_table, "SaveWorldSnapshot"sv, &GameObjectSnapshotBinding::save);
+		ctx.set_map_value(lstg_table, "LoadWorldSnapshot"sv, &GameObjectSnapshotBinding::load);
+		ctx.set_map_value(lstg_table, "ClearWorldSnapshot"sv, &GameObjectSnapshotBinding::clear);
+		ctx.set_map_value(lstg_table, "GetWorldSnapshotInfo"sv, &GameObjectSnapshotBinding::getInfo);
+		ctx.set_map_value(lstg_table, "SetWorldSnapshotCallbacks"sv, &GameObjectSnapshotBinding::setCallbacks);
+	}
+}
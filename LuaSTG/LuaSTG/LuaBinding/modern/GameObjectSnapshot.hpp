@@ -0,0 +1,16 @@
+#pragma once
+#include "lua.hpp"
+#include "GameObject/GameObjectSnapshot.hpp"
+
+namespace luastg::binding {
+	struct GameObjectSnapshot {
+		static std::string_view const class_name;
+
+		[[maybe_unused]] luastg::GameObjectPoolSnapshot* data{};
+
+		static bool is(lua_State* vm, int index);
+		static GameObjectSnapshot* as(lua_State* vm, int index);
+		static GameObjectSnapshot* create(lua_State* vm);
+		static void registerClass(lua_State* vm);
+	};
+}
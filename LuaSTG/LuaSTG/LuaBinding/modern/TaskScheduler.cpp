@@ -0,0 +1,280 @@
+#include "TaskScheduler.hpp"
+#include "LuaBinding/modern/GameObject.hpp"
+#include "GameObject/GameObjectPool.h"
+#include "AppFrame.h"
+#include "lua/plus.hpp"
+
+namespace {
+	// 时间轮：任务按唤醒帧放入对应槽位，每帧只检查一个槽位
+	// 等待时间超过一圈的任务会在每圈被检查一次，然后放回原槽位
+	constexpr uint32_t wheel_size{ 256 };
+	constexpr uint32_t no_task{ std::numeric_limits<uint32_t>::max() };
+
+	struct Task {
+		lua_State* thread{};
+		int thread_ref{ LUA_NOREF };
+		bool has_owner{};
+		bool cancelled{};
+		size_t owner_id{};
+		uint64_t owner_unique_id{};
+		uint64_t wake_tick{};
+		int64_t wait{};
+		uint32_t next{ no_task }; // 槽位链表或空闲链表中的下一个任务
+	};
+
+	struct Slot {
+		uint32_t first{ no_task };
+		uint32_t last{ no_task };
+	};
+
+	class Scheduler {
+	public:
+		Scheduler() {
+			m_tasks.reserve(256);
+		}
+
+		// 创建任务，函数位于栈顶，返回任务对应的协程
+		lua_State* create(lua_State* const vm, luastg::GameObject const* const owner) {
+			auto const thread = lua_newthread(vm);			// ... f co
+			lua_pushvalue(vm, -2);							// ... f co f
+			lua_xmove(vm, thread, 1);						// ... f co
+			lua_pushvalue(vm, -1);							// ... f co co
+			auto const thread_ref = luaL_ref(vm, LUA_REGISTRYINDEX); // ... f co
+
+			auto const index = allocate();
+			auto& task = m_tasks[index];
+			task.thread = thread;
+			task.thread_ref = thread_ref;
+			task.has_owner = owner != nullptr;
+			task.owner_id = owner != nullptr ? static_cast<size_t>(owner->id) : 0;
+			task.owner_unique_id = owner != nullptr ? static_cast<uint64_t>(owner->unique_id) : 0;
+			// 更新过程中创建的任务从下一帧开始执行，与在 frame 回调中调用 task.New 一致
+			schedule(index, m_updating ? m_tick + 1 : m_tick);
+			m_count += 1;
+			return thread;
+		}
+
+		// 只能在任务自身的协程中调用
+		[[nodiscard]] bool isCurrentTask(lua_State* const vm) const noexcept {
+			return m_current != no_task && m_tasks[m_current].thread == vm;
+		}
+
+		void setCurrentTaskWait(int64_t const wait) noexcept {
+			m_tasks[m_current].wait = std::max<int64_t>(wait, 1);
+		}
+
+		void update(lua_State* const vm) {
+			if (m_updating) {
+				luaL_error(vm, "lstg.Task.Update cannot be called recursively.");
+				return;
+			}
+			m_updating = true;
+			auto& slot = m_wheel[m_tick % wheel_size];
+			auto index = slot.first;
+			slot = {};
+			while (index != no_task) {
+				auto const next = m_tasks[index].next;
+				m_tasks[index].next = no_task;
+				if (m_tasks[index].cancelled || !isOwnerAlive(m_tasks[index])) {
+					release(vm, index);
+				}
+				else if (m_tasks[index].wake_tick > m_tick) {
+					append(index, m_tick);
+				}
+				else if (!resume(vm, index)) {
+					// 出错时剩余的到期任务推迟到下一帧，等待超过一圈的任务放回唤醒帧对应的槽位，然后把错误抛给调用者
+					for (auto rest = next; rest != no_task;) {
+						auto const rest_next = m_tasks[rest].next;
+						m_tasks[rest].next = no_task;
+						append(rest, std::max(m_tasks[rest].wake_tick, m_tick + 1));
+						rest = rest_next;
+					}
+					m_tick += 1;
+					m_updating = false;
+					lua_error(vm);
+					return;
+				}
+				index = next;
+			}
+			m_tick += 1;
+			m_updating = false;
+		}
+
+		// 取消任务，owner 为空时取消所有任务
+		void clear(lua_State* const vm, luastg::GameObject const* const owner) {
+			for (auto& task : m_tasks) {
+				if (task.thread == nullptr || task.cancelled) {
+					continue;
+				}
+				if (owner != nullptr && !(task.has_owner && task.owner_id == owner->id && task.owner_unique_id == owner->unique_id)) {
+					continue;
+				}
+				// 任务可能在时间轮中或正在执行，只释放协程，节点在下一次遇到时回收
+				luaL_unref(vm, LUA_REGISTRYINDEX, task.thread_ref);
+				task.thread_ref = LUA_NOREF;
+				task.cancelled = true;
+				m_count -= 1;
+			}
+		}
+
+		[[nodiscard]] size_t count() const noexcept { return m_count; }
+
+		static Scheduler& getInstance() {
+			static Scheduler instance;
+			return instance;
+		}
+
+	private:
+		[[nodiscard]] static bool isOwnerAlive(Task const& task) noexcept {
+			if (!task.has_owner) {
+				return true;
+			}
+			auto const owner = LPOOL.GetPooledObject(task.owner_id);
+			return owner != nullptr && owner->unique_id == task.owner_unique_id && owner->status == luastg::GameObjectStatus::Active;
+		}
+
+		uint32_t allocate() {
+			if (m_free != no_task) {
+				auto const index = m_free;
+				m_free = m_tasks[index].next;
+				m_tasks[index] = {};
+				return index;
+			}
+			m_tasks.emplace_back();
+			return static_cast<uint32_t>(m_tasks.size() - 1);
+		}
+
+		void release(lua_State* const vm, uint32_t const index) {
+			auto& task = m_tasks[index];
+			if (!task.cancelled) {
+				luaL_unref(vm, LUA_REGISTRYINDEX, task.thread_ref);
+				m_count -= 1;
+			}
+			task = {};
+			task.next = m_free;
+			m_free = index;
+		}
+
+		void schedule(uint32_t const index, uint64_t const wake_tick) {
+			m_tasks[index].wake_tick = wake_tick;
+			append(index, wake_tick);
+		}
+
+		void append(uint32_t const index, uint64_t const tick) {
+			auto& slot = m_wheel[tick % wheel_size];
+			if (slot.last == no_task) {
+				slot.first = index;
+			}
+			else {
+				m_tasks[slot.last].next = index;
+			}
+			slot.last = index;
+		}
+
+		// 恢复任务，出错时错误信息位于 vm 栈顶并返回 false
+		bool resume(lua_State* const vm, uint32_t const index) {
+			auto const thread = m_tasks[index].thread;
+			// 任务可能在执行过程中被取消，执行期间把协程放在栈上，避免被回收
+			lua_rawgeti(vm, LUA_REGISTRYINDEX, m_tasks[index].thread_ref);	// ... co
+			m_tasks[index].wait = 1; // 直接调用 coroutine.yield 时等待一帧
+			m_current = index;
+			auto const status = lua_resume(thread, 0);
+			m_current = no_task;
+			// 协程中可能创建了新任务，m_tasks 可能已经重新分配，不能保留引用
+			if (status != LUA_YIELD && status != 0) {
+				lua_xmove(thread, vm, 1);									// ... co message
+				lua_remove(vm, -2);											// ... message
+				release(vm, index);
+				return false;
+			}
+			lua_pop(vm, 1);													// ...
+			if (status == LUA_YIELD) {
+				lua_settop(thread, 0);
+				if (m_tasks[index].cancelled) {
+					release(vm, index);
+				}
+				else {
+					schedule(index, m_tick + static_cast<uint64_t>(m_tasks[index].wait));
+				}
+				return true;
+			}
+			release(vm, index);
+			return true;
+		}
+
+		std::vector<Task> m_tasks;
+		std::array<Slot, wheel_size> m_wheel{};
+		uint32_t m_free{ no_task };
+		uint32_t m_current{ no_task };
+		uint64_t m_tick{};
+		size_t m_count{};
+		bool m_updating{};
+	};
+}
+
+namespace luastg::binding {
+
+	std::string_view const TaskScheduler::class_name{ "lstg.Task" };
+
+	struct TaskSchedulerBinding : TaskScheduler {
+
+		// static methods
+
+		static int create(lua_State* const vm) {
+			// New(f) 创建不属于任何对象的任务
+			if (lua_isfunction(vm, 1) && lua_isnoneornil(vm, 2)) {
+				lua_settop(vm, 1);
+				Scheduler::getInstance().create(vm, nullptr);
+				return 1;
+			}
+			luastg::GameObject* owner{};
+			if (!lua_isnil(vm, 1)) {
+				owner = GameObject::as(vm, 1);
+			}
+			luaL_checktype(vm, 2, LUA_TFUNCTION);
+			lua_settop(vm, 2);
+			Scheduler::getInstance().create(vm, owner);
+			return 1;
+		}
+		static int wait(lua_State* const vm) {
+			auto& scheduler = Scheduler::getInstance();
+			if (!scheduler.isCurrentTask(vm)) {
+				return luaL_error(vm, "lstg.Task.Wait can only be called in a task created by lstg.Task.New.");
+			}
+			scheduler.setCurrentTaskWait(static_cast<int64_t>(luaL_optinteger(vm, 1, 1)));
+			return lua_yield(vm, 0);
+		}
+		static int update(lua_State* const vm) {
+			Scheduler::getInstance().update(vm);
+			return 0;
+		}
+		static int clear(lua_State* const vm) {
+			luastg::GameObject* owner{};
+			if (!lua_isnoneornil(vm, 1)) {
+				owner = GameObject::as(vm, 1);
+			}
+			Scheduler::getInstance().clear(vm, owner);
+			return 0;
+		}
+		static int getCount(lua_State* const vm) {
+			lua_pushinteger(vm, static_cast<lua_Integer>(Scheduler::getInstance().count()));
+			return 1;
+		}
+
+	};
+
+	void TaskScheduler::registerClass(lua_State* const vm) {
+		[[maybe_unused]] lua::stack_balancer_t const sb(vm);
+		lua::stack_t const ctx(vm);
+
+		// method
+
+		auto const method_table = ctx.create_module(class_name);
+		ctx.set_map_value(method_table, "New", &TaskSchedulerBinding::create);
+		ctx.set_map_value(method_table, "Wait", &TaskSchedulerBinding::wait);
+		ctx.set_map_value(method_table, "Update", &TaskSchedulerBinding::update);
+		ctx.set_map_value(method_table, "Clear", &TaskSchedulerBinding::clear);
+		ctx.set_map_value(method_table, "GetCount", &TaskSchedulerBinding::getCount);
+	}
+
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "lua.hpp"
+
+namespace luastg::binding {
+
+	struct TaskScheduler {
+
+		static std::string_view const class_name;
+
+		static void registerClass(lua_State* vm);
+
+	};
+
+}
@@ -0,0 +1,50 @@
+#include "Utility/CpuFeature.hpp"
+#include <cstdint>
+
+#ifdef LUASTG_CPU_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+	bool detectAvxSupport() noexcept {
+	#ifdef LUASTG_CPU_X86
+	#ifdef _MSC_VER
+		int info[4]{};
+		__cpuid(info, 1);
+		auto const ecx = static_cast<uint32_t>(info[2]);
+	#else
+		uint32_t eax{}, ebx{}, ecx{}, edx{};
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+			return false;
+		}
+	#endif
+		constexpr uint32_t osxsave_bit{ 1u << 27 };
+		constexpr uint32_t avx_bit{ 1u << 28 };
+		if ((ecx & osxsave_bit) == 0 || (ecx & avx_bit) == 0) {
+			return false;
+		}
+		// 操作系统需要保存 YMM 寄存器状态
+	#ifdef _MSC_VER
+		auto const xcr0 = _xgetbv(0);
+	#else
+		uint32_t xcr0_lo{}, xcr0_hi{};
+		__asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+		auto const xcr0 = (static_cast<uint64_t>(xcr0_hi) << 32) | xcr0_lo;
+	#endif
+		return (xcr0 & 0x6) == 0x6;
+	#else
+		return false;
+	#endif
+	}
+}
+
+namespace luastg {
+	bool isAvxSupported() noexcept {
+		static bool const supported{ detectAvxSupport() };
+		return supported;
+	}
+}
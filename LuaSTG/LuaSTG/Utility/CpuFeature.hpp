@@ -0,0 +1,17 @@
+#pragma once
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define LUASTG_CPU_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#define LUASTG_TARGET_AVX
+#else
+#define LUASTG_TARGET_AVX __attribute__((target("avx")))
+#endif
+#endif
+
+namespace luastg {
+	// 处理器和操作系统是否都支持 AVX 指令，结果在第一次调用时检测并缓存
+	// 非 x86 平台上永远返回 false
+	bool isAvxSupported() noexcept;
+}
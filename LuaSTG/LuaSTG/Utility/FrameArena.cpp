@@ -0,0 +1,66 @@
+#include "Utility/FrameArena.hpp"
+#include <algorithm>
+
+namespace luastg {
+	void FrameArena::beginFrame() noexcept {
+		auto const& previous = m_buffers[m_buffer_index];
+		m_statistics.used = previous.offset + previous.overflow;
+		m_statistics.overflow = previous.overflow;
+		m_statistics.high_water_mark = std::max(m_statistics.high_water_mark, m_statistics.used);
+		if (previous.overflow > 0) {
+			m_statistics.overflow_frames += 1;
+		}
+		m_buffer_index = (m_buffer_index + 1) % std::size(m_buffers);
+		resetBuffer(m_buffers[m_buffer_index]);
+	}
+
+	size_t FrameArena::getCurrentFrameUsage() const noexcept {
+		auto const& buffer = m_buffers[m_buffer_index];
+		return buffer.offset + buffer.overflow;
+	}
+
+	void* FrameArena::do_allocate(size_t const size, size_t const alignment) {
+		auto& buffer = m_buffers[m_buffer_index];
+		void* pointer = buffer.data.get() + buffer.offset;
+		auto space = m_capacity - buffer.offset;
+		if (std::align(alignment, size, pointer, space) != nullptr) {
+			buffer.offset = m_capacity - space + size;
+			return pointer;
+		}
+		// 缓冲区已经用完
+		pointer = std::pmr::new_delete_resource()->allocate(size, alignment);
+		buffer.overflow_allocations.push_back(OverflowAllocation{ .pointer = pointer, .size = size, .alignment = alignment });
+		buffer.overflow += size;
+		return pointer;
+	}
+
+	void FrameArena::do_deallocate(void*, size_t, size_t) {
+		// 在缓冲区被重置时统一释放
+	}
+
+	bool FrameArena::do_is_equal(std::pmr::memory_resource const& other) const noexcept {
+		return this == &other;
+	}
+
+	void FrameArena::resetBuffer(Buffer& buffer) noexcept {
+		for (auto const& [pointer, size, alignment] : buffer.overflow_allocations) {
+			std::pmr::new_delete_resource()->deallocate(pointer, size, alignment);
+		}
+		buffer.overflow_allocations.clear();
+		buffer.offset = 0;
+		buffer.overflow = 0;
+	}
+
+	FrameArena::FrameArena(size_t const capacity) : m_capacity(capacity) {
+		for (auto& buffer : m_buffers) {
+			buffer.data = std::make_unique_for_overwrite<std::byte[]>(capacity);
+		}
+		m_statistics.capacity = capacity;
+	}
+
+	FrameArena::~FrameArena() {
+		for (auto& buffer : m_buffers) {
+			resetBuffer(buffer);
+		}
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace luastg {
+	// 帧内存分配器，只用于生命周期不超过一帧的临时数据，释放内存时不做任何操作
+	// 两块缓冲区交替使用，每帧开始时切换到另一块并重置，上一帧分配的内存在当前帧内仍然有效
+	// 缓冲区用完后从堆上分配，这部分内存在所在的缓冲区被重置时释放
+	// 只能在主线程使用
+	class FrameArena final : public std::pmr::memory_resource {
+	public:
+		static constexpr size_t default_capacity{ 4 * 1024 * 1024 };
+
+		struct Statistics {
+			size_t capacity{};			// 每块缓冲区的容量
+			size_t used{};				// 上一帧分配的字节数，包括从堆上分配的部分
+			size_t overflow{};			// 上一帧从堆上分配的字节数
+			size_t high_water_mark{};	// 单帧分配字节数的历史最大值，可以用于调整缓冲区容量
+			size_t overflow_frames{};	// 发生过堆分配的帧数
+		};
+
+		// 开始新的一帧，切换并重置缓冲区
+		void beginFrame() noexcept;
+
+		[[nodiscard]] Statistics const& getStatistics() const noexcept { return m_statistics; }
+
+		// 当前帧已经分配的字节数
+		[[nodiscard]] size_t getCurrentFrameUsage() const noexcept;
+
+	private:
+		struct OverflowAllocation {
+			void* pointer;
+			size_t size;
+			size_t alignment;
+		};
+
+		struct Buffer {
+			std::unique_ptr<std::byte[]> data;
+			size_t offset{};
+			size_t overflow{};
+			std::vector<OverflowAllocation> overflow_allocations;
+		};
+
+		void* do_allocate(size_t size, size_t alignment) override;
+		void do_deallocate(void* pointer, size_t size, size_t alignment) override;
+		[[nodiscard]] bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override;
+
+		void resetBuffer(Buffer& buffer) noexcept;
+
+		Buffer m_buffers[2];
+		size_t m_buffer_index{};
+		size_t m_capacity{};
+		Statistics m_statistics;
+
+	public:
+		explicit FrameArena(size_t capacity = default_capacity);
+		FrameArena(FrameArena const&) = delete;
+		FrameArena(FrameArena&&) = delete;
+		~FrameArena() override;
+
+		FrameArena& operator=(FrameArena const&) = delete;
+		FrameArena& operator=(FrameArena&&) = delete;
+	};
+}
@@ -0,0 +1,102 @@
+#include "Utility/JobSystem.hpp"
+#include <algorithm>
+
+namespace {
+	constexpr size_t max_worker_count{ 15 };
+	constexpr size_t chunks_per_thread{ 2 }; // 每个线程分配多个区间，减少负载不均
+}
+
+namespace luastg {
+	size_t JobSystem::getChunkCount(size_t const count, size_t const min_chunk_size) const noexcept {
+		if (m_worker_count == 0) {
+			return 1;
+		}
+		auto const max_chunk_count = (m_worker_count + 1) * chunks_per_thread;
+		return std::clamp<size_t>(count / std::max<size_t>(min_chunk_size, 1), 1, max_chunk_count);
+	}
+
+	void JobSystem::run(size_t const chunk_count, void* const userdata, JobFunction const function) {
+		start();
+		{
+			std::unique_lock lock(m_mutex);
+			// 等待迟到的工作线程离开上一个任务
+			m_finish_condition.wait(lock, [this] { return m_active_workers == 0; });
+			m_userdata = userdata;
+			m_function = function;
+			m_chunk_count = chunk_count;
+			m_next_chunk.store(0);
+			m_finished_chunk.store(0);
+			m_generation += 1;
+		}
+		m_start_condition.notify_all();
+		execute();
+		{
+			std::unique_lock lock(m_mutex);
+			m_finish_condition.wait(lock, [this, chunk_count] {
+				return m_finished_chunk.load() == chunk_count && m_active_workers == 0;
+			});
+		}
+	}
+
+	void JobSystem::start() {
+		if (!m_workers.empty() || m_worker_count == 0) {
+			return;
+		}
+		m_workers.reserve(m_worker_count);
+		for (size_t i = 0; i < m_worker_count; i += 1) {
+			m_workers.emplace_back(&JobSystem::worker, this);
+		}
+	}
+
+	void JobSystem::worker() {
+		uint64_t generation{};
+		for (;;) {
+			{
+				std::unique_lock lock(m_mutex);
+				m_start_condition.wait(lock, [this, generation] { return m_exit || m_generation != generation; });
+				if (m_exit) {
+					return;
+				}
+				generation = m_generation;
+				m_active_workers += 1;
+			}
+			execute();
+			{
+				std::unique_lock lock(m_mutex);
+				m_active_workers -= 1;
+			}
+			m_finish_condition.notify_all();
+		}
+	}
+
+	void JobSystem::execute() {
+		for (;;) {
+			auto const chunk_index = m_next_chunk.fetch_add(1);
+			if (chunk_index >= m_chunk_count) {
+				return;
+			}
+			m_function(m_userdata, chunk_index);
+			m_finished_chunk.fetch_add(1);
+		}
+	}
+
+	JobSystem::JobSystem() {
+		auto const hardware_concurrency = static_cast<size_t>(std::thread::hardware_concurrency());
+		m_worker_count = std::min(hardware_concurrency > 1 ? hardware_concurrency - 1 : 0, max_worker_count);
+	}
+	JobSystem::~JobSystem() {
+		{
+			std::unique_lock lock(m_mutex);
+			m_exit = true;
+		}
+		m_start_condition.notify_all();
+		for (auto& thread : m_workers) {
+			thread.join();
+		}
+	}
+
+	JobSystem& JobSystem::getInstance() {
+		static JobSystem instance;
+		return instance;
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace luastg {
+	// 工作线程池，只用于不涉及 Lua 的纯计算任务
+	// 任务按连续区间划分，调用线程也会参与计算，所有区间完成后才会返回
+	class JobSystem {
+	public:
+		// 将 [0, count) 划分为不超过 getChunkCount 个连续区间，并行调用 function(chunk_index, begin, end)
+		// 每个区间的索引是确定的，调用方可以按区间索引顺序合并结果，保证结果与线程调度无关
+		template<typename F>
+		void parallelFor(size_t const count, size_t const min_chunk_size, F&& function) {
+			auto const chunk_count = getChunkCount(count, min_chunk_size);
+			if (chunk_count <= 1) {
+				if (count > 0) {
+					function(size_t{ 0 }, size_t{ 0 }, count);
+				}
+				return;
+			}
+			struct Context {
+				F* function;
+				size_t count;
+				size_t chunk_count;
+			} context{ &function, count, chunk_count };
+			run(chunk_count, &context, [](void* const userdata, size_t const chunk_index) {
+				auto const& ctx = *static_cast<Context*>(userdata);
+				auto const begin = ctx.count * chunk_index / ctx.chunk_count;
+				auto const end = ctx.count * (chunk_index + 1) / ctx.chunk_count;
+				(*ctx.function)(chunk_index, begin, end);
+			});
+		}
+
+		// 获取 [0, count) 会被划分为多少个区间
+		[[nodiscard]] size_t getChunkCount(size_t count, size_t min_chunk_size) const noexcept;
+
+		// 工作线程数量，不包括调用线程
+		[[nodiscard]] size_t getWorkerCount() const noexcept { return m_worker_count; }
+
+	private:
+		using JobFunction = void(*)(void* userdata, size_t chunk_index);
+
+		void run(size_t chunk_count, void* userdata, JobFunction function);
+		void start();
+		void worker();
+		void execute();
+
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_start_condition;
+		std::condition_variable m_finish_condition;
+		uint64_t m_generation{};
+		bool m_exit{ false };
+		size_t m_worker_count{};
+		// 当前任务
+		void* m_userdata{};
+		JobFunction m_function{};
+		size_t m_chunk_count{};
+		std::atomic_size_t m_next_chunk{};
+		std::atomic_size_t m_finished_chunk{};
+		size_t m_active_workers{};
+
+	public:
+		JobSystem();
+		JobSystem(JobSystem const&) = delete;
+		JobSystem(JobSystem&&) = delete;
+		~JobSystem();
+
+		JobSystem& operator=(JobSystem const&) = delete;
+		JobSystem& operator=(JobSystem&&) = delete;
+
+		static JobSystem& getInstance();
+	};
+}
@@ -27,11 +27,24 @@ end
 function M.ResetPool()
 end
 
+--- 获取对象池容量（最大对象数）
+---@return integer
+function M.GetObjectPoolCapacity()
+end
+
+--- 更改对象池容量（最大对象数），只能在没有存活的游戏对象时调用（比如在 ResetPool 之后）  
+--- 对象池按需分块申请内存，容量只是上限，不会立即占用对应的内存  
+--- 默认值可以通过引擎配置文件 `game_object.capacity` 或命令行参数 `--game_object.capacity` 修改  
+---@param capacity integer @范围为 1 到 1048575
+function M.SetObjectPoolCapacity(capacity)
+end
+
 --- 【禁止在协同程序中调用此方法】  
 --- 更新所有游戏对象并触发游戏对象的frame回调函数  
 --- 从 LuaSTG Sub v0.21.13（第二代游戏循环更新顺序）开始，可以传递版本参数 `version`：  
 --- * 不传递 `version` 参数或参数为 1 时，遵循旧逻辑  
 --- * `version` 参数或参数为 2 时，启用新逻辑  
+--- * `version` 参数为 3 时，与 2 相同，但运动更新以批量方式执行（带有粒子系统的对象仍逐个更新），结果与 2 完全一致  
 ---@param version integer?
 function M.ObjFrame(version)
 end
@@ -63,11 +76,49 @@ end
 ---【禁止在协同程序中调用此方法】  
 --- 对两个碰撞组的对象进行碰撞检测  
 --- 如果发生碰撞则触发groupidA内的对象的colli回调函数，并传入groupidB内的对象作为参数
----@param groupidA number @只能为0到15范围内的整数
----@param groupidB number @只能为0到15范围内的整数
+---@param groupidA number @只能为0到碰撞组数-1范围内的整数，默认碰撞组数为16
+---@param groupidB number @只能为0到碰撞组数-1范围内的整数，默认碰撞组数为16
+---@overload fun(group_pairs:integer[][], version:integer?)
 function M.CollisionCheck(groupidA, groupidB)
 end
 
+--- 【禁止在协同程序中调用此方法】  
+--- 批量模式：传入碰撞组对列表 `{ {groupidA, groupidB}, ... }`，先检测所有碰撞组对，再按顺序触发 colli 回调函数  
+--- 可以传递版本参数 `version`：  
+--- * 不传递 `version` 参数或参数为 2 时，逐个检测两个碰撞组内的所有对象  
+--- * `version` 参数为 3 时，先使用均匀网格空间哈希筛选出可能相交的对象，再进行精确检测，回调函数触发顺序与版本 2 一致  
+---@param group_pairs integer[][]
+---@param version integer?
+local function CollisionCheckBatch(group_pairs, version)
+end
+
+--- 获取碰撞组数，默认为16  
+--- 有效的碰撞组为 0 到碰撞组数-1 范围内的整数  
+---@return integer
+function M.GetCollisionGroupCount()
+end
+
+--- 设置碰撞组数，范围为 1 到 64  
+--- 减少碰撞组数时，被移除的碰撞组内不能有对象，碰撞矩阵中对应的碰撞组对也会被移除  
+--- 注意：`lstg.ObjList` 会把无效的碰撞组视为迭代所有游戏对象，如果脚本使用了类似 `GROUP_ALL = 16` 的约定，需要同步修改  
+---@param count integer
+function M.SetCollisionGroupCount(count)
+end
+
+--- 设置碰撞矩阵，传入碰撞组对列表 `{ {groupidA, groupidB}, ... }`，替换原有的所有碰撞组对  
+--- 碰撞矩阵会一直保留，不需要每帧设置，传入 nil 则清空碰撞矩阵  
+---@param group_pairs integer[][]?
+function M.SetCollisionMatrix(group_pairs)
+end
+
+--- 【禁止在协同程序中调用此方法】  
+--- 按碰撞矩阵进行批量模式的碰撞检测，效果等同于以碰撞组对列表调用 `lstg.CollisionCheck`，  
+--- 但碰撞组对按 groupidA、groupidB 从小到大的顺序检测，且会跳过没有对象的碰撞组  
+--- 可以传递版本参数 `version`，含义与批量模式的 `lstg.CollisionCheck` 相同  
+---@param version integer?
+function M.CollisionCheckMatrix(version)
+end
+
 --- 【禁止在协同程序中调用此方法】  
 --- 保存游戏对象的x, y坐标并计算dx, dy  
 --- 从 LuaSTG Sub v0.21.13（第二代游戏循环更新顺序）开始，如果启用新逻辑，  
@@ -94,6 +145,34 @@ end
 function M.New(class, ...)
 end
 
+---@class lstg.NewBatch.Attributes
+---@field x number|number[]|ffi.cdata*|nil
+---@field y number|number[]|ffi.cdata*|nil
+---@field rot number|number[]|ffi.cdata*|nil @角度制
+---@field vx number|number[]|ffi.cdata*|nil
+---@field vy number|number[]|ffi.cdata*|nil
+---@field speed number|number[]|ffi.cdata*|nil @与 angle 一起使用，等效于 SetV(unit, speed, angle)
+---@field angle number|number[]|ffi.cdata*|nil @角度制，与 speed 一起使用
+---@field group number|number[]|ffi.cdata*|nil
+---@field layer number|number[]|ffi.cdata*|nil
+---@field img string|string[]|nil
+
+--- 批量申请游戏对象，并将游戏对象和指定的class绑定  
+--- 每个对象都会依次调用init回调函数，剩余的参数将会传递给init回调函数，然后再写入 `attributes` 中的属性  
+--- `attributes` 中的每个属性可以是：  
+--- * 单个值：所有对象使用同一个值  
+--- * lua 数组：第 i 个对象使用 `t[i]`  
+--- * LuaJIT FFI double 数组（如 `ffi.new("double[?]", count)`）：第 i 个对象使用 `p[i - 1]`，数组长度不能小于 count，不接受指针和其他类型的数组  
+--- 对象池剩余空间不足、属性类型或者取值错误、找不到 img 指定的资源时不会创建任何对象，直接报错  
+--- 返回按创建顺序排列的游戏对象数组，对象在对象池中的 id 不保证连续  
+---@param class lstg.Class
+---@param count integer
+---@param attributes lstg.NewBatch.Attributes?
+---@vararg any
+---@return lstg.GameObject[]
+function M.NewBatch(class, count, attributes, ...)
+end
+
 --- 触发指定游戏对象的del回调函数，并将该对象标记为del状态，剩余参数将传递给del回调函数
 ---@param unit lstg.GameObject
 ---@vararg any
@@ -113,6 +192,24 @@ end
 function M.IsValid(unit)
 end
 
+--- 获取游戏对象常用字段的 LuaJIT FFI 结构体声明以及声明的版本号  
+--- 结构体名称为 `lstg_GameObject_v<版本号>`，字段偏移与引擎内部的内存布局一致，通过指针读写字段不需要调用 C 函数  
+--- 可以直接使用内置模块 `require("luastg.ffi.GameObject")`，该模块提供 `view(unit)` 方法获取游戏对象的结构体指针  
+--- 注意：  
+--- * 结构体中的 rot、omega 为弧度制，与 lua 对象上的角度制属性不同  
+--- * 坐标、速度、碰撞体、缩放、旋转等字段在引擎开启 `LUASTG_GAME_OBJECT_FLOAT32_LAYOUT` 编译选项时为 float，否则为 double，字段顺序也可能随编译选项变化  
+--- * group、layer、a、b 等修改时有副作用的属性为只读字段，img、status 等属性没有声明，需要通过 lua 对象修改  
+--- * 对象被回收后指针失效，不能保存指针跨帧使用  
+---@return string, integer
+function M.GetObjectFFIDeclaration()
+end
+
+--- 获取游戏对象的指针，配合 `ffi.cast` 和 `GetObjectFFIDeclaration` 返回的结构体声明使用  
+---@param unit lstg.GameObject
+---@return lightuserdata
+function M.GetObjectPointer(unit)
+end
+
 --------------------------------------------------------------------------------
 --- 碰撞相关
 
@@ -133,6 +230,201 @@ end
 function M.ColliCheck(unitA, unitB, ignoreworldmask)
 end
 
+--------------------------------------------------------------------------------
+--- 空间查询
+--- 查询只考虑碰撞组内 colli 为 true 且未被标记为 kill 或 del 的对象，判定方式与碰撞检测相同  
+--- 同一碰撞组的查询索引在对象移动或修改碰撞体后第一次查询时重建，同一帧内多次查询只需要构建一次  
+--- 注意：通过 FFI 直接修改对象坐标或碰撞体不会使查询索引失效  
+
+--- 查询距离 (x, y) 最近的对象，距离按对象中心计算，距离相同时返回碰撞组链表中靠前的对象  
+---@param group integer
+---@param x number
+---@param y number
+---@param max_distance number? @最大距离，默认不限制
+---@return lstg.GameObject?
+function M.QueryNearestObject(group, x, y, max_distance)
+end
+
+--- 查询与圆相交的所有对象，结果按碰撞组链表顺序排列  
+--- 可以传入 `output` 表复用，表中多余的旧元素会被清除  
+---@param group integer
+---@param x number
+---@param y number
+---@param r number
+---@param output lstg.GameObject[]?
+---@return lstg.GameObject[], integer
+function M.QueryObjectsInCircle(group, x, y, r, output)
+end
+
+--- 查询与矩形区域相交的所有对象，参数与 `lstg.BoxCheck` 相同，其他同 `lstg.QueryObjectsInCircle`  
+---@param group integer
+---@param left number
+---@param right number
+---@param bottom number
+---@param top number
+---@param output lstg.GameObject[]?
+---@return lstg.GameObject[], integer
+function M.QueryObjectsInRect(group, left, right, bottom, top, output)
+end
+
+--- 查询与旋转矩形相交的所有对象，a、b 为半宽和半高，rot 为角度，其他同 `lstg.QueryObjectsInCircle`  
+---@param group integer
+---@param x number
+---@param y number
+---@param a number
+---@param b number
+---@param rot number
+---@param output lstg.GameObject[]?
+---@return lstg.GameObject[], integer
+function M.QueryObjectsInOBB(group, x, y, a, b, rot, output)
+end
+
+--- 查询从 (x1, y1) 到 (x2, y2) 的线段最先碰到的对象，按对象中心在线段方向上的投影排序  
+--- half_width 为线段的半宽，默认为 0  
+---@param group integer
+---@param x1 number
+---@param y1 number
+---@param x2 number
+---@param y2 number
+---@param half_width number?
+---@return lstg.GameObject?
+function M.QueryFirstObjectOnSegment(group, x1, y1, x2, y2, half_width)
+end
+
+--------------------------------------------------------------------------------
+--- 原生行为程序
+--- 行为程序是按顺序执行的运动指令列表，每帧在调用 frame 回调的位置由引擎直接执行，不需要调用 lua 代码  
+--- 持续性指令每帧执行一次，执行完毕后下一帧开始执行下一条指令；瞬时指令不占用帧，会连续执行  
+--- 支持的指令（角度单位均为度）：  
+--- * `{ "wait", frames }`：等待 frames 帧  
+--- * `{ "speed", v }`：设置速度大小，方向不变（瞬时）  
+--- * `{ "angle", a }`：设置速度方向，大小不变（瞬时）  
+--- * `{ "velocity", v, a }`：设置速度大小和方向（瞬时）  
+--- * `{ "accelerate", v, step }`：每帧速度大小向 v 变化 step，达到 v 后结束  
+--- * `{ "turn", omega, frames }`：每帧速度方向旋转 omega，持续 frames 帧，省略或为 0 时一直持续  
+--- * `{ "aim", offset }`：速度方向指向目标对象再加上 offset（瞬时），没有目标时忽略  
+--- * `{ "homing", rate, frames }`：每帧向目标对象转向，最多旋转 rate，持续 frames 帧，省略或为 0 时一直持续  
+--- * `{ "fade", alpha, frames }`：在 frames 帧内把顶点颜色的 alpha 线性变化到 alpha  
+--- * `{ "del" }`：删除对象，会调用对象的 del 回调，回调的第二个参数为 `"luastg:behavior"`  
+
+---@class lstg.GameObjectBehavior
+
+--- 创建行为程序，创建后不可修改，可以被多个对象共享
+---@param instructions table[]
+---@return lstg.GameObjectBehavior
+function M.CreateObjectBehavior(instructions)
+end
+
+--- 为对象设置行为程序，从头开始执行，传入 nil 则移除当前的行为程序  
+--- exclusive 为 true 时，行为程序执行期间不会调用对象的 frame 回调，行为程序执行完毕或被移除后恢复  
+--- 否则行为程序在 frame 回调之前执行，两者同时生效  
+---@param unit lstg.GameObject
+---@param behavior lstg.GameObjectBehavior?
+---@param exclusive boolean?
+---@param target lstg.GameObject? @aim、homing 指令使用的目标对象
+function M.SetObjectBehavior(unit, behavior, exclusive, target)
+end
+
+--- 修改行为程序的目标对象，目标对象被删除后 aim、homing 指令不再生效
+---@param unit lstg.GameObject
+---@param target lstg.GameObject?
+function M.SetObjectBehaviorTarget(unit, target)
+end
+
+--- 对象是否有正在执行的行为程序
+---@param unit lstg.GameObject
+---@return boolean
+function M.IsObjectBehaviorRunning(unit)
+end
+
+--------------------------------------------------------------------------------
+--- 父子附着
+--- 附着在父对象上的子对象，每帧在运动更新之后由引擎根据父对象的坐标、旋转和缩放计算自身的 x、y、rot、hscale、vscale，  
+--- 然后才进行出界检测和相交检测，多层附着时父对象总是先于子对象计算，不需要在 frame 回调中手动跟随  
+--- 附着期间对象自身的速度和对坐标、旋转、缩放的修改会被覆盖  
+--- 父对象被删除时，子对象会被一起删除（会调用 del 回调，第二个参数为 `"luastg:parent_destroyed"`）或者只解除附着：  
+--- 父对象在 frame 回调中被删除时在同一帧处理，在其他阶段（例如出界、碰撞回调）被删除时在下一帧的更新阶段处理  
+
+--- 把 child 附着到 parent 上，已经附着的对象会改为附着到新的父对象  
+--- x、y 为相对父对象的偏移（会跟随父对象旋转和缩放），rot 为相对旋转角（度），hscale、vscale 为相对缩放  
+--- detach_on_parent_free 为 true 时，父对象被删除后只解除附着，否则一起删除  
+--- parent 已经被删除，或者是 child 自身及其子孙时会报错  
+---@param child lstg.GameObject
+---@param parent lstg.GameObject
+---@param x number? @默认为 0
+---@param y number? @默认为 0
+---@param rot number? @默认为 0
+---@param hscale number? @默认为 1
+---@param vscale number? @默认为 1
+---@param detach_on_parent_free boolean? @默认为 false
+function M.AttachObject(child, parent, x, y, rot, hscale, vscale, detach_on_parent_free)
+end
+
+--- 解除附着，对象保留当前的坐标、旋转和缩放
+---@param child lstg.GameObject
+function M.DetachObject(child)
+end
+
+--- 获取父对象，未附着时返回 nil
+---@param child lstg.GameObject
+---@return lstg.GameObject?
+function M.GetObjectParent(child)
+end
+
+--- 修改子对象相对父对象的变换，参数同 `lstg.AttachObject`，对象未附着时会报错
+---@param child lstg.GameObject
+---@param x number?
+---@param y number?
+---@param rot number?
+---@param hscale number?
+---@param vscale number?
+function M.SetAttachmentTransform(child, x, y, rot, hscale, vscale)
+end
+
+--- 世界快照
+--- 记录和恢复整个对象池的模拟状态（对象、碰撞组链表、行为程序、父子附着、粒子池的发射器状态等），用于回滚和回放跳转  
+--- 再次记录到同一个快照时只复制发生变化的对象，通常循环使用若干个快照  
+--- 对象表中的 lua 字段和激光等 lua 侧的数据不会被记录，需要通过 `lstg.SetWorldSnapshotCallbacks` 自行处理  
+--- 恢复时不会调用任何回调，已经发射的粒子不会回滚，修改对象池容量后旧的快照会失效  
+--- 只能在对象池没有执行更新、渲染、碰撞检测等批量过程时记录和恢复，否则会报错  
+
+---@class lstg.GameObjectSnapshot
+
+--- 创建空快照
+---@return lstg.GameObjectSnapshot
+function M.CreateWorldSnapshot()
+end
+
+--- 把当前的对象池记录到快照中，然后调用保存回调
+---@param snapshot lstg.GameObjectSnapshot
+function M.SaveWorldSnapshot(snapshot)
+end
+
+--- 把对象池恢复到快照记录时的状态，然后调用恢复回调  
+--- 快照中不存在的对象的 lua 表会变为无效对象  
+--- 快照从未记录过或者对象池容量已改变时会报错  
+---@param snapshot lstg.GameObjectSnapshot
+function M.LoadWorldSnapshot(snapshot)
+end
+
+--- 释放快照持有的资源引用和 lua 数据，快照变为空快照
+---@param snapshot lstg.GameObjectSnapshot
+function M.ClearWorldSnapshot(snapshot)
+end
+
+--- 获取快照信息：对象数量、上一次记录时复制的对象数量、快照占用的内存（字节）
+---@param snapshot lstg.GameObjectSnapshot
+---@return integer, integer, integer
+function M.GetWorldSnapshotInfo(snapshot)
+end
+
+--- 设置保存回调和恢复回调，传入 nil 时清除  
+--- 保存回调的返回值会存储在快照中，在恢复时作为恢复回调的第二个参数传入  
+---@param on_save (fun(snapshot:lstg.GameObjectSnapshot):any)?
+---@param on_load (fun(snapshot:lstg.GameObjectSnapshot, data:any))?
+function M.SetWorldSnapshotCallbacks(on_save, on_load)
+end
+
 --------------------------------------------------------------------------------
 --- 属性访问（用于游戏对象的 lua metatable）
 
@@ -277,6 +569,40 @@ end
 function M.GetCurrentSuperPause()
 end
 
+--------------------------------------------------------------------------------
+--- 游戏对象回调函数耗时统计（调试功能）
+
+--- 开启或关闭游戏对象回调函数耗时统计，默认关闭  
+--- 开启后按对象类分别统计 frame、render、colli、del 回调函数的调用次数、总耗时和最大耗时  
+--- 耗时包含回调函数中嵌套触发的其他回调函数  
+--- 对象类的名称优先使用对象类的 `__name` 字段，其次使用引用了该对象类的全局变量名  
+--- 也可以通过 `imgui.backend.ShowGameObjectCallbackProfiler()` 在调试窗口中查看  
+---@param enable boolean
+function M.SetObjectCallbackProfilerEnable(enable)
+end
+
+--- 清空游戏对象回调函数耗时统计
+function M.ResetObjectCallbackProfiler()
+end
+
+---@class lstg.ObjectCallbackProfileRecord
+---@field count number @调用次数
+---@field total number @总耗时（秒）
+---@field max number @最大耗时（秒）
+
+---@class lstg.ObjectCallbackProfile
+---@field class lstg.Class
+---@field name string
+---@field frame lstg.ObjectCallbackProfileRecord
+---@field render lstg.ObjectCallbackProfileRecord
+---@field colli lstg.ObjectCallbackProfileRecord
+---@field del lstg.ObjectCallbackProfileRecord
+
+--- 获取游戏对象回调函数耗时统计，每个对象类一项，顺序不固定
+---@return lstg.ObjectCallbackProfile[]
+function M.GetObjectCallbackProfile()
+end
+
 --------------------------------------------------------------------------------
 --- 游戏对象world掩码（高级功能）
 
@@ -0,0 +1,40 @@
+---@diagnostic disable: missing-return, unused-local
+
+--- 引擎内置的协程任务调度器，语义与常见的 task.New、task.Wait 相同  
+--- 每个任务记录唤醒帧并放入时间轮，`Update` 只恢复等待已经结束的任务，处于等待中的任务没有开销  
+--- 属于游戏对象的任务会在对象被删除后自动结束  
+---@class lstg.Task
+local Task = {}
+
+--- 创建任务，任务从下一次调用 `Update` 时开始执行  
+--- 在 `Update` 执行过程中创建的任务从下一帧开始执行  
+--- owner 为 nil 或省略时，任务不属于任何游戏对象  
+---@param owner lstg.GameObject?
+---@param f fun()
+---@return thread
+---@overload fun(f:fun()):thread
+function Task.New(owner, f)
+end
+
+--- 在任务中等待指定的帧数，默认为 1，只能在 `New` 创建的任务中直接调用  
+--- 在任务中直接调用 `coroutine.yield` 相当于等待 1 帧  
+---@param frames integer?
+function Task.Wait(frames)
+end
+
+--- 推进一帧，恢复所有等待结束的任务，一般每帧调用一次  
+--- 任务出错时，错误会从这里抛出，剩余的任务推迟到下一帧执行  
+function Task.Update()
+end
+
+--- 结束属于指定游戏对象的所有任务，owner 为 nil 时结束所有任务
+---@param owner lstg.GameObject?
+function Task.Clear(owner)
+end
+
+--- 获取未结束的任务数量
+---@return integer
+function Task.GetCount()
+end
+
+return Task
@@ -0,0 +1,122 @@
+local test = require("test")
+local lstg = require("lstg")
+
+local GROUP_A = 1
+local GROUP_B = 2
+local GROUP_C = 3
+
+---@type string[]
+local records = {}
+
+local object_class = {
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function(self, other)
+        records[#records + 1] = self.tag .. ":" .. other.tag
+    end,
+    function() end;
+    is_class = true,
+}
+
+local function createObject(tag)
+    local obj = lstg.New(object_class)
+    obj.tag = tag
+    obj.group = GROUP_A + (tag % 3)
+    obj.x = math.random(-300, 300)
+    obj.y = math.random(-300, 300)
+    -- 圆、椭圆、旋转的矩形，以及半径为 0 和远大于其他对象的碰撞体
+    local shape = math.random(1, 10)
+    if shape <= 4 then
+        local r = math.random(0, 32)
+        obj.rect = false
+        obj.a = r
+        obj.b = r
+    elseif shape <= 7 then
+        obj.rect = false
+        obj.a = math.random(1, 32)
+        obj.b = math.random(1, 32)
+        obj.rot = math.random() * 360
+    elseif shape <= 9 then
+        obj.rect = true
+        obj.a = math.random(1, 32)
+        obj.b = math.random(1, 32)
+        obj.rot = math.random() * 360
+    else
+        obj.rect = false
+        obj.a = 400
+        obj.b = 400
+    end
+    return obj
+end
+
+local function createObjects(count)
+    local objects = {}
+    for i = 1, count do
+        objects[i] = createObject(i)
+    end
+    -- 回收一部分对象后再创建，让更新链表的顺序和对象池槽位的顺序不同
+    for i = 1, count, 3 do
+        lstg.Del(objects[i])
+    end
+    lstg.AfterFrame(2)
+    for i = count + 1, count + count / 3 do
+        createObject(i)
+    end
+end
+
+---@param f fun()
+---@return string[]
+local function collectPairs(f)
+    records = {}
+    f()
+    local result = records
+    records = {}
+    return result
+end
+
+local function assertSameOrder(expected, actual, name)
+    assert(#expected == #actual, ("%s: expected %d pairs, got %d"):format(name, #expected, #actual))
+    for i = 1, #expected do
+        assert(expected[i] == actual[i], ("%s: pair %d is %s, expected %s"):format(name, i, actual[i], expected[i]))
+    end
+end
+
+---@class test.gameplay.CollisionOrder : test.Base
+local M = {}
+
+function M:onCreate()
+    lstg.SetBound(-1000, 1000, -1000, 1000)
+    local group_pairs = {
+        { GROUP_A, GROUP_B },
+        { GROUP_C, GROUP_A },
+        { GROUP_B, GROUP_B },
+    }
+    for seed = 1, 10 do
+        lstg.ResetPool()
+        math.randomseed(seed)
+        createObjects(600)
+        -- 逐对检测的旧模式作为参照，批量模式和空间哈希模式的回调顺序必须与它一致
+        local expected = collectPairs(function()
+            for _, v in ipairs(group_pairs) do
+                lstg.CollisionCheck(v[1], v[2])
+            end
+        end)
+        assert(#expected > 0)
+        assertSameOrder(expected, collectPairs(function()
+            lstg.CollisionCheck(group_pairs)
+        end), "CollisionCheck(group_pairs)")
+        assertSameOrder(expected, collectPairs(function()
+            lstg.CollisionCheck(group_pairs, 3)
+        end), "CollisionCheck(group_pairs, 3)")
+    end
+    lstg.ResetPool()
+    print("test.gameplay.CollisionOrder passed")
+end
+
+function M:onDestroy()
+    lstg.ResetPool()
+end
+
+test.registerTest("test.gameplay.CollisionOrder", M, "Gameplay: Collision Order")
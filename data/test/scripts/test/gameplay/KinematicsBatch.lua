@@ -0,0 +1,106 @@
+local test = require("test")
+local lstg = require("lstg")
+
+local object_class = {
+    function() end,
+    function() end,
+    function(self)
+        -- 在 frame 回调中修改运动学属性，批量更新必须读到这些修改
+        if self.timer % 17 == 5 then
+            self.vx = -self.vx
+            self.ay = 0.01 * (self.tag % 5)
+        end
+    end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+}
+
+local function createObject(tag)
+    local obj = lstg.New(object_class)
+    obj.tag = tag
+    obj.x = math.random(-300, 300)
+    obj.y = math.random(-300, 300)
+    obj.vx = math.random() * 6 - 3
+    obj.vy = math.random() * 6 - 3
+    obj.ax = math.random() * 0.06 - 0.03
+    obj.ay = math.random() * 0.06 - 0.03
+    obj.omega = math.random() * 6 - 3
+    obj.navi = math.random() < 0.3
+    if math.random() < 0.3 then
+        obj.maxv = 2
+    end
+    if math.random() < 0.3 then
+        obj.maxvx = 1.5
+    end
+    if math.random() < 0.3 then
+        obj.maxvy = 1.5
+    end
+    if math.random() < 0.3 then
+        obj.ag = 0.05
+    end
+    return obj
+end
+
+---@param version integer
+---@param seed integer
+---@return table[]
+local function simulate(version, seed)
+    lstg.ResetPool()
+    math.randomseed(seed)
+    local objects = {}
+    for i = 1, 2000 do
+        objects[i] = createObject(i)
+    end
+    -- 回收一部分对象后再创建，让更新链表的顺序和对象池槽位的顺序不同
+    for i = 1, #objects, 3 do
+        lstg.Del(objects[i])
+    end
+    lstg.AfterFrame(2)
+    for i = #objects + 1, #objects + 600 do
+        objects[#objects + 1] = createObject(i)
+    end
+    for _ = 1, 120 do
+        lstg.ObjFrame(version)
+        lstg.AfterFrame(2)
+    end
+    local states = {}
+    for _, obj in ipairs(objects) do
+        if lstg.IsValid(obj) then
+            states[#states + 1] = {
+                obj.tag, obj.timer,
+                obj.x, obj.y, obj.dx, obj.dy,
+                obj.vx, obj.vy, obj.ax, obj.ay,
+                obj.rot, obj.omega,
+            }
+        end
+    end
+    return states
+end
+
+---@class test.gameplay.KinematicsBatch : test.Base
+local M = {}
+
+function M:onCreate()
+    lstg.SetBound(-100000, 100000, -100000, 100000)
+    for seed = 1, 5 do
+        -- ObjFrame(3) 的结果必须与 ObjFrame(2) 逐位一致
+        local expected = simulate(2, seed)
+        local actual = simulate(3, seed)
+        assert(#expected == #actual, ("expected %d objects, got %d"):format(#expected, #actual))
+        for i = 1, #expected do
+            for j = 1, #expected[i] do
+                assert(expected[i][j] == actual[i][j], ("object %d field %d is %.17g, expected %.17g"):format(expected[i][1], j, actual[i][j], expected[i][j]))
+            end
+        end
+    end
+    lstg.ResetPool()
+    print("test.gameplay.KinematicsBatch passed")
+end
+
+function M:onDestroy()
+    lstg.ResetPool()
+end
+
+test.registerTest("test.gameplay.KinematicsBatch", M, "Gameplay: Kinematics Batch")
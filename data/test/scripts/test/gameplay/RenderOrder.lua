@@ -0,0 +1,103 @@
+local test = require("test")
+local lstg = require("lstg")
+
+---@type lstg.GameObject[]
+local records = {}
+
+local object_class = {
+    function() end,
+    function() end,
+    function() end,
+    function(self)
+        records[#records + 1] = self
+    end,
+    function() end,
+    function() end;
+    is_class = true,
+}
+
+-- 包含 -0.0 和 0.0，它们是同一个图层
+local layers = { -0.0, 0.0, 1.0, -5.0, 0.5, 1e9 }
+
+---@class test.gameplay.RenderOrder : test.Base
+local M = {}
+
+function M:onCreate()
+    lstg.SetBound(-1000, 1000, -1000, 1000)
+    lstg.ResetPool()
+    math.randomseed(114514)
+    self.objects = {}
+    self.counter = 0
+    self.frames = 0
+    for _ = 1, 1000 do
+        self:createObject()
+    end
+end
+
+function M:onDestroy()
+    lstg.ResetPool()
+end
+
+function M:createObject()
+    self.counter = self.counter + 1
+    local obj = lstg.New(object_class)
+    obj.index = self.counter
+    obj.layer = layers[math.random(1, #layers)]
+    self.objects[#self.objects + 1] = obj
+end
+
+function M:onUpdate()
+    -- 修改图层、回收和创建对象，让渲染列表在每一帧都需要重新排序或压缩
+    for _, obj in ipairs(self.objects) do
+        if lstg.IsValid(obj) then
+            local r = math.random(1, 10)
+            if r == 1 then
+                obj.layer = layers[math.random(1, #layers)]
+            elseif r == 2 then
+                lstg.Del(obj)
+            end
+        end
+    end
+    for _ = 1, 50 do
+        self:createObject()
+    end
+    lstg.AfterFrame(2)
+    local j = 0
+    for i = 1, #self.objects do
+        if lstg.IsValid(self.objects[i]) then
+            j = j + 1
+            self.objects[j] = self.objects[i]
+        end
+    end
+    for i = j + 1, #self.objects do
+        self.objects[i] = nil
+    end
+end
+
+function M:onRender()
+    window:applyCameraV()
+    records = {}
+    lstg.ObjRender()
+    -- 按图层升序排列，图层相同时按创建顺序（unique_id）排列
+    local expected = {}
+    for i, obj in ipairs(self.objects) do
+        expected[i] = obj
+    end
+    table.sort(expected, function(l, r)
+        if l.layer ~= r.layer then
+            return l.layer < r.layer
+        end
+        return l.index < r.index
+    end)
+    assert(#records == #expected, ("expected %d objects, got %d"):format(#expected, #records))
+    for i = 1, #expected do
+        assert(records[i] == expected[i], ("object %d is rendered at position %d"):format(records[i].index, i))
+    end
+    records = {}
+    self.frames = self.frames + 1
+    if self.frames == 60 then
+        print("test.gameplay.RenderOrder passed")
+    end
+end
+
+test.registerTest("test.gameplay.RenderOrder", M, "Gameplay: Render Order")
@@ -0,0 +1,184 @@
+local test = require("test")
+local lstg = require("lstg")
+
+local GROUP_A = 1
+local GROUP_B = 2
+
+local object_class = {
+    function() end,
+    function() end,
+    function(self)
+        if self.timer % 13 == 7 then
+            self.vx = -self.vx
+        end
+    end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+}
+
+local function createObject(objects, particle)
+    local obj = lstg.New(object_class)
+    obj.group = math.random(GROUP_A, GROUP_B)
+    obj.layer = math.random(-3, 3)
+    obj.x = math.random(-300, 300)
+    obj.y = math.random(-300, 300)
+    obj.vx = math.random() * 4 - 2
+    obj.vy = math.random() * 4 - 2
+    obj.omega = math.random() * 4 - 2
+    obj.a = math.random(1, 16)
+    obj.b = math.random(1, 16)
+    obj.rect = math.random() < 0.5
+    if particle then
+        obj.img = "ps:1"
+        lstg.ParticleSetEmission(obj, math.random(5, 50))
+    end
+    objects[#objects + 1] = obj
+    return obj
+end
+
+local function step(frames)
+    for _ = 1, frames do
+        lstg.ObjFrame(2)
+        lstg.AfterFrame(2)
+    end
+end
+
+---@param objects lstg.GameObject[]
+---@return table[]
+local function captureState(objects)
+    local states = {}
+    for i, obj in ipairs(objects) do
+        if lstg.IsValid(obj) then
+            local state = {
+                i, obj.timer, obj.group, obj.layer,
+                obj.x, obj.y, obj.dx, obj.dy,
+                obj.vx, obj.vy, obj.rot, obj.omega,
+                obj.a, obj.b, obj.rect, obj.img or "",
+            }
+            if obj.img == "ps:1" then
+                state[#state + 1] = lstg.ParticleGetEmission(obj)
+                state[#state + 1] = lstg.ParticleGetn(obj) >= 0
+            end
+            states[#states + 1] = state
+        end
+    end
+    return states
+end
+
+---@param objects lstg.GameObject[]
+---@return string[]
+local function captureListOrder(objects)
+    local index = {}
+    for i, obj in ipairs(objects) do
+        index[obj] = i
+    end
+    -- 无效的碰撞组会遍历更新链表
+    local order = {}
+    for _, group in ipairs({ -1, GROUP_A, GROUP_B }) do
+        for _, obj in lstg.ObjList(group) do
+            order[#order + 1] = ("%d:%d"):format(group, index[obj] or -1)
+        end
+    end
+    return order
+end
+
+local function assertSameState(expected, actual, name)
+    assert(#expected == #actual, ("%s: expected %d entries, got %d"):format(name, #expected, #actual))
+    for i = 1, #expected do
+        if type(expected[i]) == "table" then
+            for j = 1, #expected[i] do
+                assert(expected[i][j] == actual[i][j], ("%s: object %s field %d is %s, expected %s"):format(name, tostring(expected[i][1]), j, tostring(actual[i][j]), tostring(expected[i][j])))
+            end
+        else
+            assert(expected[i] == actual[i], ("%s: entry %d is %s, expected %s"):format(name, i, tostring(actual[i]), tostring(expected[i])))
+        end
+    end
+end
+
+---@class test.gameplay.WorldSnapshot : test.Base
+local M = {}
+
+function M:onCreate()
+    local last_pool = lstg.GetResourceStatus()
+    lstg.SetResourceStatus("global")
+    lstg.LoadTexture("tex:particles", "res/particles.png")
+    lstg.LoadImage("img:particle1", "tex:particles", 0, 0, 32, 32)
+    lstg.LoadPS("ps:1", "res/ghost_fire_1.psi", "img:particle1")
+    lstg.SetResourceStatus(last_pool)
+
+    lstg.SetBound(-100000, 100000, -100000, 100000)
+    lstg.ResetPool()
+    math.randomseed(1919810)
+    local objects = {}
+    for i = 1, 500 do
+        createObject(objects, i % 10 == 0)
+    end
+    -- 回收一部分对象后再创建，让更新链表的顺序和对象池槽位的顺序不同
+    for i = 1, #objects, 4 do
+        lstg.Del(objects[i])
+    end
+    step(1)
+    for i = 1, 100 do
+        createObject(objects, i % 10 == 0)
+    end
+    step(5)
+
+    local snapshot = lstg.CreateWorldSnapshot()
+    lstg.SaveWorldSnapshot(snapshot)
+    local saved_state = captureState(objects)
+    local saved_order = captureListOrder(objects)
+
+    -- 记录后继续模拟，作为恢复后继续模拟的参照
+    step(20)
+    local expected_state = captureState(objects)
+    local expected_order = captureListOrder(objects)
+
+    -- 修改：回收对象（包括带粒子池的对象）、创建对象、修改粒子发射密度
+    lstg.LoadWorldSnapshot(snapshot)
+    local created_count = #objects
+    for i = 1, #objects, 3 do
+        if lstg.IsValid(objects[i]) then
+            lstg.Del(objects[i])
+        end
+    end
+    for i = 1, 200 do
+        createObject(objects, i % 5 == 0)
+    end
+    for _, obj in ipairs(objects) do
+        if lstg.IsValid(obj) and obj.img == "ps:1" then
+            lstg.ParticleSetEmission(obj, 99)
+        end
+    end
+    step(10)
+
+    -- 恢复后与记录时一致，记录之后创建的对象变为无效对象
+    lstg.LoadWorldSnapshot(snapshot)
+    for i = created_count + 1, #objects do
+        assert(not lstg.IsValid(objects[i]), ("object %d created after the snapshot is still valid"):format(i))
+    end
+    for i = #objects, created_count + 1, -1 do
+        objects[i] = nil
+    end
+    assertSameState(saved_state, captureState(objects), "restored state")
+    assertSameState(saved_order, captureListOrder(objects), "restored order")
+
+    -- 恢复后继续模拟，结果与记录后直接模拟一致
+    step(20)
+    assertSameState(expected_state, captureState(objects), "simulated state")
+    assertSameState(expected_order, captureListOrder(objects), "simulated order")
+
+    lstg.ClearWorldSnapshot(snapshot)
+    lstg.ResetPool()
+    print("test.gameplay.WorldSnapshot passed")
+end
+
+function M:onDestroy()
+    lstg.ResetPool()
+    lstg.RemoveResource("global", 6, "ps:1")
+    lstg.RemoveResource("global", 2, "img:particle1")
+    lstg.RemoveResource("global", 1, "tex:particles")
+end
+
+test.registerTest("test.gameplay.WorldSnapshot", M, "Gameplay: World Snapshot")
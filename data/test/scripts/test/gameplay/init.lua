@@ -1 +1,5 @@
-require("test.gameplay.GameObjectUpdate")
\ No newline at end of file
+require("test.gameplay.GameObjectUpdate")
+require("test.gameplay.CollisionOrder")
+require("test.gameplay.KinematicsBatch")
+require("test.gameplay.RenderOrder")
+require("test.gameplay.WorldSnapshot")
\ No newline at end of file
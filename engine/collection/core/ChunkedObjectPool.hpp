@@ -0,0 +1,173 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <vector>
+
+namespace core {
+	// 分块对象池：容量在运行时指定，内存按固定大小的块按需分配
+	// 已分配的块永远不会移动，对象的地址和索引在对象存活期间保持不变
+	// 索引的分配顺序与 FixedObjectPool 一致（优先复用最近回收的索引，否则使用最小的未使用索引）
+	template<typename T, size_t ChunkSize>
+	class ChunkedObjectPool {
+		static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+	public:
+		ChunkedObjectPool() noexcept = default;
+		explicit ChunkedObjectPool(size_t const capacity) noexcept : m_capacity(capacity) {}
+		ChunkedObjectPool(ChunkedObjectPool const&) = delete;
+		ChunkedObjectPool(ChunkedObjectPool&&) = delete;
+		~ChunkedObjectPool() noexcept = default;
+
+		ChunkedObjectPool& operator=(ChunkedObjectPool const&) = delete;
+		ChunkedObjectPool& operator=(ChunkedObjectPool&&) = delete;
+
+		bool alloc(size_t& id) noexcept {
+			if (m_free_indices.empty() && !grow()) {
+				id = static_cast<size_t>(-1);
+				return false;
+			}
+			id = m_free_indices.back();
+			m_free_indices.pop_back();
+			chunk(id).used[id & chunk_mask] = true;
+			m_size++;
+			return true;
+		}
+
+		void free(size_t const id) noexcept {
+			if (id < slotCount() && chunk(id).used[id & chunk_mask]) {
+				chunk(id).used[id & chunk_mask] = false;
+				m_free_indices.push_back(id); // 容量已在分配块时预留，不会失败
+				m_size--;
+			}
+		}
+
+		// 批量回收，结果与按顺序逐个调用 free 相同
+		void free(std::span<size_t const> const ids) noexcept {
+			size_t count{};
+			for (auto const id : ids) {
+				if (id < slotCount() && chunk(id).used[id & chunk_mask]) {
+					chunk(id).used[id & chunk_mask] = false;
+					m_free_indices.push_back(id); // 容量已在分配块时预留，不会失败
+					count++;
+				}
+			}
+			m_size -= count;
+		}
+
+		T* object(size_t const id) noexcept {
+			if (id < slotCount() && chunk(id).used[id & chunk_mask]) {
+				return &chunk(id).data[id & chunk_mask];
+			}
+			return nullptr;
+		}
+
+		[[nodiscard]] size_t size() const noexcept { return m_size; }
+
+		// 最大容量
+		[[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+		// 已分配内存的槽位数量，索引范围为 [0, slotCount())
+		[[nodiscard]] size_t slotCount() const noexcept { return m_chunks.size() * ChunkSize; }
+
+		[[nodiscard]] size_t chunkCount() const noexcept { return m_chunks.size(); }
+
+		[[nodiscard]] size_t memoryUsage() const noexcept {
+			return m_chunks.size() * sizeof(Chunk) + m_free_indices.capacity() * sizeof(size_t);
+		}
+
+		// 直接获取槽位，不检查槽位是否已被分配，id 需要小于 slotCount()
+		T* slot(size_t const id) noexcept { return &chunk(id).data[id & chunk_mask]; }
+
+		// 槽位是否已被分配
+		[[nodiscard]] bool used(size_t const id) const noexcept {
+			return id < slotCount() && chunk(id).used[id & chunk_mask];
+		}
+
+		// 回收索引列表，末尾的索引最先被分配
+		[[nodiscard]] std::span<size_t const> freeIndices() const noexcept { return m_free_indices; }
+
+		// 恢复到之前记录的状态：释放多出的块，然后按记录重建每个槽位的使用状态和回收索引列表
+		// 之后的分配顺序与记录时完全一致，调用者需要保证记录之后没有修改过最大容量
+		void restore(size_t const chunk_count, std::span<uint8_t const> const used_slots, std::span<size_t const> const free_indices) noexcept {
+			assert(chunk_count <= m_chunks.size());
+			assert(used_slots.size() == chunk_count * ChunkSize);
+			m_chunks.resize(chunk_count);
+			size_t count{};
+			for (size_t id = 0; id < used_slots.size(); id++) {
+				chunk(id).used[id & chunk_mask] = used_slots[id] != 0;
+				count += used_slots[id] != 0 ? 1 : 0;
+			}
+			// 容量已在分配块时预留，不会分配内存
+			m_free_indices.assign(free_indices.begin(), free_indices.end());
+			m_size = count;
+		}
+
+		// 修改最大容量，只能在没有已分配对象时调用，会释放所有块
+		bool setCapacity(size_t const capacity) noexcept {
+			if (m_size > 0) {
+				return false;
+			}
+			m_chunks.clear();
+			m_free_indices.clear();
+			m_free_indices.shrink_to_fit();
+			m_capacity = capacity;
+			return true;
+		}
+
+		// 回收所有对象，恢复为线性状态，保留已分配的块
+		void clear() noexcept {
+			m_free_indices.clear();
+			for (size_t i = std::min(slotCount(), m_capacity); i > 0; i--) {
+				m_free_indices.push_back(i - 1);
+			}
+			for (auto& c : m_chunks) {
+				for (auto& v : c->used) {
+					v = false;
+				}
+			}
+			m_size = 0;
+		}
+
+	private:
+		static constexpr size_t chunk_mask{ ChunkSize - 1 };
+
+		struct Chunk {
+			T data[ChunkSize]{};
+			bool used[ChunkSize]{};
+		};
+
+		Chunk& chunk(size_t const id) noexcept { return *m_chunks[id / ChunkSize]; }
+		Chunk const& chunk(size_t const id) const noexcept { return *m_chunks[id / ChunkSize]; }
+
+		bool grow() noexcept {
+			auto const first = slotCount();
+			if (first >= m_capacity) {
+				return false;
+			}
+			auto const count = std::min(ChunkSize, m_capacity - first);
+			try {
+				// 预留回收索引所需的空间，保证 free 不会分配内存
+				m_free_indices.reserve(first + ChunkSize);
+				m_chunks.reserve(m_chunks.size() + 1);
+				m_chunks.emplace_back(std::make_unique<Chunk>());
+			}
+			catch (std::bad_alloc const&) {
+				return false;
+			}
+			// 最后一个块可能只有部分槽位可用
+			for (size_t i = count; i > 0; i--) {
+				m_free_indices.push_back(first + i - 1);
+			}
+			return true;
+		}
+
+		std::vector<std::unique_ptr<Chunk>> m_chunks;
+		std::vector<size_t> m_free_indices;
+		size_t m_size{};
+		size_t m_capacity{};
+	};
+}
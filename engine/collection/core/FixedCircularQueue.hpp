@@ -86,6 +86,18 @@ namespace core {
 
 		[[nodiscard]] T const& head() const noexcept { assert(!empty()); return m_data[m_front]; }
 
+		// 元素在底层存储中的位置（槽位），在元素出队前保持不变
+
+		[[nodiscard]] size_t slotOf(size_t const idx) const noexcept { return (idx + m_front) % MaxSize; }
+
+		// 槽位当前存放的元素的索引，槽位未被使用时返回值 >= size()
+
+		[[nodiscard]] size_t indexOfSlot(size_t const slot_) const noexcept { return (slot_ + MaxSize - m_front) % MaxSize; }
+
+		[[nodiscard]] T& slot(size_t const slot_) noexcept { return m_data[slot_]; }
+
+		[[nodiscard]] T const& slot(size_t const slot_) const noexcept { return m_data[slot_]; }
+
 	private:
 		std::array<T, MaxSize> m_data;
 		size_t m_front{};
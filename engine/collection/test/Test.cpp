@@ -0,0 +1,136 @@
+#include <cstdint>
+#include <vector>
+#include "core/ChunkedObjectPool.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+	using Pool = core::ChunkedObjectPool<int, 4>;
+
+	std::vector<size_t> allocN(Pool& pool, size_t const n) {
+		std::vector<size_t> ids;
+		for (size_t i = 0; i < n; i++) {
+			size_t id{};
+			if (!pool.alloc(id)) {
+				break;
+			}
+			ids.push_back(id);
+		}
+		return ids;
+	}
+
+	std::vector<uint8_t> usedSlots(Pool const& pool) {
+		std::vector<uint8_t> used(pool.slotCount());
+		for (size_t id = 0; id < used.size(); id++) {
+			used[id] = pool.used(id) ? 1 : 0;
+		}
+		return used;
+	}
+}
+
+TEST(ChunkedObjectPool, alloc) {
+	Pool pool(10);
+	auto const ids = allocN(pool, 11);
+	ASSERT_EQ(ids.size(), 10u);
+	for (size_t i = 0; i < ids.size(); i++) {
+		ASSERT_EQ(ids[i], i);
+	}
+	ASSERT_EQ(pool.size(), 10u);
+	ASSERT_EQ(pool.chunkCount(), 3u);
+	ASSERT_EQ(pool.slotCount(), 12u);
+	ASSERT_FALSE(pool.used(10));
+	ASSERT_EQ(pool.object(10), nullptr);
+
+	// 优先复用最近回收的索引
+	pool.free(3);
+	pool.free(7);
+	size_t id{};
+	ASSERT_TRUE(pool.alloc(id));
+	ASSERT_EQ(id, 7u);
+	ASSERT_TRUE(pool.alloc(id));
+	ASSERT_EQ(id, 3u);
+	ASSERT_FALSE(pool.alloc(id));
+}
+
+TEST(ChunkedObjectPool, freeSpan) {
+	Pool a(16);
+	Pool b(16);
+	allocN(a, 12);
+	allocN(b, 12);
+
+	// 包含重复、未分配和越界的索引
+	std::vector<size_t> const ids{ 5, 1, 5, 13, 9, 100, 0 };
+	a.free(ids);
+	for (auto const id : ids) {
+		b.free(id);
+	}
+	ASSERT_EQ(a.size(), 8u);
+	ASSERT_EQ(a.size(), b.size());
+	ASSERT_EQ(usedSlots(a), usedSlots(b));
+	auto const fa = a.freeIndices();
+	auto const fb = b.freeIndices();
+	ASSERT_EQ(std::vector<size_t>(fa.begin(), fa.end()), std::vector<size_t>(fb.begin(), fb.end()));
+	ASSERT_EQ(allocN(a, 8), allocN(b, 8));
+}
+
+TEST(ChunkedObjectPool, restore) {
+	Pool pool(32);
+	allocN(pool, 6);
+	std::vector<size_t> const freed{ 4, 1 };
+	pool.free(freed);
+
+	// 记录
+	auto const chunk_count = pool.chunkCount();
+	auto const used = usedSlots(pool);
+	auto const free_indices = std::vector<size_t>(pool.freeIndices().begin(), pool.freeIndices().end());
+	auto const size = pool.size();
+	ASSERT_EQ(chunk_count, 2u);
+
+	// 记录之后的分配顺序
+	auto const expected = allocN(pool, 32);
+	ASSERT_EQ(pool.chunkCount(), 8u);
+
+	// 恢复后释放多出的块，分配顺序与记录时一致
+	pool.restore(chunk_count, used, free_indices);
+	ASSERT_EQ(pool.chunkCount(), chunk_count);
+	ASSERT_EQ(pool.size(), size);
+	ASSERT_EQ(usedSlots(pool), used);
+	ASSERT_EQ(pool.object(1), nullptr);
+	ASSERT_NE(pool.object(2), nullptr);
+	ASSERT_EQ(allocN(pool, 32), expected);
+	ASSERT_EQ(pool.size(), 32u);
+}
+
+TEST(ChunkedObjectPool, restoreKeepsChunks) {
+	Pool pool(16);
+	allocN(pool, 8);
+	auto const used = usedSlots(pool);
+	auto const free_indices = std::vector<size_t>(pool.freeIndices().begin(), pool.freeIndices().end());
+
+	// 记录之后回收了所有对象，恢复时块的数量不变
+	std::vector<size_t> const all{ 0, 1, 2, 3, 4, 5, 6, 7 };
+	pool.free(all);
+	ASSERT_EQ(pool.size(), 0u);
+	pool.restore(2, used, free_indices);
+	ASSERT_EQ(pool.size(), 8u);
+	for (size_t id = 0; id < 8; id++) {
+		ASSERT_TRUE(pool.used(id));
+	}
+	size_t id{};
+	ASSERT_TRUE(pool.alloc(id));
+	ASSERT_EQ(id, 8u);
+}
+
+TEST(ChunkedObjectPool, clear) {
+	Pool pool(10);
+	allocN(pool, 10);
+	std::vector<size_t> const ids{ 2, 6 };
+	pool.free(ids);
+	pool.clear();
+	ASSERT_EQ(pool.size(), 0u);
+	ASSERT_EQ(pool.chunkCount(), 3u);
+	auto const ids2 = allocN(pool, 11);
+	ASSERT_EQ(ids2.size(), 10u);
+	for (size_t i = 0; i < ids2.size(); i++) {
+		ASSERT_EQ(ids2[i], i);
+	}
+}
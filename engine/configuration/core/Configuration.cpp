@@ -384,6 +384,16 @@ namespace core {
 				}
 			}
 
+			if (root.contains("game_object"sv)) {
+				auto const& game_object = root.at("game_object"sv);
+				assert_type_is_object(game_object, "/game_object"sv);
+				if (game_object.contains("capacity"sv)) {
+					auto const& capacity = game_object.at("capacity"sv);
+					assert_type_is_unsigned_integer(capacity, "/game_object/capacity"sv);
+					loader.game_object.setCapacity(capacity.get<uint32_t>());
+				}
+			}
+
 			if (root.contains("window"sv)) {
 				auto const& window = root.at("window"sv);
 				assert_type_is_object(window, "/window"sv);
@@ -728,6 +738,8 @@ namespace {
 		{ .type = OptionType::number , .prefix = "--logging.rolling_file.max_history="sv , .path = "/logging/rolling_file/max_history"_json_pointer },
 		// timing
 		{ .type = OptionType::number , .prefix = "--timing.frame_rate="sv, .path = ""_json_pointer },
+		// game_object
+		{ .type = OptionType::number , .prefix = "--game_object.capacity="sv, .path = "/game_object/capacity"_json_pointer },
 		// window
 		{ .type = OptionType::string , .prefix = "--window.title="sv                    , .path = "/window/title"_json_pointer },
 		{ .type = OptionType::boolean, .prefix = "--window.cursor_visible="sv           , .path = "/window/cursor_visible"_json_pointer },
@@ -123,6 +123,12 @@ namespace core {
 		private:
 			uint32_t frame_rate{ 60 };
 		};
+		class GameObject {
+		public:
+			GetterSetterPrimitive(GameObject, uint32_t, capacity, Capacity);
+		private:
+			uint32_t capacity{ 32768 };
+		};
 		/* TODO*/ struct Display {
 			std::string device_name;
 			int32_t left{};
@@ -187,6 +193,7 @@ namespace core {
 		inline Logging const& getLogging() const noexcept { return logging; }
 		inline FileSystem const& getFileSystem() const noexcept { return file_system; }
 		inline Timing const& getTiming() const noexcept { return timing; }
+		inline GameObject const& getGameObject() const noexcept { return game_object; }
 		inline Window const& getWindow() const noexcept { return window; }
 		inline GraphicsSystem const& getGraphicsSystem() const noexcept { return graphics_system; }
 		inline AudioSystem const& getAudioSystem() const noexcept { return audio_system; }
@@ -207,6 +214,7 @@ namespace core {
 		Logging logging;
 		FileSystem file_system;
 		Timing timing;
+		GameObject game_object;
 		Window window;
 		GraphicsSystem graphics_system;
 		AudioSystem audio_system;
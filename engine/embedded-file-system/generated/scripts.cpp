@@ -6,18 +6,20 @@ using Node = luastg::InternalLuaScriptsFileSystemNode;
 
 namespace {
     constexpr uint8_t luastg_cjson_lua[72]{5,21,84,4,6,0,27,9,76,7,28,2,2,121,84,71,76,83,4,6,15,24,21,0,9,93,24,8,13,23,17,3,55,81,23,13,31,28,26,69,49,83,73,71,15,25,7,8,2,83,89,74,76,21,1,4,7,83,13,8,25,83,23,13,31,28,26,109,9,29,16,109};
+    constexpr uint8_t luastg_ffi_GameObject_lua[345]{0,28,23,6,0,83,18,1,5,83,73,71,30,22,5,18,5,1,17,79,78,21,18,14,78,90,126,11,3,16,21,11,76,31,7,19,11,83,73,71,30,22,5,18,5,1,17,79,78,31,7,19,11,81,93,109,0,28,23,6,0,83,16,2,15,31,21,21,13,7,29,8,2,95,84,17,9,1,7,14,3,29,84,90,76,31,7,19,11,93,51,2,24,60,22,13,9,16,0,33,42,58,48,2,15,31,21,21,13,7,29,8,2,91,93,109,10,21,29,73,15,23,17,1,68,23,17,4,0,18,6,6,24,26,27,9,69,121,24,8,15,18,24,71,28,28,29,9,24,22,6,56,24,10,4,2,76,78,84,1,10,26,90,19,21,3,17,8,10,91,92,69,0,0,0,0,51,52,21,10,9,60,22,13,9,16,0,56,26,86,16,77,78,90,78,1,3,1,25,6,24,91,2,2,30,0,29,8,2,90,93,109,0,28,23,6,0,83,23,6,31,7,84,90,76,21,18,14,66,16,21,20,24,121,24,8,15,18,24,71,33,83,73,71,23,14,126,42,66,5,17,21,31,26,27,9,76,78,84,17,9,1,7,14,3,29,126,1,25,29,23,19,5,28,26,71,33,93,2,14,9,4,92,8,14,25,17,4,24,90,126,71,76,83,84,21,9,7,1,21,2,83,23,6,31,7,92,23,3,26,26,19,9,1,43,19,21,3,17,75,76,28,22,13,9,16,0,60,95,46,93,109,9,29,16,109,30,22,0,18,30,29,84,42,102};
     constexpr uint8_t luastg_ffi_sample_lua[1]{};
-    constexpr uint8_t luastg_GameObject_lua[2117]{0,28,23,6,0,83,0,30,28,22,84,90,76,7,13,23,9,121,24,8,15,18,24,71,1,18,0,15,76,78,84,21,9,2,1,14,30,22,92,69,1,18,0,15,78,90,126,11,3,16,21,11,76,31,7,19,11,83,73,71,30,22,5,18,5,1,17,79,78,31,7,19,11,81,93,109,0,28,23,6,0,83,43,41,9,4,84,90,76,31,7,19,11,93,43,41,9,4,126,1,25,29,23,19,5,28,26,71,0,0,0,0,66,61,17,16,68,16,24,6,31,0,88,71,66,93,90,78,102,83,84,71,76,31,27,4,13,31,84,8,64,83,29,9,5,7,84,90,76,44,58,2,27,91,23,11,13,0,7,78,102,83,84,71,76,26,18,71,5,29,29,19,76,7,28,2,2,121,84,71,76,83,84,71,76,83,27,60,93,46,47,86,49,91,27,75,76,93,90,73,69,121,84,71,76,83,17,9,8,121,84,71,76,83,6,2,24,6,6,9,76,28,126,2,2,23,126,11,3,16,21,11,76,44,48,2,0,83,73,71,0,0,0,0,66,44,48,2,0,121,18,18,2,16,0,14,3,29,84,11,31,7,19,73,40,22,24,79,3,95,84,73,66,93,93,109,76,83,84,71,5,21,84,56,40,22,24,79,3,90,84,19,4,22,26,109,76,83,84,71,76,83,84,71,3,40,69,58,55,65,41,79,3,95,84,73,66,93,93,109,76,83,84,71,9,29,16,109,9,29,16,109,0,28,23,6,0,83,43,44,5,31,24,71,81,83,24,20,24,20,90,56,39,26,24,11,102,21,1,9,15,7,29,8,2,83,24,20,24,20,90,44,5,31,24,79,3,95,84,73,66,93,93,109,76,83,84,71,5,21,84,56,39,26,24,11,68,28,93,71,24,27,17,9,102,83,84,71,76,83,84,71,76,28,47,86,49,40,66,58,68,28,88,71,66,93,90,78,102,83,84,71,76,22,26,3,102,22,26,3,102,31,27,4,13,31,84,56,57,3,16,6,24,22,56,14,31,7,50,14,30,0,0,71,81,83,24,20,24,20,90,56,57,3,16,6,24,22,56,14,31,7,50,14,30,0,0,109,0,28,23,6,0,83,43,50,28,23,21,19,9,63,29,20,24,61,17,31,24,83,73,71,0,0,0,0,66,44,33,23,8,18,0,2,32,26,7,19,34,22,12,19,102,31,27,4,13,31,84,56,40,22,0,2,15,7,56,14,31,7,50,14,30,0,0,71,81,83,24,20,24,20,90,56,40,22,0,2,15,7,56,14,31,7,50,14,30,0,0,109,0,28,23,6,0,83,43,35,9,7,17,4,24,63,29,20,24,61,17,31,24,83,73,71,0,0,0,0,66,44,48,2,24,22,23,19,32,26,7,19,34,22,12,19,102,31,27,4,13,31,84,8,14,25,17,4,24,0,84,90,76,31,7,19,11,93,59,5,6,39,21,5,0,22,92,78,102,21,1,9,15,7,29,8,2,83,24,20,24,20,90,40,14,25,56,14,31,7,92,0,30,28,1,23,69,121,84,71,76,83,29,1,76,20,6,8,25,3,84,91,76,67,84,8,30,83,19,21,3,6,4,71,82,78,84,86,90,83,0,15,9,29,126,71,76,83,84,71,76,83,84,11,3,16,21,11,76,26,16,71,81,83,43,50,28,23,21,19,9,63,29,20,24,53,29,21,31,7,92,78,102,83,84,71,76,83,84,71,76,1,17,19,25,1,26,71,10,6,26,4,24,26,27,9,68,90,126,71,76,83,84,71,76,83,84,71,76,83,84,14,10,83,29,3,76,78,73,71,92,83,0,15,9,29,126,71,76,83,84,71,76,83,84,71,76,83,84,71,76,83,84,21,9,7,1,21,2,83,26,14,0,95,84,9,5,31,126,71,76,83,84,71,76,83,84,71,76,83,84,2,0,0,17,109,76,83,84,71,76,83,84,71,76,83,84,71,76,83,84,71,0,28,23,6,0,83,29,75,76,28,84,90,76,26,16,75,76,28,22,13,9,16,0,20,55,26,16,58,102,83,84,71,76,83,84,71,76,83,84,71,76,83,84,71,76,26,16,71,81,83,43,50,28,23,21,19,9,63,29,20,24,61,17,31,24,91,29,3,69,121,84,71,76,83,84,71,76,83,84,71,76,83,84,71,76,83,6,2,24,6,6,9,76,26,88,71,3,121,84,71,76,83,84,71,76,83,84,71,76,83,17,9,8,121,84,71,76,83,84,71,76,83,17,9,8,121,84,71,76,83,17,11,31,22,126,71,76,83,84,71,76,83,84,11,3,16,21,11,76,26,16,71,81,83,43,35,9,7,17,4,24,63,29,20,24,53,29,21,31,7,92,0,30,28,1,23,69,121,84,71,76,83,84,71,76,83,6,2,24,6,6,9,76,21,1,9,15,7,29,8,2,91,93,109,76,83,84,71,76,83,84,71,76,83,84,71,5,21,84,14,8,83,73,90,76,67,84,19,4,22,26,109,76,83,84,71,76,83,84,71,76,83,84,71,76,83,84,71,30,22,0,18,30,29,84,9,5,31,88,71,2,26,24,109,76,83,84,71,76,83,84,71,76,83,84,71,9,31,7,2,102,83,84,71,76,83,84,71,76,83,84,71,76,83,84,71,76,31,27,4,13,31,84,14,64,83,27,71,81,83,29,3,64,83,27,5,6,22,23,19,31,40,29,3,49,121,84,71,76,83,84,71,76,83,84,71,76,83,84,71,76,83,29,3,76,78,84,56,40,22,0,2,15,7,56,14,31,7,58,2,20,7,92,0,30,28,1,23,64,83,29,3,69,121,84,71,76,83,84,71,76,83,84,71,76,83,84,71,76,83,6,2,24,6,6,9,76,26,88,71,3,121,84,71,76,83,84,71,76,83,84,71,76,83,17,9,8,121,84,71,76,83,84,71,76,83,17,9,8,121,84,71,76,83,17,9,8,121,17,9,8,121,24,8,15,18,24,71,51,0,29,9,76,78,84,11,31,7,19,73,31,26,26,109,0,28,23,6,0,83,43,4,3,0,84,90,76,31,7,19,11,93,23,8,31,121,18,18,2,16,0,14,3,29,84,11,31,7,19,73,63,22,0,49,68,28,88,71,26,95,84,6,64,83,1,23,8,18,0,2,51,1,27,19,69,121,84,71,76,83,27,73,26,11,84,90,76,5,84,77,76,44,23,8,31,91,21,78,102,83,84,71,76,28,90,17,21,83,73,71,26,83,94,71,51,0,29,9,68,18,93,109,76,83,84,71,5,21,84,18,28,23,21,19,9,44,6,8,24,83,0,15,9,29,126,71,76,83,84,71,76,83,84,8,66,1,27,19,76,78,84,6,102,83,84,71,76,22,26,3,102,22,26,3,102,31,27,4,13,31,84,20,29,1,0,71,81,83,25,6,24,27,90,20,29,1,0,109,0,28,23,6,0,83,43,6,24,18,26,85,76,78,84,11,31,7,19,73,13,7,21,9,94,121,18,18,2,16,0,14,3,29,84,11,31,7,19,73,43,22,0,49,68,28,93,109,76,83,84,71,0,28,23,6,0,83,2,31,64,83,2,30,76,78,84,8,66,5,12,75,76,28,90,17,21,121,84,71,76,83,6,2,24,6,6,9,76,0,5,21,24,91,2,31,76,89,84,17,20,83,95,71,26,10,84,77,76,5,13,78,64,83,43,6,24,18,26,85,68,5,13,75,76,5,12,78,102,22,26,3,102,31,27,4,13,31,84,1,25,29,23,19,5,28,26,71,51,23,12,3,21,91,21,75,76,17,88,71,15,95,84,3,69,121,84,71,76,83,29,1,76,23,84,19,4,22,26,109,76,83,84,71,76,83,84,71,30,22,0,18,30,29,84,4,76,94,84,6,64,83,16,71,65,83,22,109,76,83,84,71,9,31,7,2,5,21,84,19,21,3,17,79,15,90,84,90,81,83,86,9,25,30,22,2,30,81,84,19,4,22,26,109,76,83,84,71,76,83,84,71,30,22,0,18,30,29,84,5,76,94,84,6,66,11,88,71,15,83,89,71,13,93,13,109,76,83,84,71,9,31,7,2,5,21,84,4,76,7,28,2,2,121,84,71,76,83,84,71,76,83,6,2,24,6,6,9,76,16,90,31,76,94,84,6,64,83,23,73,21,83,89,71,14,121,84,71,76,83,17,11,31,22,126,71,76,83,84,71,76,83,84,21,9,7,1,21,2,83,22,73,20,83,89,71,13,93,12,75,76,17,90,30,76,94,84,6,66,10,126,71,76,83,84,2,2,23,126,2,2,23,126,1,25,29,23,19,5,28,26,71,0,0,0,0,66,55,29,20,24,91,21,75,76,17,88,71,15,95,84,3,69,121,84,71,76,83,24,8,15,18,24,71,8,11,88,71,8,10,84,90,76,44,16,31,8,10,92,6,64,83,22,75,76,16,88,71,8,90,126,71,76,83,84,21,9,7,1,21,2,83,7,22,30,7,92,3,20,83,94,71,8,11,84,76,76,23,13,71,70,83,16,30,69,121,17,9,8,121,18,18,2,16,0,14,3,29,84,11,31,7,19,73,45,29,19,11,9,91,21,75,76,17,88,71,15,95,84,3,69,121,84,71,76,83,24,8,15,18,24,71,8,11,88,71,8,10,84,90,76,44,16,31,8,10,92,6,64,83,22,75,76,16,88,71,8,90,126,71,76,83,84,21,9,7,1,21,2,83,43,6,24,18,26,85,68,23,13,75,76,23,12,78,102,22,26,3,102};
+    constexpr uint8_t luastg_GameObject_lua[2200]{0,28,23,6,0,83,0,30,28,22,84,90,76,7,13,23,9,121,24,8,15,18,24,71,1,18,0,15,76,78,84,21,9,2,1,14,30,22,92,69,1,18,0,15,78,90,126,11,3,16,21,11,76,31,7,19,11,83,73,71,30,22,5,18,5,1,17,79,78,31,7,19,11,81,93,109,0,28,23,6,0,83,43,41,9,4,84,90,76,31,7,19,11,93,43,41,9,4,126,1,25,29,23,19,5,28,26,71,0,0,0,0,66,61,17,16,68,16,24,6,31,0,88,71,66,93,90,78,102,83,84,71,76,31,27,4,13,31,84,8,64,83,29,9,5,7,84,90,76,44,58,2,27,91,23,11,13,0,7,78,102,83,84,71,76,26,18,71,5,29,29,19,76,7,28,2,2,121,84,71,76,83,84,71,76,83,27,60,93,46,47,86,49,91,27,75,76,93,90,73,69,121,84,71,76,83,17,9,8,121,84,71,76,83,6,2,24,6,6,9,76,28,126,2,2,23,126,11,3,16,21,11,76,44,48,2,0,83,73,71,0,0,0,0,66,44,48,2,0,121,18,18,2,16,0,14,3,29,84,11,31,7,19,73,40,22,24,79,3,95,84,73,66,93,93,109,76,83,84,71,5,21,84,56,40,22,24,79,3,90,84,19,4,22,26,109,76,83,84,71,76,83,84,71,3,40,69,58,55,65,41,79,3,95,84,73,66,93,93,109,76,83,84,71,9,29,16,109,9,29,16,109,0,28,23,6,0,83,43,44,5,31,24,71,81,83,24,20,24,20,90,56,39,26,24,11,102,21,1,9,15,7,29,8,2,83,24,20,24,20,90,44,5,31,24,79,3,95,84,73,66,93,93,109,76,83,84,71,5,21,84,56,39,26,24,11,68,28,93,71,24,27,17,9,102,83,84,71,76,83,84,71,76,28,47,86,49,40,66,58,68,28,88,71,66,93,90,78,102,83,84,71,76,22,26,3,102,22,26,3,102,31,27,4,13,31,84,56,57,3,16,6,24,22,56,14,31,7,50,14,30,0,0,71,81,83,24,20,24,20,90,56,57,3,16,6,24,22,56,14,31,7,50,14,30,0,0,109,0,28,23,6,0,83,43,50,28,23,21,19,9,63,29,20,24,61,17,31,24,83,73,71,0,0,0,0,66,44,33,23,8,18,0,2,32,26,7,19,34,22,12,19,102,31,27,4,13,31,84,56,40,22,0,2,15,7,56,14,31,7,50,14,30,0,0,71,81,83,24,20,24,20,90,56,40,22,0,2,15,7,56,14,31,7,50,14,30,0,0,109,0,28,23,6,0,83,43,35,9,7,17,4,24,63,29,20,24,61,17,31,24,83,73,71,0,0,0,0,66,44,48,2,24,22,23,19,32,26,7,19,34,22,12,19,102,31,27,4,13,31,84,56,43,22,0,36,3,31,24,14,31,26,27,9,43,1,27,18,28,48,27,18,2,7,84,90,76,31,7,19,11,93,51,2,24,48,27,11,0,26,7,14,3,29,51,21,3,6,4,36,3,6,26,19,102,31,27,4,13,31,84,8,14,25,17,4,24,0,84,90,76,31,7,19,11,93,59,5,6,39,21,5,0,22,92,78,102,21,1,9,15,7,29,8,2,83,24,20,24,20,90,40,14,25,56,14,31,7,92,0,30,28,1,23,69,121,84,71,76,83,29,1,76,20,6,8,25,3,84,91,76,67,84,8,30,83,19,21,3,6,4,71,82,78,84,56,43,22,0,36,3,31,24,14,31,26,27,9,43,1,27,18,28,48,27,18,2,7,92,78,76,7,28,2,2,121,84,71,76,83,84,71,76,83,24,8,15,18,24,71,5,23,84,90,76,44,33,23,8,18,0,2,32,26,7,19,42,26,6,20,24,91,93,109,76,83,84,71,76,83,84,71,30,22,0,18,30,29,84,1,25,29,23,19,5,28,26,79,69,121,84,71,76,83,84,71,76,83,84,71,76,83,29,1,76,26,16,71,81,78,84,87,76,7,28,2,2,121,84,71,76,83,84,71,76,83,84,71,76,83,84,71,76,83,6,2,24,6,6,9,76,29,29,11,64,83,26,14,0,121,84,71,76,83,84,71,76,83,84,71,76,83,17,11,31,22,126,71,76,83,84,71,76,83,84,71,76,83,84,71,76,83,84,11,3,16,21,11,76,26,88,71,3,83,73,71,5,23,88,71,3,17,30,2,15,7,7,60,5,23,41,109,76,83,84,71,76,83,84,71,76,83,84,71,76,83,84,71,5,23,84,90,76,44,33,23,8,18,0,2,32,26,7,19,34,22,12,19,68,26,16,78,102,83,84,71,76,83,84,71,76,83,84,71,76,83,84,71,76,1,17,19,25,1,26,71,5,95,84,8,102,83,84,71,76,83,84,71,76,83,84,71,76,22,26,3,102,83,84,71,76,83,84,71,76,22,26,3,102,83,84,71,76,22,24,20,9,121,84,71,76,83,84,71,76,83,24,8,15,18,24,71,5,23,84,90,76,44,48,2,24,22,23,19,32,26,7,19,42,26,6,20,24,91,19,21,3,6,4,78,102,83,84,71,76,83,84,71,76,1,17,19,25,1,26,71,10,6,26,4,24,26,27,9,68,90,126,71,76,83,84,71,76,83,84,71,76,83,84,14,10,83,29,3,76,78,73,71,92,83,0,15,9,29,126,71,76,83,84,71,76,83,84,71,76,83,84,71,76,83,84,21,9,7,1,21,2,83,26,14,0,95,84,9,5,31,126,71,76,83,84,71,76,83,84,71,76,83,84,2,0,0,17,109,76,83,84,71,76,83,84,71,76,83,84,71,76,83,84,71,0,28,23,6,0,83,29,75,76,28,84,90,76,26,16,75,76,28,22,13,9,16,0,20,55,26,16,58,102,83,84,71,76,83,84,71,76,83,84,71,76,83,84,71,76,26,16,71,81,83,43,35,9,7,17,4,24,63,29,20,24,61,17,31,24,91,19,21,3,6,4,75,76,26,16,78,102,83,84,71,76,83,84,71,76,83,84,71,76,83,84,71,76,1,17,19,25,1,26,71,5,95,84,8,102,83,84,71,76,83,84,71,76,83,84,71,76,22,26,3,102,83,84,71,76,83,84,71,76,22,26,3,102,83,84,71,76,22,26,3,102,22,26,3,102,31,27,4,13,31,84,56,31,26,26,71,81,83,24,20,24,20,90,20,5,29,126,11,3,16,21,11,76,44,23,8,31,83,73,71,0,0,0,0,66,16,27,20,102,21,1,9,15,7,29,8,2,83,24,20,24,20,90,52,9,7,34,79,3,95,84,17,64,83,21,75,76,6,4,3,13,7,17,56,30,28,0,78,102,83,84,71,76,28,90,17,20,83,73,71,26,83,94,71,51,16,27,20,68,18,93,109,76,83,84,71,3,93,2,30,76,78,84,17,76,89,84,56,31,26,26,79,13,90,126,71,76,83,84,14,10,83,1,23,8,18,0,2,51,1,27,19,76,7,28,2,2,121,84,71,76,83,84,71,76,83,27,73,30,28,0,71,81,83,21,109,76,83,84,71,9,29,16,109,9,29,16,109,0,28,23,6,0,83,7,22,30,7,84,90,76,30,21,19,4,93,7,22,30,7,126,11,3,16,21,11,76,44,21,19,13,29,70,71,81,83,24,20,24,20,90,6,24,18,26,85,102,21,1,9,15,7,29,8,2,83,24,20,24,20,90,32,9,7,34,79,3,90,126,71,76,83,84,11,3,16,21,11,76,5,12,75,76,5,13,71,81,83,27,73,26,11,88,71,3,93,2,30,102,83,84,71,76,1,17,19,25,1,26,71,31,2,6,19,68,5,12,71,70,83,2,31,76,88,84,17,21,83,94,71,26,10,93,75,76,44,21,19,13,29,70,79,26,10,88,71,26,11,93,109,9,29,16,109,0,28,23,6,0,83,18,18,2,16,0,14,3,29,84,56,8,11,16,30,68,18,88,71,14,95,84,4,64,83,16,78,102,83,84,71,76,26,18,71,8,83,0,15,9,29,126,71,76,83,84,71,76,83,84,21,9,7,1,21,2,83,23,71,65,83,21,75,76,23,84,74,76,17,126,71,76,83,84,2,0,0,17,14,10,83,0,30,28,22,92,4,69,83,73,90,76,81,26,18,1,17,17,21,78,83,0,15,9,29,126,71,76,83,84,71,76,83,84,21,9,7,1,21,2,83,22,71,65,83,21,73,20,95,84,4,76,94,84,6,66,10,126,71,76,83,84,2,0,0,17,14,10,83,23,71,24,27,17,9,102,83,84,71,76,83,84,71,76,1,17,19,25,1,26,71,15,93,12,71,65,83,21,75,76,16,90,30,76,94,84,5,102,83,84,71,76,22,24,20,9,121,84,71,76,83,84,71,76,83,6,2,24,6,6,9,76,17,90,31,76,94,84,6,66,11,88,71,14,93,13,71,65,83,21,73,21,121,84,71,76,83,17,9,8,121,17,9,8,121,18,18,2,16,0,14,3,29,84,11,31,7,19,73,40,26,7,19,68,18,88,71,14,95,84,4,64,83,16,78,102,83,84,71,76,31,27,4,13,31,84,3,20,95,84,3,21,83,73,71,51,23,12,3,21,91,21,75,76,17,88,71,15,95,84,3,69,121,84,71,76,83,6,2,24,6,6,9,76,0,5,21,24,91,16,31,76,89,84,3,20,83,95,71,8,10,84,77,76,23,13,78,102,22,26,3,102,21,1,9,15,7,29,8,2,83,24,20,24,20,90,38,2,20,24,2,68,18,88,71,14,95,84,4,64,83,16,78,102,83,84,71,76,31,27,4,13,31,84,3,20,95,84,3,21,83,73,71,51,23,12,3,21,91,21,75,76,17,88,71,15,95,84,3,69,121,84,71,76,83,6,2,24,6,6,9,76,44,21,19,13,29,70,79,8,10,88,71,8,11,93,109,9,29,16,109};
     constexpr uint8_t luastg_io_lua[385]{0,28,23,6,0,83,0,6,14,31,17,71,81,83,6,2,29,6,29,21,9,91,86,19,13,17,24,2,78,90,126,11,3,16,21,11,76,31,7,19,11,83,73,71,30,22,5,18,5,1,17,79,78,31,7,19,11,81,93,109,102,31,27,4,13,31,84,43,35,52,43,43,41,37,49,43,51,58,58,33,35,83,73,71,94,121,126,1,25,29,23,19,5,28,26,71,0,0,0,0,66,32,13,20,24,22,25,43,3,20,92,19,9,11,0,78,102,83,84,71,76,31,7,19,11,93,56,8,11,91,56,40,43,44,56,34,58,54,56,56,37,61,50,40,64,83,0,2,20,7,93,109,9,29,16,109,102,21,1,9,15,7,29,8,2,83,24,20,24,20,90,55,30,26,26,19,68,93,90,73,69,121,84,71,76,83,24,8,15,18,24,71,13,1,19,20,76,78,84,28,66,93,90,26,102,83,84,71,76,31,27,4,13,31,84,6,30,20,23,71,81,83,7,2,0,22,23,19,68,84,87,64,64,83,90,73,66,90,126,71,76,83,84,1,3,1,84,14,76,78,84,86,64,83,21,21,11,16,84,3,3,121,84,71,76,83,84,71,76,83,21,21,11,0,47,14,49,83,73,71,24,28,7,19,30,26,26,0,68,18,6,0,31,40,29,58,69,121,84,71,76,83,17,9,8,121,84,71,76,83,24,20,24,20,90,43,3,20,92,43,35,52,43,43,41,37,49,43,51,58,58,33,35,95,84,19,13,17,24,2,66,16,27,9,15,18,0,79,13,1,19,20,64,83,83,59,24,84,93,78,102,22,26,3,102,121,4,21,5,29,0,71,81,83,24,20,24,20,90,55,30,26,26,19,102};
     constexpr uint8_t luastg_main_lua[329]{30,22,5,18,5,1,17,79,78,31,1,6,31,7,19,73,15,25,7,8,2,81,93,109,30,22,5,18,5,1,17,79,78,31,1,6,31,7,19,73,5,28,86,78,102,1,17,22,25,26,6,2,68,81,24,18,13,0,0,0,66,30,21,19,4,81,93,109,30,22,5,18,5,1,17,79,78,31,1,6,31,7,19,73,30,22,25,8,26,22,16,69,69,121,6,2,29,6,29,21,9,91,86,11,25,18,7,19,11,93,51,6,1,22,59,5,6,22,23,19,78,90,126,109,10,6,26,4,24,26,27,9,76,52,21,10,9,58,26,14,24,91,93,71,9,29,16,109,10,6,26,4,24,26,27,9,76,53,6,6,1,22,50,18,2,16,92,78,76,1,17,19,25,1,26,71,10,18,24,20,9,83,17,9,8,121,18,18,2,16,0,14,3,29,84,53,9,29,16,2,30,53,1,9,15,91,93,71,9,29,16,109,10,6,26,4,24,26,27,9,76,52,21,10,9,54,12,14,24,91,93,71,9,29,16,109,10,6,26,4,24,26,27,9,76,53,27,4,25,0,56,8,31,22,50,18,2,16,92,78,76,22,26,3,102,21,1,9,15,7,29,8,2,83,50,8,15,6,7,32,13,26,26,33,25,29,23,79,69,83,17,9,8,121,18,18,2,16,0,14,3,29,84,34,26,22,26,19,42,6,26,4,68,22,2,2,2,7,88,71,66,93,90,78,76,22,26,3,102};
     constexpr uint8_t luastg_math_lua[600]{0,28,23,6,0,83,25,6,24,27,84,90,76,1,17,22,25,26,6,2,68,81,25,6,24,27,86,78,102,31,27,4,13,31,84,11,31,7,19,71,81,83,6,2,29,6,29,21,9,91,86,11,31,7,19,69,69,121,126,11,3,16,21,11,76,1,21,3,76,78,84,10,13,7,28,73,30,18,16,109,0,28,23,6,0,83,16,2,11,83,73,71,1,18,0,15,66,23,17,0,102,31,27,4,13,31,84,20,5,29,84,90,76,30,21,19,4,93,7,14,2,121,24,8,15,18,24,71,15,28,7,71,81,83,25,6,24,27,90,4,3,0,126,11,3,16,21,11,76,7,21,9,76,78,84,10,13,7,28,73,24,18,26,109,0,28,23,6,0,83,21,20,5,29,84,90,76,30,21,19,4,93,21,20,5,29,126,11,3,16,21,11,76,18,23,8,31,83,73,71,1,18,0,15,66,18,23,8,31,121,24,8,15,18,24,71,13,7,21,9,76,78,84,10,13,7,28,73,13,7,21,9,102,31,27,4,13,31,84,6,24,18,26,85,76,78,84,10,13,7,28,73,13,7,21,9,94,83,27,21,76,30,21,19,4,93,21,19,13,29,126,109,10,6,26,4,24,26,27,9,76,31,7,19,11,93,7,14,2,91,12,78,76,1,17,19,25,1,26,71,31,26,26,79,30,18,16,79,20,90,93,71,9,29,16,109,10,6,26,4,24,26,27,9,76,31,7,19,11,93,23,8,31,91,12,78,76,1,17,19,25,1,26,71,15,28,7,79,30,18,16,79,20,90,93,71,9,29,16,109,10,6,26,4,24,26,27,9,76,31,7,19,11,93,0,6,2,91,12,78,76,1,17,19,25,1,26,71,24,18,26,79,30,18,16,79,20,90,93,71,9,29,16,109,10,6,26,4,24,26,27,9,76,31,7,19,11,93,21,20,5,29,92,31,69,83,6,2,24,6,6,9,76,23,17,0,68,18,7,14,2,91,12,78,69,83,17,9,8,121,18,18,2,16,0,14,3,29,84,11,31,7,19,73,13,16,27,20,68,11,93,71,30,22,0,18,30,29,84,3,9,20,92,6,15,28,7,79,20,90,93,71,9,29,16,109,10,6,26,4,24,26,27,9,76,31,7,19,11,93,21,19,13,29,92,73,66,93,93,71,30,22,0,18,30,29,84,3,9,20,92,6,24,18,26,79,66,93,90,78,69,83,17,9,8,121,18,18,2,16,0,14,3,29,84,11,31,7,19,73,13,7,21,9,94,91,13,75,76,11,93,71,30,22,0,18,30,29,84,3,9,20,92,6,24,18,26,85,68,10,88,71,20,90,93,71,9,29,16,109};
     constexpr uint8_t luastg_removed_lua[156]{65,94,89,39,15,31,21,20,31,83,24,20,24,20,126,11,3,16,21,11,76,31,7,19,11,83,73,71,30,22,5,18,5,1,17,79,78,31,7,19,11,81,93,109,102,21,1,9,15,7,29,8,2,83,24,20,24,20,90,52,4,28,3,52,28,31,21,20,4,36,29,9,8,28,3,79,69,83,17,9,8,121,18,18,2,16,0,14,3,29,84,11,31,7,19,73,60,28,7,19,41,21,18,2,15,7,55,6,28,7,1,21,9,91,93,71,9,29,16,109,10,6,26,4,24,26,27,9,76,31,7,19,11,93,36,8,31,7,49,1,10,22,23,19,45,3,4,11,21,91,93,71,9,29,16,109};
-    constexpr std::array<Node const, 9> s_files{
+    constexpr std::array<Node const, 10> s_files{
         Node{"luastg/"sv, std::span<uint8_t, 0>()},
         Node{"luastg/cjson.lua"sv, std::span(luastg_cjson_lua, 72)},
         Node{"luastg/ffi/"sv, std::span<uint8_t, 0>()},
+        Node{"luastg/ffi/GameObject.lua"sv, std::span(luastg_ffi_GameObject_lua, 345)},
         Node{"luastg/ffi/sample.lua"sv, std::span(luastg_ffi_sample_lua, 0)},
-        Node{"luastg/GameObject.lua"sv, std::span(luastg_GameObject_lua, 2117)},
+        Node{"luastg/GameObject.lua"sv, std::span(luastg_GameObject_lua, 2200)},
         Node{"luastg/io.lua"sv, std::span(luastg_io_lua, 385)},
         Node{"luastg/main.lua"sv, std::span(luastg_main_lua, 329)},
         Node{"luastg/math.lua"sv, std::span(luastg_math_lua, 600)},
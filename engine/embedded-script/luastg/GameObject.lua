@@ -25,9 +25,10 @@ local _UpdateListFirst = lstg._UpdateListFirst
 local _UpdateListNext = lstg._UpdateListNext
 local _DetectListFirst = lstg._DetectListFirst
 local _DetectListNext = lstg._DetectListNext
+local _GetCollisionGroupCount = lstg.GetCollisionGroupCount
 local objects = lstg.ObjTable()
 function lstg.ObjList(group)
-    if group < 0 or group >= 16 then
+    if group < 0 or group >= _GetCollisionGroupCount() then
         local id = _UpdateListFirst()
         return function()
             if id == 0 then
@@ -0,0 +1,12 @@
+local ffi = require("ffi")
+local lstg = require("lstg")
+local declaration, version = lstg.GetObjectFFIDeclaration()
+ffi.cdef(declaration)
+local pointer_type = ffi.typeof(("lstg_GameObject_v%d*"):format(version))
+local cast = ffi.cast
+local M = {}
+M.version = version
+function M.view(object)
+    return cast(pointer_type, object[3])
+end
+return M